@@ -0,0 +1,142 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * AABB TEST
+ *
+ * Checks the union of bounding boxes with empty boxes, and that the
+ * binned SAH build splits a scene whose centroids leave most bins
+ * empty - an empty box once stretched the union to infinity, so
+ * every split looked infinitely costly and the whole scene became
+ * one leaf. Run by ctest; exits with 1 if any check fails.
+ */
+
+// Header files
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// Common Library header files
+#include "common/common.h"
+#include "common/aabb.h"
+#include "common/bvh.h"
+#include "common/hittableList.h"
+#include "common/material.h"
+#include "common/sphere.h"
+
+// Namespace
+using namespace std;
+
+/*
+ * CHECK FUNCTION
+ *
+ * Function outputs the result of a check, and records a failure
+ */
+void check(bool passed, const string& description, bool& allPassed)
+{
+	// Output the result
+	cout << (passed ? "PASS " : "FAIL ") << description << endl;
+	allPassed = allPassed && passed;
+}
+
+/*
+ * SAME BOX FUNCTION
+ *
+ * Function determines if two boxes have exactly the same corners
+ */
+bool sameBox(const aabb& a, const aabb& b)
+{
+	// Compare each axis of both corners
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (a.getMin()[axis] != b.getMin()[axis] || a.getMax()[axis] != b.getMax()[axis])
+		{
+			// Corners differ
+			return false;
+		}
+	}
+
+	// Return true
+	return true;
+}
+
+ /*
+  * MAIN FUNCTION
+  *
+  * The first function that is invoked when the application is loaded.
+  *
+  * Runs each check, returning 1 if any fails.
+  */
+int main()
+{
+	// Whether every check has passed
+	bool allPassed = true;
+
+	// **** UNION WITH EMPTY BOXES **** //
+
+	// A box, and an empty box
+	const aabb box(point3(-1.0f, 2.0f, -3.0f), point3(4.0f, 5.0f, 6.0f));
+	const aabb empty;
+
+	// Growing a box by an empty box leaves it unchanged
+	aabb grown = box;
+	grown.grow(empty);
+	check(sameBox(grown, box), "growing a box by an empty box leaves it unchanged", allPassed);
+
+	// Growing an empty box by a box gives that box
+	aabb filled = empty;
+	filled.grow(box);
+	check(sameBox(filled, box), "growing an empty box by a box gives that box", allPassed);
+
+	// Growing an empty box by an empty box stays empty
+	aabb stillEmpty = empty;
+	stillEmpty.grow(empty);
+	check(stillEmpty.surfaceArea() == 0.0f && stillEmpty.getMin()[0] > stillEmpty.getMax()[0], "growing an empty box by an empty box stays empty", allPassed);
+
+	// **** SAH BUILD WITH EMPTY BINS **** //
+
+	// A tight grid of small spheres, and a few large spheres far away, so the bins between them are empty
+	auto sphereMaterial = make_shared<lambertian>(colour(0.5, 0.5, 0.5));
+	hittableList list;
+	for (int a = 0; a < 8; a++)
+	{
+		for (int b = 0; b < 8; b++)
+		{
+			list.add(make_shared<sphere>(point3(0.1f * a, 0.0f, 0.1f * b), 0.04f, sphereMaterial));
+		}
+	}
+	for (int i = 0; i < 3; i++)
+	{
+		list.add(make_shared<sphere>(point3(100.0f + 4.0f * i, 1.0f, 0.0f), 1.0f, sphereMaterial));
+	}
+
+	// Build the hierarchy
+	bvh hierarchy(list);
+	const int objectCount = static_cast<int>(list.getObjects().size());
+	aabb rootBox;
+	hierarchy.boundingBox(rootBox);
+
+	// The scene is split, into a tree far cheaper than one leaf testing every object
+	check(hierarchy.getNodeCount() > 1, "the clustered scene is split into " + to_string(hierarchy.getNodeCount()) + " nodes", allPassed);
+	check(hierarchy.getSahCost() < 0.5f * objectCount, "SAH cost " + to_string(hierarchy.getSahCost()) + " is under half that of one leaf (" + to_string(objectCount) + ")", allPassed);
+	check(std::isfinite(rootBox.surfaceArea()), "the root box is finite", allPassed);
+
+	// Output the result
+	cout << (allPassed ? "All AABB checks passed" : "AABB checks failed") << endl;
+
+	// Return 0 if every check passed
+	return allPassed ? 0 : 1;
+}
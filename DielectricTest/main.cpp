@@ -0,0 +1,206 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * DIELECTRIC TEST
+ *
+ * Checks the energy split of the dielectric material - rays hitting
+ * glass from outside are reflected with Schlick's approximation of
+ * the Fresnel reflectance as their chance, rays past the critical
+ * angle from inside are always reflected, and refracted rays obey
+ * Snell's law. Run by ctest; exits with 1 if any check fails.
+ */
+
+// Header files
+#include <cmath>
+#include <iostream>
+#include <string>
+
+// Common Library header files
+#include "common/common.h"
+#include "common/hittable.h"
+#include "common/material.h"
+#include "common/sampler.h"
+
+// Namespace
+using namespace std;
+
+// Index of refraction of the glass tested
+const float glassIndex = 1.5f;
+
+// Rays scattered at each angle
+const int trialCount = 1000000;
+
+/*
+ * SCHLICK REFLECTANCE FUNCTION
+ *
+ * Function returns Schlick's approximation of the reflectance, for
+ * light arriving at cosine from a medium with ratio the index of
+ * the other side - written out here rather than taken from the
+ * material, so the two are checked against each other
+ */
+double schlickReflectance(double cosine, double ratio)
+{
+	// Reflectance at normal incidence, rising to 1 at grazing angles
+	double r0 = (1.0 - ratio) / (1.0 + ratio);
+	r0 = r0 * r0;
+	return r0 + (1.0 - r0) * pow(1.0 - cosine, 5.0);
+}
+
+/*
+ * CHECK FUNCTION
+ *
+ * Function outputs the result of a check, and records a failure
+ */
+void check(bool passed, const string& description, bool& allPassed)
+{
+	// Output the result
+	cout << (passed ? "PASS " : "FAIL ") << description << endl;
+	allPassed = allPassed && passed;
+}
+
+/* ==================================================================
+ * SPLIT RESULT STRUCT
+ *
+ * Struct holding what happened to the rays scattered at one angle
+ * ==================================================================
+ */
+struct splitResult
+{
+	// Fraction of the rays reflected
+	double reflectedFraction;
+
+	// Largest error of a reflection from the mirror direction
+	double worstReflection;
+
+	// Largest error of a refraction from Snell's law, or from the plane and side of incidence
+	double worstRefraction;
+
+	// Whether every ray was scattered with no loss of energy
+	bool lossless;
+};
+
+/*
+ * SCATTER SPLIT FUNCTION
+ *
+ * Function scatters rays off a flat glass surface at an angle from
+ * its normal, from outside or from inside the glass, and measures
+ * the split between reflection and refraction
+ */
+splitResult scatterSplit(float angle, bool fromInside)
+{
+	// Surface is the plane y = 0, with the glass below - rays from outside travel down, and from inside travel up
+	vec3 direction(sin(angle), fromInside ? cos(angle) : -cos(angle), 0.0f);
+	ray rayIn(point3(-direction.getX(), -direction.getY(), 0.0f), direction, 0.0f);
+	hitRecord rec = hitRecord();
+	rec.p = point3(0.0f, 0.0f, 0.0f);
+	rec.t = 1.0f;
+	rec.setFaceNormal(rayIn, vec3(0.0f, 1.0f, 0.0f));
+
+	// Ratio of the indices across the surface, and the sine of the angle of incidence
+	double ratio = fromInside ? glassIndex : 1.0 / glassIndex;
+	double sinIncident = sin(static_cast<double>(angle));
+
+	// Scatter every ray
+	independentSampler samp(0x40u);
+	splitResult result = { 0.0, 0.0, 0.0, true };
+	int reflected = 0;
+	for (int i = 0; i < trialCount; i++)
+	{
+		// Scatter the ray
+		samp.startPixelSample(0, 0, i);
+		colour attenuation;
+		ray scattered;
+		result.lossless = dielectric::scatterWith(glassIndex, rayIn, rec, attenuation, scattered, samp) && result.lossless
+			&& attenuation.getX() == 1.0f && attenuation.getY() == 1.0f && attenuation.getZ() == 1.0f;
+
+		// Check which side of the surface the ray left on
+		vec3 out = scattered.getDirection();
+		if (dot(out, rec.normal) > 0.0f)
+		{
+			// Reflected - compare with the mirror direction
+			reflected++;
+			vec3 mirror(direction.getX(), -direction.getY(), 0.0f);
+			result.worstReflection = fmax(result.worstReflection, (unitVector(out) - mirror).length());
+		}
+		else
+		{
+			// Refracted - the sine of the refracted angle is the tangential part of the unit direction
+			vec3 unitOut = unitVector(out);
+			double snellError = fabs(unitOut.getX() - ratio * sinIncident);
+			double planeError = fabs(unitOut.getZ());
+			result.worstRefraction = fmax(result.worstRefraction, fmax(snellError, planeError));
+			result.worstRefraction = fmax(result.worstRefraction, fabs(out.length() - 1.0));
+		}
+	}
+
+	// Return the split
+	result.reflectedFraction = static_cast<double>(reflected) / trialCount;
+	return result;
+}
+
+ /*
+  * MAIN FUNCTION
+  *
+  * The first function that is invoked when the application is loaded.
+  *
+  * Runs each check, returning 1 if any fails.
+  */
+int main()
+{
+	// Whether every check has passed
+	bool allPassed = true;
+
+	// **** SCHLICK SPLIT FROM OUTSIDE **** //
+
+	// Angles from the normal checked - head on, oblique and near grazing
+	const float angles[] = { 0.0f, 1.0f, 1.4f };
+	for (float angle : angles)
+	{
+		// Scatter from outside the glass
+		splitResult result = scatterSplit(angle, false);
+
+		// Expected fraction, within four standard deviations of the binomial count
+		double expected = schlickReflectance(cos(static_cast<double>(angle)), glassIndex);
+		double tolerance = 4.0 * sqrt(expected * (1.0 - expected) / trialCount) + 1e-4;
+		check(fabs(result.reflectedFraction - expected) <= tolerance, "reflected fraction at " + to_string(angle) + " rad is " + to_string(result.reflectedFraction)
+			+ ", Schlick gives " + to_string(expected), allPassed);
+		check(result.worstReflection < 1e-5, "reflections at " + to_string(angle) + " rad follow the mirror direction", allPassed);
+		check(result.worstRefraction < 1e-5, "refractions at " + to_string(angle) + " rad obey Snell's law", allPassed);
+		check(result.lossless, "rays at " + to_string(angle) + " rad keep all their energy", allPassed);
+	}
+
+	// **** TOTAL INTERNAL REFLECTION **** //
+
+	// Past the critical angle of asin(1 / 1.5) = 0.73 rad from inside, every ray is reflected
+	splitResult inside = scatterSplit(1.0f, true);
+	check(inside.reflectedFraction == 1.0, "rays at 1.000000 rad from inside are all reflected (" + to_string(inside.reflectedFraction) + ")", allPassed);
+	check(inside.worstReflection < 1e-5, "internal reflections follow the mirror direction", allPassed);
+
+	// Below the critical angle from inside, rays escape, bent away from the normal
+	splitResult escaping = scatterSplit(0.5f, true);
+	double expected = schlickReflectance(cos(0.5), glassIndex);
+	double tolerance = 4.0 * sqrt(expected * (1.0 - expected) / trialCount) + 1e-4;
+	check(fabs(escaping.reflectedFraction - expected) <= tolerance, "reflected fraction at 0.500000 rad from inside is " + to_string(escaping.reflectedFraction)
+		+ ", Schlick gives " + to_string(expected), allPassed);
+	check(escaping.worstRefraction < 1e-5, "rays escaping at 0.500000 rad from inside obey Snell's law", allPassed);
+
+	// Output the result
+	cout << (allPassed ? "All dielectric checks passed" : "Dielectric checks failed") << endl;
+
+	// Return 0 if every check passed
+	return allPassed ? 0 : 1;
+}
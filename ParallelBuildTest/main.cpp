@@ -0,0 +1,218 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * PARALLEL BUILD TEST
+ *
+ * Checks that building the BVH on several threads gives the same
+ * tree as building it on one, with both presets - the same nodes,
+ * splits and leaf ranges, and the same hits. Subtrees built on
+ * other threads are spliced in after the top of the tree, so the
+ * node arrays are laid out differently and are compared from the
+ * root down. Run by ctest; exits with 1 if any check fails.
+ */
+
+// Header files
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Common Library header files
+#include "common/common.h"
+#include "common/aabb.h"
+#include "common/bvh.h"
+#include "common/material.h"
+#include "common/sphere.h"
+
+// Namespace
+using namespace std;
+
+// Number of boxes - enough that the top nodes are binned across threads
+const int boxCount = 100000;
+
+// Number of spheres, and rays traced through them
+const int sphereCount = 40000;
+const int rayCount = 20000;
+
+/*
+ * CHECK FUNCTION
+ *
+ * Function outputs the result of a check, and records a failure
+ */
+void check(bool passed, const string& description, bool& allPassed)
+{
+	// Output the result
+	cout << (passed ? "PASS " : "FAIL ") << description << endl;
+	allPassed = allPassed && passed;
+}
+
+/*
+ * SAME BOX FUNCTION
+ *
+ * Function determines if two boxes have exactly the same corners
+ */
+bool sameBox(const aabb& a, const aabb& b)
+{
+	// Compare each axis of both corners
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (a.getMin()[axis] != b.getMin()[axis] || a.getMax()[axis] != b.getMax()[axis])
+		{
+			// Corners differ
+			return false;
+		}
+	}
+
+	// Return true
+	return true;
+}
+
+/*
+ * SAME TREE FUNCTION
+ *
+ * Function determines if the subtrees below two nodes are the
+ * same - the same bounds, split axes and leaf ranges - wherever
+ * their nodes lie in the arrays
+ */
+bool sameTree(const vector<bvhNode>& a, int nodeA, const vector<bvhNode>& b, int nodeB)
+{
+	// Compare the nodes
+	const bvhNode& x = a[nodeA];
+	const bvhNode& y = b[nodeB];
+	if (sameBox(x.bounds, y.bounds) == false || x.count != y.count || x.axis != y.axis)
+	{
+		// Nodes differ
+		return false;
+	}
+
+	// Check if the nodes are leaves
+	if (x.count > 0)
+	{
+		// Leaves must cover the same range of objects
+		return x.leftFirst == y.leftFirst;
+	}
+
+	// Compare both children
+	return sameTree(a, x.leftFirst, b, y.leftFirst) && sameTree(a, x.leftFirst + 1, b, y.leftFirst + 1);
+}
+
+ /*
+  * MAIN FUNCTION
+  *
+  * The first function that is invoked when the application is loaded.
+  *
+  * Runs each check, returning 1 if any fails.
+  */
+int main()
+{
+	// Whether every check has passed
+	bool allPassed = true;
+
+	// Fixed random numbers
+	mt19937 generator(48);
+	uniform_real_distribution<float> inBox(-50.0f, 50.0f);
+	uniform_real_distribution<float> size(0.05f, 1.0f);
+	uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	// Thread counts compared against one thread
+	const int threadCounts[] = { 2, 4, 7 };
+
+	// **** BUILD FROM BOUNDS **** //
+
+	// Boxes of varied sizes, some clustered so the splits are uneven, laid out along x in order
+	// so each thread bins a different region, and a thread's bins left out would move the split
+	vector<aabb> bounds;
+	for (int i = 0; i < boxCount; i++)
+	{
+		point3 centre(-50.0f + 100.0f * i / boxCount, inBox(generator), inBox(generator));
+		if (i % 3 == 0)
+		{
+			centre = 0.05f * centre + point3(20.0f, 0.0f, 0.0f);
+		}
+		vec3 half(size(generator), size(generator), size(generator));
+		bounds.push_back(aabb(centre - half, centre + half));
+	}
+
+	// Check each preset
+	const bvhPreset presets[] = { BVH_QUALITY, BVH_FAST };
+	const char* presetNames[] = { "quality", "fast" };
+	for (int p = 0; p < 2; p++)
+	{
+		// Build on one thread
+		bvh single;
+		vector<int> singleOrder;
+		single.setBuildSettings(presets[p], 1);
+		single.buildFromBounds(bounds, singleOrder);
+
+		// Build on several threads, and compare
+		for (int threadCount : threadCounts)
+		{
+			bvh parallel;
+			vector<int> parallelOrder;
+			parallel.setBuildSettings(presets[p], threadCount);
+			parallel.buildFromBounds(bounds, parallelOrder);
+			bool same = parallel.getNodeCount() == single.getNodeCount() && parallelOrder == singleOrder && sameTree(single.getNodes(), 0, parallel.getNodes(), 0);
+			check(same, string(presetNames[p]) + " preset: " + to_string(threadCount) + " threads build the same " + to_string(single.getNodeCount())
+				+ " node tree and object order as one thread", allPassed);
+		}
+	}
+
+	// **** BUILD OVER OBJECTS **** //
+
+	// Spheres, each with its own material so hits can be told apart
+	vector<shared_ptr<hittable>> spheres;
+	for (int i = 0; i < sphereCount; i++)
+	{
+		spheres.push_back(make_shared<sphere>(point3(inBox(generator), inBox(generator), inBox(generator)), 0.3f, make_shared<lambertian>(colour(0.5, 0.5, 0.5))));
+	}
+
+	// Rays from random points in the box, in random directions
+	vector<ray> rays;
+	for (int i = 0; i < rayCount; i++)
+	{
+		rays.push_back(ray(point3(inBox(generator), inBox(generator), inBox(generator)), vec3(unit(generator), unit(generator), unit(generator))));
+	}
+
+	// Build on one thread and on four
+	bvh single, parallel;
+	single.setBuildSettings(BVH_QUALITY, 1);
+	parallel.setBuildSettings(BVH_QUALITY, 4);
+	single.build(spheres);
+	parallel.build(spheres);
+	check(sameTree(single.getNodes(), 0, parallel.getNodes(), 0), "4 threads build the same tree over " + to_string(sphereCount) + " spheres as one thread", allPassed);
+
+	// Compare the closest hit of each ray
+	int different = 0;
+	for (const auto& r : rays)
+	{
+		hitRecord recSingle, recParallel;
+		bool hitSingle = single.hit(r, 0.001f, infinity, recSingle);
+		bool hitParallel = parallel.hit(r, 0.001f, infinity, recParallel);
+		if (hitSingle != hitParallel || (hitSingle && (recSingle.t != recParallel.t || recSingle.materialPointer != recParallel.materialPointer)))
+		{
+			// Missed by one, or a different closest hit
+			different++;
+		}
+	}
+	check(different == 0, "4 threads give the same hits as one thread (" + to_string(different) + " of " + to_string(rayCount) + " rays differ)", allPassed);
+
+	// Output the result
+	cout << (allPassed ? "All parallel build checks passed" : "Parallel build checks failed") << endl;
+
+	// Return 0 if every check passed
+	return allPassed ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * PARTIAL IMAGE MERGE TOOL
+ *
+ * Merges the partial images written by independent renders of the
+ * same scene (path tracer run with --partial and a different --seed
+ * each), refusing images of another scene, scene seed or sampler,
+ * or with a --seed already merged, as they repeat the same samples.
+ * Each pixel is weighted by its samples, and the result is written
+ * as a JPG file and as a partial image, so more renders can be
+ * merged into it later.
+ */
+
+// Header files
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Common Library header files
+#include "common/common.h"
+#include "common/partialImage.h"
+
+// STB Library header file
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb/stb_image_write.h"
+
+// Namespace
+using namespace std;
+
+ /*
+  * MAIN FUNCTION
+  *
+  * The first function that is invoked when the application is loaded.
+  *
+  * Merges the partial images named on the command line into
+  * <output>.jpg and <output>.partial.
+  */
+int main(int argc, char* argv[])
+{
+	// Check an output and at least one partial image were given
+	if (argc < 3)
+	{
+		// Output the usage
+		cerr << "Usage: " << argv[0] << " <output> <partial> [<partial> ...]" << endl
+			<< "  Merges partial images into <output>.jpg and <output>.partial" << endl;
+		return 1;
+	}
+
+	// Output file name, without extension
+	string fileName = argv[1];
+
+	// **** MERGE **** //
+
+	// Merged image
+	partialImage merged;
+
+	// Add each partial image
+	for (int i = 2; i < argc; i++)
+	{
+		// Read the image
+		partialImage partial;
+		if (partial.read(argv[i]) == false || merged.merge(partial) == false)
+		{
+			// Exit - the reason has been output
+			return 1;
+		}
+
+		// Output the image added
+		cout << "Merged " << argv[i] << ": " << partial.getSampleCount(0) << " samples per pixel" << endl;
+	}
+
+	// Output the total
+	cout << "Total: " << merged.getSampleCount(0) << " samples per pixel from " << argc - 2 << " renders" << endl;
+
+	// **** CREATE FILES **** //
+
+	// Write the merged partial image
+	if (merged.write(fileName + ".partial") == false)
+	{
+		// Exit - the reason has been output
+		return 1;
+	}
+
+	// Tone map the merged sums
+	vector<uint8_t> imgVector;
+	merged.toneMap(imgVector);
+
+	// Create JPG file from the JPG Vector
+	string jpgFile = fileName + ".jpg";
+	if (stbi_write_jpg(jpgFile.c_str(), merged.getWidth(), merged.getHeight(), 3, imgVector.data(), 100) == 0)
+	{
+		// File could not be written
+		cerr << "Could not write " << jpgFile << endl;
+		return 1;
+	}
+
+	// Output message to console indicating that the JPG file has been created
+	cout << "JPG File created" << endl;
+
+	// Return 0 - program is finished, all is OK
+	return 0;
+}
@@ -4,7 +4,7 @@
  * GRAEME B. WHITE - 40415739
  * 
  * DATE OF CREATION: 10/10/2020
- * DATE LAST MODIFIED: 14/10/2020
+ * DATE LAST MODIFIED: 18/10/2026
  * ==================================================================
  * PATH-TRACING PROTOTYPE
  *
@@ -24,29 +24,115 @@
 #include <fstream>
 #include <vector>
 #include <string>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
 
 // Common Library header files
 #include "common/common.h"
+#include "common/aov.h"
 #include "common/colour.h"
 #include "common/hittableList.h"
+#include "common/instance.h"
+#include "common/keyframes.h"
+#include "common/light.h"
 #include "common/sphere.h"
 #include "common/camera.h"
+#include "common/denoiser.h"
+#include "common/distributed.h"
 #include "common/material.h"
+#include "common/materialTable.h"
+#include "common/movingSphere.h"
+#include "common/objLoader.h"
+#include "common/partialImage.h"
+#include "common/bvh.h"
+#include "common/renderOptions.h"
+#include "common/renderKernel.h"
+#include "common/sampler.h"
+#include "common/sky.h"
+#include "common/wavefront.h"
 
 // STB Library header file
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include "stb/stb_image_write.h"
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb/stb_image.h"
 
 // Namespace
 using namespace std;
 
+// Declaration of ray colour function, used by the shade hit function
+colour rayColour(ray& r, const hittable& world, const materialTable* materials, const sceneLights& lights, sampler& samp, int depth, int bounce, float scatterPdf, const vec3& scatterNormal);
+
+/*
+ * SHADE HIT FUNCTION
+ *
+ * Function is used to determine and return the
+ * colour of a ray which has hit an object. Materials are
+ * shaded through the material table if one is given, or
+ * through the virtual scatter function if not. Bounce counts up
+ * from 0 at the camera, and selects the sampler's dimensions.
+ * Lights hit are weighted against light sampling by scatterPdf,
+ * the pdf of the scatter which produced the ray, or 0 for camera
+ * rays and specular scatters, and by scatterNormal, the normal of
+ * the surface it left
+ */
+colour shadeHit(const ray& r, const hitRecord& rec, const hittable& world, const materialTable* materials, const sceneLights& lights, sampler& samp, int depth, int bounce, float scatterPdf, const vec3& scatterNormal)
+{
+	// Set the scattered colour to black
+	colour scatteredColour(0.0, 0.0, 0.0);
+
+	// Obtain the material type
+	materialType type = materials != nullptr ? (*materials)[rec.materialIndex].type : rec.materialPointer->getType();
+
+	// Check if a light was hit
+	if (type == EMISSIVE_MATERIAL)
+	{
+		// Return the light's front face emission, weighted against light sampling
+		colour emission = materials != nullptr ? (*materials)[rec.materialIndex].emission : rec.materialPointer->getData().emission;
+		return rec.frontFace ? emissionWeight(lights, r, rec, scatterPdf, scatterNormal) * emission : colour(0.0, 0.0, 0.0);
+	}
+
+	// Obtain the light arriving directly from the lights
+	colour directColour = materials != nullptr ? sampleDirectLight(world, lights, r, rec, (*materials)[rec.materialIndex], samp, bounce)
+		: sampleDirectLight(world, lights, r, rec, *rec.materialPointer, samp, bounce);
+
+	// Empty scattered ray object
+	ray scattered;
+
+	// Empty attenuation colour
+	colour attenuation;
+
+	// Move the sampler to this bounce's dimensions
+	samp.setDimension(bounceDimension(bounce));
+
+	// Check if a scattered ray is created upon collision
+	bool isScattered = materials != nullptr ? scatterMaterial((*materials)[rec.materialIndex], r, rec, attenuation, scattered, samp)
+		: rec.materialPointer->scatter(r, rec, attenuation, scattered, samp);
+
+	// Check if the scattered ray was created
+	if (isScattered)
+	{
+		// Obtain the pdf of the scatter
+		float nextScatterPdf = materials != nullptr ? materialPdf((*materials)[rec.materialIndex], r, rec, scattered.getDirection())
+			: rec.materialPointer->pdf(r, rec, scattered.getDirection());
+
+		// Scattered ray is true, obtain the scattered ray colour
+		scatteredColour = attenuation * rayColour(scattered, world, materials, lights, samp, depth - 1, bounce + 1, nextScatterPdf, rec.normal);
+	}
+
+	// Return the direct and scattered ray colour
+	return directColour + scatteredColour;
+}
+
 /*
  * RAY COLOUR FUNCTION
  *
  * Function is used to determine and return the
  * colour of a ray
  */
-colour rayColour(ray& r, const hittable& world, int depth)
+colour rayColour(ray& r, const hittable& world, const materialTable* materials, const sceneLights& lights, sampler& samp, int depth, int bounce, float scatterPdf, const vec3& scatterNormal)
 {
 	// Create empty ray colour vector
 	colour colourOfRay;
@@ -63,37 +149,14 @@ colour rayColour(ray& r, const hittable& world, int depth)
 	// Check if an object in the world has been hit (0.001 as tMin to fix shadow acne)
 	else if (world.hit(r, 0.001, infinity, rec))
 	{
-		// Set the scattered colour to black
-		colour scatteredColour(0.0, 0.0, 0.0);
-
-		// Empty scattered ray object
-		ray scattered;
-
-		// Empty attenuation colour
-		colour attenuation;
-
-		// Check if a scattered ray is created upon collision
-		if (rec.materialPointer->scatter(r, rec, attenuation, scattered))
-		{
-			// Scattered ray is true, obtain the scattered ray colour
-			scatteredColour = attenuation * rayColour(scattered, world, depth - 1);
-		}
-		
 		// Set the colour of the ray to the scattered ray colour
-		colourOfRay = scatteredColour;
-
+		colourOfRay = shadeHit(r, rec, world, materials, lights, samp, depth, bounce, scatterPdf, scatterNormal);
 	}
 	// No collision with object
 	else
 	{
-		// Determine the unit direction of the ray
-		vec3 unitDirection = unitVector(r.getDirection());
-
-		// Obtain ray parameter, t
-		auto  t = 0.5 * (unitDirection.getY() + 1.0);
-
-		// Determine the ray colour
-		colourOfRay = (1.0 - t) * colour(1.0, 1.0, 1.0) + t * colour(0.5, 0.7, 1.0);
+		// Set the colour of the ray to the sky colour, weighted against sampling the sky
+		colourOfRay = escapedRadiance(lights, r, scatterPdf);
 	}
 
 	// Return the ray colour
@@ -159,18 +222,180 @@ hittableList basicScene()
 	return world;
 }
 
+/*
+ * LIGHTS SCENE FUNCTION
+ *
+ * Function is used to create a night scene lit by small
+ * sphere lights - a ground sphere, the 3 large spheres of
+ * the random scene, a grid of small diffuse and glossy spheres, a row
+ * of glowing orbs, and one light overhead. Nothing is
+ * random, so renders can be compared
+ */
+hittableList lightsScene()
+{
+	hittableList world;
+
+	// Ground material as grey Lambertian material
+	auto groundMaterial = make_shared<lambertian>(colour(0.5, 0.5, 0.5));
+
+	// Add ground sphere to the world list
+	world.add(make_shared<sphere>(point3(0, -1000, 0), 1000.0, groundMaterial));
+
+	// Grid of small spheres, coloured by position - alternately diffuse and glossy metal
+	for (int a = -5; a <= 5; a++)
+	{
+		for (int b = -3; b <= 3; b++)
+		{
+			// Leave room for the large spheres and the orbs
+			if (b == 0 || b == 1)
+			{
+				continue;
+			}
+
+			// Determine the colour
+			colour albedo(0.3 + 0.06 * (a + 5), 0.3 + 0.1 * (b + 3), 0.9 - 0.06 * (a + 5));
+
+			// Create Lambertian or low fuzz metal material
+			shared_ptr<material> sphereMaterial;
+			if ((a + b) % 2 == 0)
+			{
+				sphereMaterial = make_shared<lambertian>(albedo);
+			}
+			else
+			{
+				sphereMaterial = make_shared<metal>(albedo, 0.1);
+			}
+
+			// Add sphere to the world hittable list
+			world.add(make_shared<sphere>(point3(1.2 * a, 0.2, 1.2 * b), 0.2, sphereMaterial));
+		}
+	}
+
+	// Glass sphere
+	world.add(make_shared<sphere>(point3(0, 1, 0), 1.0, make_shared<dielectric>(1.5)));
+
+	// Diffuse sphere
+	world.add(make_shared<sphere>(point3(-4, 1, 0), 1.0, make_shared<lambertian>(colour(0.4, 0.2, 0.1))));
+
+	// Metal sphere
+	world.add(make_shared<sphere>(point3(4, 1, 0), 1.0, make_shared<metal>(colour(0.7, 0.6, 0.5), 0.0)));
+
+	// Row of small, warm orbs in front of the large spheres
+	auto orbLight = make_shared<diffuseLight>(colour(40.0, 28.0, 12.0));
+	for (int a = -3; a <= 3; a++)
+	{
+		// Add orb light to the world hittable list
+		world.add(make_shared<sphere>(point3(2.0 * a, 0.15, 1.6), 0.15, orbLight));
+	}
+
+	// Cool light overhead
+	world.add(make_shared<sphere>(point3(0, 5, -3), 0.5, make_shared<diffuseLight>(colour(12.0, 14.0, 20.0))));
+
+	// Return the world hittable list object
+	return world;
+}
+
+/*
+ * MANY LIGHTS SCENE FUNCTION
+ *
+ * Function is used to create a night scene lit by 10,000
+ * small sphere lights scattered over the ground around the
+ * 3 large spheres of the random scene, with a wide range of
+ * brightness. Used to compare ways of picking a light. The
+ * lights come from a fixed seed, so renders can be compared
+ */
+hittableList manyLightsScene()
+{
+	hittableList world;
+
+	// Ground material as grey Lambertian material
+	auto groundMaterial = make_shared<lambertian>(colour(0.5, 0.5, 0.5));
+
+	// Add ground sphere to the world list
+	world.add(make_shared<sphere>(point3(0, -1000, 0), 1000.0, groundMaterial));
+
+	// Glass sphere
+	world.add(make_shared<sphere>(point3(0, 1, 0), 1.0, make_shared<dielectric>(1.5)));
+
+	// Diffuse sphere
+	world.add(make_shared<sphere>(point3(-4, 1, 0), 1.0, make_shared<lambertian>(colour(0.4, 0.2, 0.1))));
+
+	// Glossy metal sphere
+	world.add(make_shared<sphere>(point3(4, 1, 0), 1.0, make_shared<metal>(colour(0.7, 0.6, 0.5), 0.1)));
+
+	// Number of lights, the side of the grid they are jittered over, and their radius
+	const int lightCount = 10000;
+	const int gridSize = 110;
+	const float spacing = 0.45f;
+	const float lightRadius = 0.04f;
+
+	// Fixed random number generator
+	pcg32 rng;
+	rng.seed(0x11647u, 7u);
+
+	// **** LIGHTS **** //
+
+	// Place lights over the grid until there are enough
+	int placed = 0;
+	for (int a = 0; a < gridSize && placed < lightCount; a++)
+	{
+		for (int b = 0; b < gridSize && placed < lightCount; b++)
+		{
+			// Determine the centre of the light - jittered within its grid cell, resting on the ground
+			point3 centre((a - gridSize / 2 + 0.8f * rng.nextFloat()) * spacing, lightRadius + 0.5f * rng.nextFloat(), (b - gridSize / 2 + 0.8f * rng.nextFloat()) * spacing);
+
+			// Check if the light is clear of the large spheres
+			if ((centre - point3(0, lightRadius, 0)).length() < 1.1f || (centre - point3(-4, lightRadius, 0)).length() < 1.1f
+				|| (centre - point3(4, lightRadius, 0)).length() < 1.1f)
+			{
+				// Skip the light
+				continue;
+			}
+
+			// Determine the colour, and a brightness from a long tailed distribution so a few lights dominate
+			colour tint(0.3f + 0.7f * rng.nextFloat(), 0.3f + 0.7f * rng.nextFloat(), 0.3f + 0.7f * rng.nextFloat());
+			float u = rng.nextFloat();
+			float brightness = 1.0f + 24.0f * u * u * u * u;
+
+			// Add light to the world hittable list
+			world.add(make_shared<sphere>(centre, lightRadius, make_shared<diffuseLight>(brightness * tint)));
+			placed++;
+		}
+	}
+
+	// Return the world hittable list object
+	return world;
+}
+
 /*
  * RANDOM SCENE FUNCTION
  * 
  * Function is used to create a scene with a
  * ground scene, 3 spheres next to each other and
  * numerous smaller spheres randomonly placed 
- * around the scene 
+ * around the scene. If moving is true, the small
+ * diffuse spheres bounce upwards while the shutter
+ * is open, for motion blur. The spheres are drawn
+ * from a generator seeded with sceneSeed, so every
+ * run - and every worker - builds the same scene
  */
-hittableList randomScene()
+hittableList randomScene(unsigned int sceneSeed, bool moving = false)
 {
 	hittableList world;
 
+	// Fixed random number generator
+	pcg32 rng;
+	rng.seed(0x5eedu + sceneSeed, 11u);
+
+	// Random colour with each channel in [min, max) - channels drawn in order, as argument order is unspecified
+	auto randomColour = [&rng](float min, float max)
+	{
+		float r = min + (max - min) * rng.nextFloat();
+		float g = min + (max - min) * rng.nextFloat();
+		float b = min + (max - min) * rng.nextFloat();
+		return colour(r, g, b);
+	};
+
 	// Ground material as grey Lambertian material
 	auto groundMaterial = make_shared<lambertian>(colour(0.5, 0.5, 0.5));
 
@@ -204,13 +429,15 @@ hittableList randomScene()
 		for (int b = yMin; b < yMax; b++)
 		{
 			// Choose material
-			auto chooseMaterial = randomInt(1, 3);
+			auto chooseMaterial = 1 + static_cast<int>(rng.nextUint() % 3u);
 
 			// Determine sphere radius
-			auto sphereRadius = randomFloat(minRadius, maxRadius);
+			auto sphereRadius = minRadius + (maxRadius - minRadius) * rng.nextFloat();
 
 			// Determine centre of the sphere - note, y set to 0.2
-			point3 center(a + 0.9 * randomFloat(), sphereRadius, b + 0.9 * randomFloat());
+			float jitterX = rng.nextFloat();
+			float jitterZ = rng.nextFloat();
+			point3 center(a + 0.9 * jitterX, sphereRadius, b + 0.9 * jitterZ);
 
 			// Check if the sphere is out of range of the central spheres
 			if ((center - point3(4, sphereRadius, 0)).length() > 0.9)
@@ -224,22 +451,33 @@ hittableList randomScene()
 				{
 					// 1 - Lambertian diffuse material
 					// Determine albedo colour
-					auto albedo = colour::random() * colour::random();
+					colour albedoA = randomColour(0, 1);
+					auto albedo = albedoA * randomColour(0, 1);
 
 					// Lambertian diffuese material
 					sphereMaterial = make_shared<lambertian>(albedo);
 
-					// Add lambertian sphere to the world list
-					world.add(make_shared<sphere>(center, sphereRadius, sphereMaterial));
+					// Check if the spheres move
+					if (moving)
+					{
+						// Add lambertian sphere to the world list, bouncing up over times 0 to 1
+						point3 centreAtEnd = center + vec3(0, 0.5 * rng.nextFloat(), 0);
+						world.add(make_shared<movingSphere>(center, centreAtEnd, 0.0, 1.0, sphereRadius, sphereMaterial));
+					}
+					else
+					{
+						// Add lambertian sphere to the world list
+						world.add(make_shared<sphere>(center, sphereRadius, sphereMaterial));
+					}
 				}
 				else if (chooseMaterial == 2)
 				{
 					// 2 - Metal material
 					// Determine albedo colour 
-					auto albedo = colour::random(0.5, 1);
+					auto albedo = randomColour(0.5, 1);
 
 					// Set fuzz to a random number
-					auto fuzz = randomFloat();
+					auto fuzz = rng.nextFloat();
 
 					// Metal material
 					sphereMaterial = make_shared<metal>(albedo, fuzz);
@@ -257,7 +495,7 @@ hittableList randomScene()
 					world.add(make_shared<sphere>(center, sphereRadius, sphereMaterial));
 
 					// Determine the choice of glass
-					auto glassChoice = randomInt(1, 2);
+					auto glassChoice = 1 + static_cast<int>(rng.nextUint() % 2u);
 
 					// Check the value of glassChoice
 					if (glassChoice == 1)
@@ -299,77 +537,267 @@ hittableList randomScene()
 	return world;
 }
 
- /*
-  * MAIN FUNCTION
-  *
-  * The first function that is invoked when the application is loaded.
-  *
-  * Creates a basic image equivalent of "Hello, World!"depending on the
-  * height and width of the image settings.
-  */
-int main()
+/*
+ * INSTANCES SCENE FUNCTION
+ *
+ * Function is used to create a field of pebble piles
+ * around the 3 large spheres of the random scene. Each
+ * pile is an instance of one of a few shared clusters of
+ * small spheres, each cluster under its own hierarchy, so
+ * about a million spheres are seen while only a few
+ * thousand are stored. The piles come from a fixed seed, so
+ * renders can be compared
+ */
+hittableList instancesScene(bvhPreset preset, int buildThreads)
 {
-	// **** IMAGE PROPERTIES **** //
-	
-	// Aspect ratio
-	const auto aspectRatio = 16.0 / 9.0;
-	
-	// Image width
-	const int imageWidth = 960;
+	hittableList world;
 
-	// Determine the image height, based on the image width and aspect ratio
-	const int imageHeight = static_cast<int>(imageWidth / aspectRatio);
+	// Ground material as grey Lambertian material
+	auto groundMaterial = make_shared<lambertian>(colour(0.5, 0.5, 0.5));
 
-	// Samples Per Pixel
-	const int samplesPerPixel = 100;
+	// Add ground sphere to the world list
+	world.add(make_shared<sphere>(point3(0, -1000, 0), 1000.0, groundMaterial));
 
-	// Maximum depth
-	const int maxDepth = 50;
+	// Number of clusters, spheres in each cluster, and the radius of the mound they form
+	const int clusterCount = 4;
+	const int clusterSize = 1000;
+	const float moundRadius = 0.3f;
 
-	// Output file name
-	string fileName = "protoRTOW_Final01";
+	// Fixed random number generator
+	pcg32 rng;
+	rng.seed(0x4911u, 3u);
 
-	// Image Vector
-	vector<uint8_t> imgVector;
+	// **** CLUSTERS **** //
 
-	// Clear the jpgVector
-	imgVector.clear();
+	// Build each cluster of spheres under its own hierarchy
+	vector<shared_ptr<hittable>> clusters;
+	for (int c = 0; c < clusterCount; c++)
+	{
+		// Palette of the cluster - two diffuse colours and a metal
+		shared_ptr<material> palette[3] =
+		{
+			make_shared<lambertian>(colour(0.2f + 0.8f * rng.nextFloat(), 0.2f + 0.8f * rng.nextFloat(), 0.2f + 0.8f * rng.nextFloat())),
+			make_shared<lambertian>(colour(0.2f + 0.8f * rng.nextFloat(), 0.2f + 0.8f * rng.nextFloat(), 0.2f + 0.8f * rng.nextFloat())),
+			make_shared<metal>(colour(0.6f + 0.4f * rng.nextFloat(), 0.6f + 0.4f * rng.nextFloat(), 0.6f + 0.4f * rng.nextFloat()), 0.3f * rng.nextFloat())
+		};
+
+		// Scatter small spheres through a mound resting on the ground
+		hittableList cluster;
+		for (int s = 0; s < clusterSize; s++)
+		{
+			// Pick a point in the unit hemisphere
+			vec3 offset;
+			do
+			{
+				offset = vec3(2.0f * rng.nextFloat() - 1.0f, rng.nextFloat(), 2.0f * rng.nextFloat() - 1.0f);
+			} while (offset.lengthSquared() > 1.0f);
 
-	// **** WORLD PROPERTIES **** //
-	
-	// Obtain hittable list from basicScene() function
-	//auto world = basicScene();
+			// Add a pebble, in one of the palette's materials
+			float pebbleRadius = 0.015f + 0.025f * rng.nextFloat();
+			point3 centre = moundRadius * offset + vec3(0, pebbleRadius, 0);
+			cluster.add(make_shared<sphere>(centre, pebbleRadius, palette[min(static_cast<int>(3.0f * rng.nextFloat()), 2)]));
+		}
 
-	// Obtain hittable list from randomScene() function
-	auto world = randomScene();
+		// Build the cluster's hierarchy - the bottom level, shared by every pile
+		auto clusterBvh = make_shared<bvh>();
+		clusterBvh->setBuildSettings(preset, buildThreads);
+		clusterBvh->build(cluster.getObjects());
+		clusters.push_back(clusterBvh);
+	}
 
-	// **** CAMERA SETTINGS **** //
-	
-	// Camera looking from
-	point3 lookFrom(13, 3, 2);
+	// **** PILES **** //
 
-	//point3 lookFrom(0, 1, -1);
+	// Place a pile in each cell of the grid, turned, scaled and jittered within it
+	const int gridSize = 32;
+	const float spacing = 0.7f;
+	int pileCount = 0;
+	for (int a = 0; a < gridSize; a++)
+	{
+		for (int b = 0; b < gridSize; b++)
+		{
+			// Determine the pile's position, turn about the vertical, and size - squashed or stretched upwards
+			point3 position((a - gridSize / 2 + 0.5f * rng.nextFloat()) * spacing, 0.0f, (b - gridSize / 2 + 0.5f * rng.nextFloat()) * spacing);
+			float turn = 360.0f * rng.nextFloat();
+			float size = 0.7f + 0.6f * rng.nextFloat();
+			float height = 0.6f + 0.8f * rng.nextFloat();
+			int clusterIndex = min(static_cast<int>(clusterCount * rng.nextFloat()), clusterCount - 1);
+
+			// Check if the pile is clear of the large spheres
+			if ((position - point3(0, 0, 0)).length() < 1.4f || (position - point3(-4, 0, 0)).length() < 1.4f || (position - point3(4, 0, 0)).length() < 1.4f)
+			{
+				// Skip the pile
+				continue;
+			}
 
-	// Camera look at
-	point3 lookAt(0, 0, 0);
-	//point3 lookAt(0, 1, 1);
-	
-	// Camera vertical up
-	vec3 verticalUp(0, 1, 0);
+			// Add an instance of the cluster to the world hittable list
+			affineTransform placement = affineTransform::translation(position) * affineTransform::rotation(vec3(0, 1, 0), turn) * affineTransform::scaling(vec3(size, size * height, size));
+			world.add(make_shared<instance>(clusters[clusterIndex], placement));
+			pileCount++;
+		}
+	}
 
-	// Vertical Field of View
-	float verticalFoV = 20.0;
+	// **** CENTRAL SPHERES **** //
 
-	// Distance to focus
-	auto distanceToFocus = 10.0;
+	// Glass sphere
+	world.add(make_shared<sphere>(point3(0, 1, 0), 1.0, make_shared<dielectric>(1.5)));
 
-	// Camera Aperture
-	float aperture = 0.25;
+	// Diffuse sphere
+	world.add(make_shared<sphere>(point3(-4, 1, 0), 1.0, make_shared<lambertian>(colour(0.4, 0.2, 0.1))));
 
-	// Camera object
-	camera cam(lookFrom, lookAt, verticalUp, verticalFoV, aspectRatio, aperture, distanceToFocus);
+	// Metal sphere
+	world.add(make_shared<sphere>(point3(4, 1, 0), 1.0, make_shared<metal>(colour(0.7, 0.6, 0.5), 0.0)));
 
-	// **** RENDER IMAGE **** //
+	// Output instancing statistics
+	cout << "Instanced scene: " << pileCount << " piles of " << clusterSize << " spheres, " << static_cast<long long>(pileCount) * clusterSize
+		<< " spheres seen from " << clusterCount * clusterSize << " stored" << endl;
+
+	// Return the world hittable list object
+	return world;
+}
+
+/*
+ * TORUS MESH FUNCTION
+ *
+ * Function is used to create a smooth shaded torus
+ * standing upright, facing along the x axis, as a
+ * triangle mesh of rings around the tube by sides
+ * around each ring
+ */
+shared_ptr<triangleMesh> torusMesh(float majorRadius, float minorRadius, int rings, int sides, shared_ptr<material> m, bvhPreset preset, int buildThreads)
+{
+	// Vertex buffers, one vertex where each ring meets each side
+	vector<point3> vertices;
+	vector<vec3> normals;
+	for (int ring = 0; ring < rings; ring++)
+	{
+		// Determine the direction of the ring's centre from the middle of the torus
+		float theta = 2.0f * pi * ring / rings;
+		vec3 outward(0.0f, sin(theta), cos(theta));
+		for (int side = 0; side < sides; side++)
+		{
+			// Determine the normal around the tube, and the vertex along it
+			float phi = 2.0f * pi * side / sides;
+			vec3 normal = cos(phi) * outward + sin(phi) * vec3(1.0f, 0.0f, 0.0f);
+			vertices.push_back(majorRadius * outward + minorRadius * normal);
+			normals.push_back(normal);
+		}
+	}
+
+	// Index buffer, two triangles between each pair of neighbouring rings and sides, wound to face outwards
+	vector<int> indices;
+	for (int ring = 0; ring < rings; ring++)
+	{
+		for (int side = 0; side < sides; side++)
+		{
+			int a = ring * sides + side;
+			int b = ((ring + 1) % rings) * sides + side;
+			int c = ((ring + 1) % rings) * sides + (side + 1) % sides;
+			int d = ring * sides + (side + 1) % sides;
+			int quad[6] = { a, d, c, a, c, b };
+			indices.insert(indices.end(), quad, quad + 6);
+		}
+	}
+
+	// Create the mesh
+	return make_shared<triangleMesh>(move(vertices), move(indices), move(normals), m, preset, buildThreads);
+}
+
+/*
+ * MESH SCENE FUNCTION
+ *
+ * Function is used to create a scene with a triangle
+ * mesh read from an OBJ file, or a generated torus if
+ * no file is given, standing on the ground between a
+ * diffuse and a metal sphere. The mesh is fitted into
+ * a 2 unit box by an instance, so any asset can be
+ * dropped in. Returns false if the file cannot be read
+ */
+bool meshScene(const string& meshFile, bvhPreset preset, int buildThreads, hittableList& world)
+{
+	// Ground material as grey Lambertian material
+	auto groundMaterial = make_shared<lambertian>(colour(0.5, 0.5, 0.5));
+
+	// Add ground sphere to the world list
+	world.add(make_shared<sphere>(point3(0, -1000, 0), 1000.0, groundMaterial));
+
+	// Diffuse sphere, behind and to the left
+	world.add(make_shared<sphere>(point3(-2, 1, -3), 1.0, make_shared<lambertian>(colour(0.4, 0.2, 0.1))));
+
+	// Metal sphere, in front and to the right
+	world.add(make_shared<sphere>(point3(2, 1, 3), 1.0, make_shared<metal>(colour(0.7, 0.6, 0.5), 0.0)));
+
+	// **** MESH **** //
+
+	// Mesh material - lightly brushed copper
+	auto meshMaterial = make_shared<metal>(colour(0.95, 0.64, 0.54), 0.15);
+
+	// Load the mesh, or generate the torus
+	auto loadStart = chrono::steady_clock::now();
+	shared_ptr<triangleMesh> mesh = meshFile.empty() ? torusMesh(0.8f, 0.3f, 512, 256, meshMaterial, preset, buildThreads) : loadObj(meshFile, meshMaterial, preset, buildThreads);
+	auto loadEnd = chrono::steady_clock::now();
+
+	// Check the mesh was loaded
+	if (mesh == nullptr)
+	{
+		// Mesh could not be read
+		return false;
+	}
+
+	// Output mesh statistics
+	cout << "Mesh loaded: " << mesh->getTriangleCount() << " triangles, " << mesh->getVertexCount() << " vertices, hierarchy of "
+		<< mesh->getHierarchy().getNodeCount() << " nodes, " << mesh->getMemorySize() / 1024 << " KB in "
+		<< chrono::duration<double, milli>(loadEnd - loadStart).count() << " ms" << endl;
+
+	// Scale the mesh so its longest side is 2, and stand it on the ground at the centre
+	aabb bounds;
+	mesh->boundingBox(bounds);
+	vec3 extent = bounds.getMax() - bounds.getMin();
+	float scale = 2.0f / max(extent.getX(), max(extent.getY(), extent.getZ()));
+	vec3 base(0.5f * (bounds.getMin().getX() + bounds.getMax().getX()), bounds.getMin().getY(), 0.5f * (bounds.getMin().getZ() + bounds.getMax().getZ()));
+	world.add(make_shared<instance>(mesh, affineTransform::scaling(vec3(scale, scale, scale)) * affineTransform::translation(-base)));
+
+	// Return true
+	return true;
+}
+
+/*
+ * ADD FIRST HIT FUNCTION
+ *
+ * Function adds the first hit of camera ray r, or its miss, to
+ * the AOV buffers, if any are being filled. The albedo is read
+ * through the material table if one is given, or through the
+ * material object if not
+ */
+void addFirstHit(aovBuffers* aovs, int pixel, const ray& r, bool hitAnything, const hitRecord& rec, const materialTable* materials)
+{
+	// Check if AOVs are being filled
+	if (aovs != nullptr)
+	{
+		// Add the hit or the miss
+		if (hitAnything)
+		{
+			aovs->addHit(pixel, r, rec, materials != nullptr ? materialAlbedo((*materials)[rec.materialIndex]) : materialAlbedo(*rec.materialPointer));
+		}
+		else
+		{
+			aovs->addMiss(pixel);
+		}
+	}
+}
+
+/*
+ * RENDER IMAGE FUNCTION
+ *
+ * Function renders the image one ray at a time, adding the
+ * colour of every sample to the frame buffer, and the first hits
+ * to the AOV buffers if any are given. The frame buffer is
+ * ordered from the top row of the image down
+ */
+void renderImage(const camera& cam, const hittable& world, const materialTable* materials, const sceneLights& lights, sampler& samp, const renderOptions& options, vector<colour>& frameBuffer, aovBuffers* aovs)
+{
+	// Obtain the image dimensions
+	const int imageWidth = options.imageWidth;
+	const int imageHeight = options.getImageHeight();
 
 	// Iterate all pixels over image height, starting from the top of the image
 	for (int j = imageHeight - 1; j >= 0; j--)
@@ -384,28 +812,1423 @@ int main()
 			colour pixelColour(0.0f, 0.0f, 0.0f);
 
 			// Iterate pixel over samples per pixel
-			for (int s = 0; s < samplesPerPixel; s++)
+			for (int s = 0; s < options.samplesPerPixel; s++)
 			{
+				// Start the pixel sample, and obtain the pixel offset and lens position
+				samp.startPixelSample(i, j, s);
+				sample2D pixelSample = samp.get2D();
+				sample2D lensSample = samp.get2D();
+
 				// Determine u coordinate of pixel
-				auto u = (i + randomFloat()) / (imageWidth - 1);
+				auto u = (i + pixelSample.x) / (imageWidth - 1);
 
 				// Determine v coordinate of pixel
-				auto v = (j + randomFloat()) / (imageHeight - 1);
+				auto v = (j + pixelSample.y) / (imageHeight - 1);
+
+				// Cast ray from the pixel at (u,v), at a time within the shutter interval
+				ray r = cam.getRay(u, v, lensSample, cam.sampleTime(samp));
 
-				// Cast ray from the pixel at (u,v)
-				ray r = cam.getRay(u, v);
+				// Find the first hit here rather than in rayColour, so it can be added to the AOVs
+				hitRecord rec;
+				bool hitAnything = options.maxDepth > 0 && world.hit(r, 0.001, infinity, rec);
+				addFirstHit(aovs, (imageHeight - 1 - j) * imageWidth + i, r, hitAnything, rec, materials);
 
-				// Determine the pixel colour based on the ray
-				pixelColour += rayColour(r, world, maxDepth);
+				// Determine the pixel colour based on the ray - with a depth of 0 no light is gathered
+				if (hitAnything)
+				{
+					// Ray hit an object, continue the path
+					pixelColour += shadeHit(r, rec, world, materials, lights, samp, options.maxDepth, 0, 0.0f, vec3(0.0, 0.0, 0.0));
+				}
+				else if (options.maxDepth > 0)
+				{
+					// Ray escaped the scene
+					pixelColour += lights.skyRadiance(r);
+				}
 			}
 
-			// Invoke the write colour function
-			writeColour(pixelColour, imgVector, samplesPerPixel);
+			// Store the pixel colour in the frame buffer
+			frameBuffer[(imageHeight - 1 - j) * imageWidth + i] = pixelColour;
 		}
 	}
+}
 
-	// End the line on the console window
-	cout << endl;
+/*
+ * RENDER IMAGE PACKETS FUNCTION
+ *
+ * Function renders the image with the camera rays of
+ * neighbouring pixels traced together as packets. Only the
+ * first hit uses the packet; the incoherent secondary bounces
+ * fall back to single rays. First hits are added to the AOV
+ * buffers, if any are given
+ */
+void renderImagePackets(const camera& cam, const hittable& world, const materialTable* materials, const sceneLights& lights, sampler& samp, const renderOptions& options, vector<colour>& frameBuffer, aovBuffers* aovs)
+{
+	// Obtain the image dimensions
+	const int imageWidth = options.imageWidth;
+	const int imageHeight = options.getImageHeight();
+
+	// Packet, hit records, and results for each lane
+	rayPacket packet;
+	hitRecord rec[packetWidth];
+	bool hits[packetWidth];
+	alignas(16) float tMax[packetWidth];
+
+	// Iterate over each row of tiles, starting from the top of the image
+	for (int tileY = ((imageHeight - 1) / packetTileHeight) * packetTileHeight; tileY >= 0; tileY -= packetTileHeight)
+	{
+		// Display progress to the console window
+		cout << "\rScanlines remaining: " << tileY << ' ' << flush;
+
+		// Iterate over each tile in the row
+		for (int tileX = 0; tileX < imageWidth; tileX += packetTileWidth)
+		{
+			// Iterate over samples per pixel
+			for (int s = 0; s < options.samplesPerPixel; s++)
+			{
+				// Fill the packet with camera rays
+				if (cam.hasLens())
+				{
+					fillCameraPacket<true>(cam, tileX, tileY, s, imageWidth, imageHeight, samp, packet);
+				}
+				else
+				{
+					fillCameraPacket<false>(cam, tileX, tileY, s, imageWidth, imageHeight, samp, packet);
+				}
+
+				// Reset the results of each lane
+				for (int lane = 0; lane < packetWidth; lane++)
+				{
+					// No hit yet
+					hits[lane] = false;
+					tMax[lane] = infinity;
+				}
+
+				// Trace the packet (0.001 as tMin to fix shadow acne)
+				if (options.maxDepth > 0)
+				{
+					// Find the first hit of every lane
+					world.hitPacket(packet, 0.001, tMax, rec, hits);
+				}
+
+				// Shade each active lane on its own
+				for (int lane = 0; lane < packetWidth; lane++)
+				{
+					// Check if lane is active
+					if (packet.active[lane] == 0)
+					{
+						// Skip the lane
+						continue;
+					}
+
+					// Obtain the ray of the lane
+					ray r = packet.getRay(lane);
+
+					// Determine the pixel covered by the lane
+					int i = tileX + lane % packetTileWidth;
+					int j = tileY + lane / packetTileWidth;
+					int pixel = (imageHeight - 1 - j) * imageWidth + i;
+
+					// Add the lane's first hit to the AOVs
+					addFirstHit(aovs, pixel, r, hits[lane], rec[lane], materials);
+
+					// Determine the colour of the lane
+					colour laneColour;
+					if (options.maxDepth <= 0)
+					{
+						// Ray bounce limit, no light gathered
+						laneColour = colour(0.0, 0.0, 0.0);
+					}
+					else if (hits[lane])
+					{
+						// Lane hit an object, resume its pixel sample and continue the path with single rays
+						samp.startPixelSample(i, j, s, firstBounceDimension);
+						laneColour = shadeHit(r, rec[lane], world, materials, lights, samp, options.maxDepth, 0, 0.0f, vec3(0.0, 0.0, 0.0));
+					}
+					else
+					{
+						// Lane escaped the scene
+						laneColour = lights.skyRadiance(r);
+					}
+
+					// Add the colour to the frame buffer
+					frameBuffer[pixel] += laneColour;
+				}
+			}
+		}
+	}
+}
+
+/*
+ * PACKET BENCHMARK FUNCTION
+ *
+ * Function times the first hit of one camera ray per pixel,
+ * traced through the BVH as single rays and as packets, and
+ * writes the speedup to the console
+ */
+void packetBenchmark(const string& sceneName, const hittableList& scene, const camera& cam, const renderOptions& options)
+{
+	// Obtain the image dimensions
+	const int imageWidth = options.imageWidth;
+	const int imageHeight = options.getImageHeight();
+
+	// Number of times each pass is repeated
+	const int repeats = 5;
+
+	// Build the hierarchy
+	bvh world(scene);
+
+	// Sampler for the camera rays
+	independentSampler samp(options.seed);
+
+	// Generate the packets up front, so random numbers are not timed
+	vector<rayPacket> packets;
+	for (int tileY = 0; tileY < imageHeight; tileY += packetTileHeight)
+	{
+		for (int tileX = 0; tileX < imageWidth; tileX += packetTileWidth)
+		{
+			// Fill the next packet
+			packets.push_back(rayPacket());
+			fillCameraPacket<true>(cam, tileX, tileY, 0, imageWidth, imageHeight, samp, packets.back());
+		}
+	}
+
+	// Number of hits, compared between the passes
+	long singleHits = 0;
+	long packetHits = 0;
+
+	// Time single rays
+	auto singleStart = chrono::steady_clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		for (const auto& packet : packets)
+		{
+			for (int lane = 0; lane < packetWidth; lane++)
+			{
+				// Check if lane is active
+				if (packet.active[lane])
+				{
+					// Trace the lane on its own
+					hitRecord rec;
+					singleHits += world.hit(packet.getRay(lane), 0.001, infinity, rec) ? 1 : 0;
+				}
+			}
+		}
+	}
+	auto singleEnd = chrono::steady_clock::now();
+
+	// Time packets
+	auto packetStart = chrono::steady_clock::now();
+	for (int repeat = 0; repeat < repeats; repeat++)
+	{
+		for (const auto& packet : packets)
+		{
+			// Reset the results of each lane
+			hitRecord rec[packetWidth];
+			bool hits[packetWidth];
+			alignas(16) float tMax[packetWidth];
+			for (int lane = 0; lane < packetWidth; lane++)
+			{
+				hits[lane] = false;
+				tMax[lane] = infinity;
+			}
+
+			// Trace the packet
+			world.hitPacket(packet, 0.001, tMax, rec, hits);
+
+			// Count the hits
+			for (int lane = 0; lane < packetWidth; lane++)
+			{
+				packetHits += hits[lane] ? 1 : 0;
+			}
+		}
+	}
+	auto packetEnd = chrono::steady_clock::now();
+
+	// Determine the times in milliseconds
+	double singleTime = chrono::duration<double, milli>(singleEnd - singleStart).count() / repeats;
+	double packetTime = chrono::duration<double, milli>(packetEnd - packetStart).count() / repeats;
+
+	// Output the results
+	cout << sceneName << " scene, " << imageWidth << "x" << imageHeight << " camera rays, " << packetWidth << "-wide packets" << endl
+		<< "  Single rays: " << singleTime << " ms" << endl
+		<< "  Packets:     " << packetTime << " ms" << endl
+		<< "  Speedup:     " << singleTime / packetTime << "x" << endl;
+
+	// Check both passes found the same hits
+	if (singleHits != packetHits)
+	{
+		// Passes disagree
+		cout << "  Warning: single rays hit " << singleHits << " times, packets " << packetHits << " times" << endl;
+	}
+}
+
+/*
+ * CONVERGENCE BENCHMARK FUNCTION
+ *
+ * Function renders a high sample count reference, then renders the
+ * scene with each sampler at power of two sample counts up to the
+ * requested samples per pixel, and writes the RMSE against the
+ * reference to a CSV file for plotting. The RMSE after a 3x3 blur
+ * is written too, as it rewards error pushed to high frequencies,
+ * which the eye filters out. Returns false if the file
+ * cannot be written
+ */
+bool convergenceBenchmark(const camera& cam, const hittableList& scene, const bvh* hierarchy, const materialTable& table, const sceneLights& lights, const renderOptions& options)
+{
+	// Obtain the image dimensions
+	const int imageWidth = options.imageWidth;
+	const int imageHeight = options.getImageHeight();
+	const int pixelCount = imageWidth * imageHeight;
+
+	// Reference has this many times the largest sample count
+	const int referenceScale = 16;
+
+	// Renders averaged for each sampler and sample count, with different seeds
+	const int trials = 4;
+
+	// Samplers compared - independent is the uniform jitter used before
+	const char* samplerNames[] = { "independent", "cmj", "halton", "sobol", "bluenoise" };
+
+	// Determine the largest power of two sample count
+	int maxSamples = 1;
+	while (maxSamples * 2 <= options.samplesPerPixel)
+	{
+		maxSamples *= 2;
+	}
+
+	// Open the CSV file
+	string csvName = options.fileName + "_convergence.csv";
+	ofstream csv(csvName);
+	if (csv.is_open() == false)
+	{
+		// File could not be opened
+		cerr << "Could not write " << csvName << endl;
+		return false;
+	}
+
+	// Render the reference, with a seed none of the trials use
+	const int referenceSamples = maxSamples * referenceScale;
+	independentSampler referenceSampler(hashBits(options.seed) ^ 0x5a5a5a5au);
+	vector<colour> reference(pixelCount, colour(0.0f, 0.0f, 0.0f));
+	renderSpecialised(cam, scene, hierarchy, table, lights, referenceSampler, imageWidth, imageHeight, referenceSamples, options.maxDepth, options.usePackets, reference);
+	cout << "\rReference: " << referenceSamples << " samples per pixel" << endl;
+
+	// Write the header
+	csv << "samplesPerPixel,sampler,rmse,blurredRmse,seconds" << endl;
+
+	// Iterate over each sample count
+	for (int samples = 1; samples <= maxSamples; samples *= 2)
+	{
+		// Iterate over each sampler
+		for (const char* samplerName : samplerNames)
+		{
+			// Sum of the mean squared errors, unfiltered and blurred, and of the render times
+			double squaredErrorSum = 0.0;
+			double filteredSquaredErrorSum = 0.0;
+			double seconds = 0.0;
+
+			// Iterate over each trial
+			for (int trial = 0; trial < trials; trial++)
+			{
+				// Render the image
+				shared_ptr<sampler> samp = createSampler(samplerName, options.seed + trial, samples);
+				vector<colour> image(pixelCount, colour(0.0f, 0.0f, 0.0f));
+				auto renderStart = chrono::steady_clock::now();
+				renderSpecialised(cam, scene, hierarchy, table, lights, *samp, imageWidth, imageHeight, samples, options.maxDepth, options.usePackets, image);
+				seconds += chrono::duration<double>(chrono::steady_clock::now() - renderStart).count();
+
+				// Difference between the pixel means
+				vector<colour> difference(pixelCount);
+				for (int pixel = 0; pixel < pixelCount; pixel++)
+				{
+					difference[pixel] = image[pixel] / static_cast<float>(samples) - reference[pixel] / static_cast<float>(referenceSamples);
+				}
+
+				// Sum the squared error of every channel of every pixel, as is and after a 3x3 box blur
+				double squaredError = 0.0;
+				double filteredSquaredError = 0.0;
+				for (int y = 0; y < imageHeight; y++)
+				{
+					for (int x = 0; x < imageWidth; x++)
+					{
+						// Unfiltered error
+						const colour& error = difference[y * imageWidth + x];
+						squaredError += dot(error, error);
+
+						// Average the error over the neighbouring pixels inside the image
+						colour filtered(0.0f, 0.0f, 0.0f);
+						int neighbours = 0;
+						for (int ny = max(y - 1, 0); ny <= min(y + 1, imageHeight - 1); ny++)
+						{
+							for (int nx = max(x - 1, 0); nx <= min(x + 1, imageWidth - 1); nx++)
+							{
+								filtered += difference[ny * imageWidth + nx];
+								neighbours++;
+							}
+						}
+						filtered = filtered / static_cast<float>(neighbours);
+						filteredSquaredError += dot(filtered, filtered);
+					}
+				}
+				squaredErrorSum += squaredError / (3.0 * pixelCount);
+				filteredSquaredErrorSum += filteredSquaredError / (3.0 * pixelCount);
+			}
+
+			// Determine the root mean squared errors over the trials
+			double rmse = sqrt(squaredErrorSum / trials);
+			double filteredRmse = sqrt(filteredSquaredErrorSum / trials);
+
+			// Write the row, and output it to the console
+			csv << samples << ',' << samplerName << ',' << rmse << ',' << filteredRmse << ',' << seconds / trials << endl;
+			cout << "\r" << samples << " spp, " << samplerName << ": RMSE " << rmse << ", blurred " << filteredRmse << endl;
+		}
+	}
+
+	// Output the file written
+	cout << "Convergence written to " << csvName << endl;
+
+	// Return true
+	return true;
+}
+
+/*
+ * DISPLAYED RMSE FUNCTION
+ *
+ * Function returns the root mean squared error of every channel
+ * of every pixel of an image's pixel means against a reference's,
+ * after the gamma and clamp the image is written with - so lights
+ * seen directly, far brighter than white, do not swamp the error
+ */
+double displayedRmse(const vector<colour>& image, int samples, const vector<colour>& reference, int referenceSamples)
+{
+	// Sum the squared error
+	double squaredError = 0.0;
+	for (size_t pixel = 0; pixel < image.size(); pixel++)
+	{
+		// Examine each channel
+		for (int channel = 0; channel < 3; channel++)
+		{
+			// Displayed values of the image and reference
+			double value = fmin(1.0, sqrt(fmax(0.0, image[pixel][channel] / samples)));
+			double referenceValue = fmin(1.0, sqrt(fmax(0.0, reference[pixel][channel] / referenceSamples)));
+			squaredError += (value - referenceValue) * (value - referenceValue);
+		}
+	}
+
+	// Return the root of the mean
+	return sqrt(squaredError / (3.0 * image.size()));
+}
+
+/*
+ * LIGHT SAMPLING BENCHMARK FUNCTION
+ *
+ * Function compares picking lights uniformly against picking them
+ * with the light hierarchy. Each is rendered at the requested
+ * samples per pixel, then again with its sample count scaled so
+ * both take the time of the slower one, and the displayed RMSE
+ * against a high sample count reference is written to a CSV file.
+ * Returns false if the file cannot be written
+ */
+bool lightSamplingBenchmark(const camera& cam, const hittableList& scene, const bvh* hierarchy, const materialTable& table, const sceneLights& lights, const renderOptions& options)
+{
+	// Obtain the image dimensions
+	const int imageWidth = options.imageWidth;
+	const int imageHeight = options.getImageHeight();
+	const int pixelCount = imageWidth * imageHeight;
+
+	// Reference has this many times the requested sample count
+	const int referenceScale = 16;
+
+	// Light selections compared
+	const char* selectionNames[] = { "uniform", "bvh" };
+	const int selectionCount = 2;
+
+	// Open the CSV file
+	string csvName = options.fileName + "_lights.csv";
+	ofstream csv(csvName);
+	if (csv.is_open() == false)
+	{
+		// File could not be opened
+		cerr << "Could not write " << csvName << endl;
+		return false;
+	}
+
+	// Render the reference with the hierarchy, with a seed the comparisons do not use
+	sceneLights referenceLights = lights;
+	referenceLights.setUseHierarchy(true);
+	const int referenceSamples = options.samplesPerPixel * referenceScale;
+	independentSampler referenceSampler(hashBits(options.seed) ^ 0x5a5a5a5au);
+	vector<colour> reference(pixelCount, colour(0.0f, 0.0f, 0.0f));
+	renderSpecialised(cam, scene, hierarchy, table, referenceLights, referenceSampler, imageWidth, imageHeight, referenceSamples, options.maxDepth, options.usePackets, reference);
+	cout << "\rReference: " << referenceSamples << " samples per pixel" << endl;
+
+	// Write the header
+	csv << "lightSampler,samplesPerPixel,seconds,rmse" << endl;
+
+	// Time taken by each selection at the requested sample count
+	double seconds[selectionCount];
+
+	// Two passes - equal samples per pixel, then equal time
+	for (int pass = 0; pass < 2; pass++)
+	{
+		// Time of the slower selection, which both match in the second pass
+		double budget = pass == 0 ? 0.0 : max(seconds[0], seconds[1]);
+
+		// Iterate over each selection
+		for (int selection = 0; selection < selectionCount; selection++)
+		{
+			// Select the lights
+			sceneLights selectionLights = lights;
+			selectionLights.setUseHierarchy(selection == 1);
+
+			// Determine the sample count - scaled to the budget in the second pass
+			int samples = options.samplesPerPixel;
+			if (pass == 1)
+			{
+				samples = max(1, static_cast<int>(options.samplesPerPixel * budget / seconds[selection]));
+			}
+
+			// Render the image
+			shared_ptr<sampler> samp = createSampler(options.sampler, options.seed, samples);
+			vector<colour> image(pixelCount, colour(0.0f, 0.0f, 0.0f));
+			auto renderStart = chrono::steady_clock::now();
+			renderSpecialised(cam, scene, hierarchy, table, selectionLights, *samp, imageWidth, imageHeight, samples, options.maxDepth, options.usePackets, image);
+			double renderSeconds = chrono::duration<double>(chrono::steady_clock::now() - renderStart).count();
+
+			// Record the time of the first pass
+			if (pass == 0)
+			{
+				seconds[selection] = renderSeconds;
+			}
+
+			// Write the row, and output it to the console
+			double error = displayedRmse(image, samples, reference, referenceSamples);
+			csv << selectionNames[selection] << ',' << samples << ',' << renderSeconds << ',' << error << endl;
+			cout << "\r" << (pass == 0 ? "Equal samples, " : "Equal time, ") << selectionNames[selection] << ": " << samples << " spp in "
+				<< renderSeconds << " s, RMSE " << error << endl;
+		}
+	}
+
+	// Output the file written
+	cout << "Light sampling comparison written to " << csvName << endl;
+
+	// Return true
+	return true;
+}
+
+/*
+ * REFIT BENCHMARK FUNCTION
+ *
+ * Function animates 100,000 small spheres, each moving in a
+ * straight line and bouncing off the walls of a box, and keeps a
+ * BVH over them up to date every frame in three ways - rebuilding
+ * it, refitting it, and refitting it with a rebuild once its SAH
+ * cost grows past the rebuild threshold. The update time, SAH cost
+ * and time to trace a fixed set of rays are written to a CSV file
+ * for each frame, and the totals to the console. Rebuilds use the
+ * given preset and threads. Returns false if the file cannot be
+ * written
+ */
+bool refitBenchmark(const renderOptions& options, bvhPreset preset, int buildThreads)
+{
+	// Number of spheres, frames and rays traced each frame
+	const int sphereCount = 100000;
+	const int frameCount = 30;
+	const int rayCount = 20000;
+
+	// Half the width of the box the spheres move in, their radius, and the furthest they move in a frame
+	const float boxSize = 50.0f;
+	const float sphereRadius = 0.2f;
+	const float maxSpeed = 0.1f;
+
+	// Update strategies compared
+	const char* strategyNames[] = { "rebuild", "refit", "threshold" };
+
+	// Open the CSV file
+	string csvName = options.fileName + "_refit.csv";
+	ofstream csv(csvName);
+	if (csv.is_open() == false)
+	{
+		// File could not be opened
+		cerr << "Could not write " << csvName << endl;
+		return false;
+	}
+	csv << "strategy,frame,update ms,trace ms,sah cost,rebuilt" << endl;
+
+	// Random numbers from the seed, so every strategy sees the same scene and rays
+	mt19937 generator(options.seed);
+	uniform_real_distribution<float> inBox(-boxSize, boxSize);
+	uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	// Place the spheres, and give each a velocity
+	auto sphereMaterial = make_shared<lambertian>(colour(0.5, 0.5, 0.5));
+	vector<shared_ptr<hittable>> spheres;
+	vector<point3> startCentres;
+	vector<vec3> startVelocities;
+	for (int i = 0; i < sphereCount; i++)
+	{
+		startCentres.push_back(point3(inBox(generator), inBox(generator), inBox(generator)));
+		startVelocities.push_back(maxSpeed * vec3(unit(generator), unit(generator), unit(generator)));
+		spheres.push_back(make_shared<sphere>(startCentres.back(), sphereRadius, sphereMaterial));
+	}
+
+	// Rays from random points in the box, in random directions
+	vector<ray> rays;
+	for (int i = 0; i < rayCount; i++)
+	{
+		rays.push_back(ray(point3(inBox(generator), inBox(generator), inBox(generator)), vec3(unit(generator), unit(generator), unit(generator))));
+	}
+
+	// Hits found by the first strategy on each frame, compared against the others
+	vector<long> frameHits(frameCount, 0);
+
+	// Output the scene
+	cout << "Refit benchmark: " << sphereCount << " moving spheres, " << frameCount << " frames, " << rayCount << " rays per frame, rebuild threshold "
+		<< options.rebuildThreshold << endl;
+
+	// Run each strategy over the same animation
+	for (int strategy = 0; strategy < 3; strategy++)
+	{
+		// Put the spheres back at the start
+		vector<point3> centres = startCentres;
+		vector<vec3> velocities = startVelocities;
+		for (int i = 0; i < sphereCount; i++)
+		{
+			spheres[i]->setCentre(centres[i]);
+		}
+
+		// Build the first hierarchy
+		bvh hierarchy;
+		hierarchy.setBuildSettings(preset, buildThreads);
+		hierarchy.build(spheres);
+
+		// Totals over the animation
+		double updateTotal = 0.0, traceTotal = 0.0;
+		int rebuildCount = 0;
+
+		// Animate each frame
+		for (int frame = 0; frame < frameCount; frame++)
+		{
+			// Move each sphere, bouncing off the walls of the box
+			for (int i = 0; i < sphereCount; i++)
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					centres[i][axis] += velocities[i][axis];
+					if (fabs(centres[i][axis]) > boxSize)
+					{
+						velocities[i][axis] = -velocities[i][axis];
+					}
+				}
+				spheres[i]->setCentre(centres[i]);
+			}
+
+			// Update the hierarchy
+			bool rebuilt = false;
+			auto updateStart = chrono::steady_clock::now();
+			if (strategy == 0)
+			{
+				// Rebuild from scratch
+				hierarchy.build(spheres);
+				rebuilt = true;
+			}
+			else if (strategy == 1)
+			{
+				// Refit only
+				hierarchy.refit();
+			}
+			else
+			{
+				// Refit, rebuilding once the tree has degraded
+				rebuilt = hierarchy.update(options.rebuildThreshold);
+			}
+			double updateMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - updateStart).count();
+
+			// Trace the rays
+			long hits = 0;
+			auto traceStart = chrono::steady_clock::now();
+			for (const auto& r : rays)
+			{
+				hitRecord rec;
+				hits += hierarchy.hit(r, 0.001f, infinity, rec) ? 1 : 0;
+			}
+			double traceMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - traceStart).count();
+
+			// Check the hierarchy finds the same hits as the first strategy's
+			if (strategy == 0)
+			{
+				frameHits[frame] = hits;
+			}
+			else if (hits != frameHits[frame])
+			{
+				cout << "  Warning: " << strategyNames[strategy] << " hit " << hits << " times on frame " << frame << ", rebuild " << frameHits[frame] << " times" << endl;
+			}
+
+			// Write the row, and add to the totals
+			csv << strategyNames[strategy] << ',' << frame << ',' << updateMilliseconds << ',' << traceMilliseconds << ',' << hierarchy.getSahCost() << ',' << (rebuilt ? 1 : 0) << endl;
+			updateTotal += updateMilliseconds;
+			traceTotal += traceMilliseconds;
+			rebuildCount += rebuilt ? 1 : 0;
+		}
+
+		// Output the totals
+		cout << "  " << strategyNames[strategy] << ": update " << updateTotal << " ms, trace " << traceTotal << " ms, total " << updateTotal + traceTotal
+			<< " ms, final SAH cost " << hierarchy.getSahCost() << ", " << rebuildCount << " rebuilds" << endl;
+	}
+
+	// Output the file written
+	cout << "Refit comparison written to " << csvName << endl;
+
+	// Return true
+	return true;
+}
+
+/*
+ * BUILD BENCHMARK FUNCTION
+ *
+ * Function builds a BVH over 1,000,000 small spheres with each
+ * preset, on one thread and on the build threads, and writes the
+ * build time, node count, SAH cost and time to trace a fixed set
+ * of rays to the console
+ */
+void buildBenchmark(const renderOptions& options, int buildThreads)
+{
+	// Number of spheres, and rays traced through each hierarchy
+	const int sphereCount = 1000000;
+	const int rayCount = 100000;
+
+	// Half the width of the box the spheres are placed in, and their radius
+	const float boxSize = 100.0f;
+	const float sphereRadius = 0.2f;
+
+	// Random numbers from the seed
+	mt19937 generator(options.seed);
+	uniform_real_distribution<float> inBox(-boxSize, boxSize);
+	uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	// Place the spheres
+	auto sphereMaterial = make_shared<lambertian>(colour(0.5, 0.5, 0.5));
+	vector<shared_ptr<hittable>> spheres;
+	for (int i = 0; i < sphereCount; i++)
+	{
+		spheres.push_back(make_shared<sphere>(point3(inBox(generator), inBox(generator), inBox(generator)), sphereRadius, sphereMaterial));
+	}
+
+	// Rays from random points in the box, in random directions
+	vector<ray> rays;
+	for (int i = 0; i < rayCount; i++)
+	{
+		rays.push_back(ray(point3(inBox(generator), inBox(generator), inBox(generator)), vec3(unit(generator), unit(generator), unit(generator))));
+	}
+
+	// Output the scene
+	cout << "Build benchmark: " << sphereCount << " spheres, " << rayCount << " rays" << endl;
+
+	// Hits found by the first build, compared against the others
+	long firstHits = -1;
+
+	// Presets, and thread counts - one, then the build threads
+	const bvhPreset presets[] = { BVH_QUALITY, BVH_FAST };
+	vector<int> threadCounts(1, 1);
+	if (buildThreads > 1)
+	{
+		threadCounts.push_back(buildThreads);
+	}
+
+	// Build with each preset and thread count
+	for (bvhPreset preset : presets)
+	{
+		for (int threads : threadCounts)
+		{
+			// Build the hierarchy
+			bvh hierarchy;
+			hierarchy.setBuildSettings(preset, threads);
+			auto buildStart = chrono::steady_clock::now();
+			hierarchy.build(spheres);
+			double buildMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - buildStart).count();
+
+			// Trace the rays
+			long hits = 0;
+			auto traceStart = chrono::steady_clock::now();
+			for (const auto& r : rays)
+			{
+				hitRecord rec;
+				hits += hierarchy.hit(r, 0.001f, infinity, rec) ? 1 : 0;
+			}
+			double traceMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - traceStart).count();
+
+			// Output the results
+			cout << "  " << (preset == BVH_FAST ? "fast" : "quality") << ", " << threads << (threads == 1 ? " thread: " : " threads: ") << "build " << buildMilliseconds
+				<< " ms, " << hierarchy.getNodeCount() << " nodes, SAH cost " << hierarchy.getSahCost() << ", trace " << traceMilliseconds << " ms" << endl;
+
+			// Check every hierarchy finds the same hits
+			if (firstHits < 0)
+			{
+				firstHits = hits;
+			}
+			else if (hits != firstHits)
+			{
+				cout << "  Warning: " << hits << " hits, the first build found " << firstHits << endl;
+			}
+		}
+	}
+}
+
+/*
+ * RENDER FRAME FUNCTION
+ *
+ * Function renders the image with the integrator in the options,
+ * adding every sample to the frame buffer and the first hits to the
+ * AOV buffers if any are given. The description of the specialised
+ * kernel, if one is used, is written to kernel. Returns false,
+ * after printing the reason, if the integrator is not recognised
+ */
+bool renderFrame(const camera& cam, const hittableList& scene, const bvh* hierarchy, const materialTable& table, const materialTable* materials, const sceneLights& lights, sampler& samp, const renderOptions& options, vector<colour>& frameBuffer, aovBuffers* aovs, string& kernel)
+{
+	// World to render, either the list itself or the hierarchy
+	const hittable& world = hierarchy != nullptr ? static_cast<const hittable&>(*hierarchy) : scene;
+
+	// Check which integrator was requested
+	if (options.integrator == "kernel")
+	{
+		// Select the specialised kernel once, then render with it
+		kernel = renderSpecialised(cam, scene, hierarchy, table, lights, samp, options.imageWidth, options.getImageHeight(), options.samplesPerPixel, options.maxDepth, options.usePackets, frameBuffer, aovs);
+	}
+	else if (options.integrator == "wavefront")
+	{
+		// Render with the wavefront integrator
+		wavefrontIntegrator integrator(options.poolSize, options.sortRays);
+		integrator.render(cam, world, materials, lights, samp, options.imageWidth, options.getImageHeight(), options.samplesPerPixel, options.maxDepth, frameBuffer, aovs);
+	}
+	else if (options.integrator != "recursive")
+	{
+		// Unknown integrator
+		cerr << "Unknown integrator: " << options.integrator << endl;
+		return false;
+	}
+	// Check if camera rays are traced in packets
+	else if (options.usePackets)
+	{
+		// Render with packets of camera rays
+		renderImagePackets(cam, world, materials, lights, samp, options, frameBuffer, aovs);
+	}
+	else
+	{
+		// Render one ray at a time
+		renderImage(cam, world, materials, lights, samp, options, frameBuffer, aovs);
+	}
+
+	// Return true
+	return true;
+}
+
+/*
+ * WRITE FRAME FUNCTION
+ *
+ * Function writes one frame of an animation to a JPG file, on the
+ * encoding thread while the next frame renders. Sets failed if the
+ * file cannot be written
+ */
+void writeFrame(string jpgFile, vector<uint8_t> imgVector, int imageWidth, int imageHeight, bool& failed)
+{
+	// Create JPG file from the JPG Vector
+	if (stbi_write_jpg(jpgFile.c_str(), imageWidth, imageHeight, 3, imgVector.data(), 100) == 0)
+	{
+		// File could not be written
+		cerr << "Could not write " << jpgFile << endl;
+		failed = true;
+	}
+}
+
+/*
+ * RENDER ANIMATION FUNCTION
+ *
+ * Function renders the frames of a keyframe animation as numbered
+ * JPG files, <output>_0000.jpg onwards. The scene, materials and
+ * hierarchies stay resident between frames; each frame sets the
+ * camera, and the hierarchy and lights are only updated on frames
+ * where an object moves - the hierarchy is refitted, and rebuilt
+ * only once refits have degraded it past the rebuild threshold.
+ * Each frame is encoded on another thread while the next one
+ * renders, and the sampler is seeded with the frame number so the
+ * noise changes from frame to frame. Returns false, after printing
+ * the reason, if a frame cannot be rendered or written
+ */
+bool renderAnimation(const keyframeAnimation& animation, const cameraSettings& baseCamera, hittableList& scene, bvh* hierarchy, const materialTable& table, const materialTable* materials, sceneLights& lights, const renderOptions& options)
+{
+	// Obtain the image dimensions
+	const int imageWidth = options.imageWidth;
+	const int imageHeight = options.getImageHeight();
+	const int frameCount = options.frameCount > 0 ? options.frameCount : animation.getFrameCount();
+
+	// Centre each keyed object was last moved to
+	map<int, point3> placedCentres;
+
+	// Encoding thread of the previous frame, and whether any frame failed to be written
+	thread encoder;
+	bool encodeFailed = false;
+
+	// Time the animation
+	auto animationStart = chrono::steady_clock::now();
+	double renderSeconds = 0.0;
+	int updateCount = 0;
+	int rebuildCount = 0;
+
+	// Render each frame
+	for (int frame = 0; frame < frameCount; frame++)
+	{
+		// **** SCENE UPDATE **** //
+
+		// Move each keyed object which is not already in place
+		auto updateStart = chrono::steady_clock::now();
+		bool moved = false;
+		for (const auto& centre : animation.getObjectCentres(frame))
+		{
+			// Check the object exists and can be moved
+			if (centre.first >= static_cast<int>(scene.getObjects().size()))
+			{
+				cerr << "Keyframes move object " << centre.first << ", but the scene has " << scene.getObjects().size() << " objects" << endl;
+				return false;
+			}
+			auto placed = placedCentres.find(centre.first);
+			if (placed != placedCentres.end() && (placed->second - centre.second).lengthSquared() == 0.0f)
+			{
+				// Already in place
+				continue;
+			}
+			if (scene.getObjects()[centre.first]->setCentre(centre.second) == false)
+			{
+				cerr << "Object " << centre.first << " cannot be moved" << endl;
+				return false;
+			}
+			placedCentres[centre.first] = centre.second;
+			moved = true;
+		}
+
+		// Update what depends on the objects' positions, only if one moved
+		bool rebuilt = false;
+		if (moved)
+		{
+			// Refit the hierarchy, rebuilding it only once refits have degraded it, and regather the lights in case a light moved
+			if (hierarchy != nullptr)
+			{
+				rebuilt = hierarchy->update(options.rebuildThreshold);
+			}
+			lights.gather(scene);
+			updateCount++;
+			rebuildCount += rebuilt ? 1 : 0;
+		}
+		double updateMilliseconds = chrono::duration<double, milli>(chrono::steady_clock::now() - updateStart).count();
+
+		// **** RENDER FRAME **** //
+
+		// Camera of the frame
+		cameraSettings settings = animation.getCamera(frame, baseCamera);
+		camera cam(settings.lookFrom, settings.lookAt, settings.verticalUp, settings.verticalFoV, options.aspectRatio, settings.aperture, settings.distanceToFocus, 0.0f, options.shutter);
+
+		// Sampler seeded with the frame
+		shared_ptr<sampler> samp = createSampler(options.sampler, options.seed + static_cast<unsigned int>(frame), options.samplesPerPixel);
+
+		// Render the frame
+		vector<colour> frameBuffer(imageWidth * imageHeight, colour(0.0f, 0.0f, 0.0f));
+		shared_ptr<aovBuffers> aovs = options.denoise ? make_shared<aovBuffers>(imageWidth * imageHeight) : nullptr;
+		string kernel;
+		auto renderStart = chrono::steady_clock::now();
+		if (renderFrame(cam, scene, hierarchy, table, materials, lights, *samp, options, frameBuffer, aovs.get(), kernel) == false)
+		{
+			// Unknown integrator - wait for the frame being written
+			if (encoder.joinable())
+			{
+				encoder.join();
+			}
+			return false;
+		}
+
+		// Filter the frame, if requested
+		if (options.denoise)
+		{
+			denoise(frameBuffer, *aovs, imageWidth, imageHeight, options.samplesPerPixel);
+		}
+		double frameSeconds = chrono::duration<double>(chrono::steady_clock::now() - renderStart).count();
+		renderSeconds += frameSeconds;
+
+		// Tone map the frame
+		vector<uint8_t> imgVector;
+		for (const auto& pixelColour : frameBuffer)
+		{
+			writeColour(pixelColour, imgVector, options.samplesPerPixel);
+		}
+
+		// **** ENCODE FRAME **** //
+
+		// Wait for the previous frame to be written, then write this one while the next renders
+		if (encoder.joinable())
+		{
+			encoder.join();
+		}
+		char frameNumber[16];
+		snprintf(frameNumber, sizeof(frameNumber), "_%04d.jpg", frame);
+		encoder = thread(writeFrame, options.fileName + frameNumber, move(imgVector), imageWidth, imageHeight, ref(encodeFailed));
+
+		// Output frame statistics
+		cout << "\rFrame " << frame + 1 << "/" << frameCount << ": render " << frameSeconds << " s, scene update "
+			<< updateMilliseconds << " ms" << (rebuilt ? " (rebuilt)" : (moved ? " (refitted)" : "")) << endl;
+	}
+
+	// Wait for the last frame to be written
+	if (encoder.joinable())
+	{
+		encoder.join();
+	}
+
+	// Output animation statistics
+	cout << "Animation: " << frameCount << " frames in " << chrono::duration<double>(chrono::steady_clock::now() - animationStart).count()
+		<< " s, " << renderSeconds << " s rendering, " << updateCount << " scene updates, " << rebuildCount << " BVH rebuilds" << endl;
+
+	// Return true if every frame was written
+	return encodeFailed == false;
+}
+
+ /*
+  * MAIN FUNCTION
+  *
+  * The first function that is invoked when the application is loaded.
+  *
+  * Renders the selected scene, depending on the options given on
+  * the command line, and writes it to a JPG file.
+  */
+int main(int argc, char* argv[])
+{
+	// **** RENDER OPTIONS **** //
+
+	// Options, filled from the command line
+	renderOptions options;
+
+	// Parse the command line
+	if (parseOptions(argc, argv, options) == false)
+	{
+		// Invalid command line
+		return 1;
+	}
+
+	// **** IMAGE PROPERTIES **** //
+	
+	// Aspect ratio
+	const auto aspectRatio = options.aspectRatio;
+	
+	// Image width
+	const int imageWidth = options.imageWidth;
+
+	// Determine the image height, based on the image width and aspect ratio
+	const int imageHeight = options.getImageHeight();
+
+	// Samples Per Pixel
+	const int samplesPerPixel = options.samplesPerPixel;
+
+	// Output file name
+	string fileName = options.fileName;
+
+	// Image Vector
+	vector<uint8_t> imgVector;
+
+	// Clear the jpgVector
+	imgVector.clear();
+
+	// **** CAMERA SETTINGS **** //
+	
+	// Camera looking from
+	point3 lookFrom(13, 3, 2);
+
+	//point3 lookFrom(0, 1, -1);
+
+	// Camera look at
+	point3 lookAt(0, 0, 0);
+	//point3 lookAt(0, 1, 1);
+	
+	// Camera vertical up
+	vec3 verticalUp(0, 1, 0);
+
+	// Vertical Field of View
+	float verticalFoV = 20.0;
+
+	// Distance to focus
+	auto distanceToFocus = 10.0;
+
+	// Camera Aperture
+	float aperture = 0.25;
+
+	// Camera object
+	camera cam(lookFrom, lookAt, verticalUp, verticalFoV, aspectRatio, aperture, distanceToFocus, 0.0f, options.shutter);
+
+	// **** BVH BUILD SETTINGS **** //
+
+	// Check which build preset was requested
+	bvhPreset preset = BVH_QUALITY;
+	if (options.bvhPreset == "fast")
+	{
+		// Morton code build
+		preset = BVH_FAST;
+	}
+	else if (options.bvhPreset != "quality")
+	{
+		// Unknown preset
+		cerr << "Unknown BVH preset: " << options.bvhPreset << endl;
+		return 1;
+	}
+
+	// Threads used to build, one per core unless requested
+	const int buildThreads = options.buildThreads > 0 ? options.buildThreads : max(1, static_cast<int>(thread::hardware_concurrency()));
+
+	// **** BVH BENCHMARKS **** //
+
+	// Check if the build benchmark was requested
+	if (options.benchmarkBuild)
+	{
+		// Compare the presets and thread counts and exit
+		buildBenchmark(options, buildThreads);
+		return 0;
+	}
+
+	// Check if the refit benchmark was requested
+	if (options.benchmarkRefit)
+	{
+		// Compare ways of updating a hierarchy over moving spheres and exit
+		return refitBenchmark(options, preset, buildThreads) ? 0 : 1;
+	}
+
+	// **** PACKET BENCHMARK **** //
+
+	// Check if the packet benchmark was requested
+	if (options.benchmarkPackets)
+	{
+		// Benchmark both scenes and exit
+		packetBenchmark("Basic", basicScene(), cam, options);
+		packetBenchmark("Random", randomScene(options.sceneSeed), cam, options);
+		return 0;
+	}
+
+	// **** WORLD PROPERTIES **** //
+
+	// Scene hittable list
+	hittableList scene;
+
+	// Check which scene was requested
+	if (options.scene == "basic")
+	{
+		// Obtain hittable list from basicScene() function
+		scene = basicScene();
+	}
+	else if (options.scene == "random")
+	{
+		// Obtain hittable list from randomScene() function
+		scene = randomScene(options.sceneSeed);
+	}
+	else if (options.scene == "motion")
+	{
+		// Obtain hittable list from randomScene() function, with the diffuse spheres bouncing
+		scene = randomScene(options.sceneSeed, true);
+	}
+	else if (options.scene == "instances")
+	{
+		// Obtain hittable list from instancesScene() function, with the clusters built in the requested way
+		scene = instancesScene(preset, buildThreads);
+	}
+	else if (options.scene == "mesh")
+	{
+		// Obtain hittable list from meshScene() function, with the mesh built in the requested way
+		if (meshScene(options.meshFile, preset, buildThreads, scene) == false)
+		{
+			// Mesh could not be read
+			return 1;
+		}
+	}
+	else if (options.scene == "lights")
+	{
+		// Obtain hittable list from lightsScene() function
+		scene = lightsScene();
+	}
+	else if (options.scene == "manylights")
+	{
+		// Obtain hittable list from manyLightsScene() function
+		scene = manyLightsScene();
+	}
+	else
+	{
+		// Unknown scene
+		cerr << "Unknown scene: " << options.scene << endl;
+		return 1;
+	}
+
+	// Hierarchy over the scene
+	bvh sceneBvh;
+
+	// Hierarchy to render with, or null to render the list itself
+	const bvh* hierarchy = nullptr;
+
+	// Check which acceleration structure was requested
+	if (options.accelerator == "bvh")
+	{
+		// Build the hierarchy
+		auto buildStart = chrono::steady_clock::now();
+		sceneBvh.setBuildSettings(preset, buildThreads);
+		sceneBvh.build(scene.getObjects());
+		auto buildEnd = chrono::steady_clock::now();
+
+		// Output build statistics
+		cout << "BVH built: " << sceneBvh.getNodeCount() << " nodes over " << scene.getObjects().size() << " objects in "
+			<< chrono::duration<double, milli>(buildEnd - buildStart).count() << " ms (" << options.bvhPreset << " preset, " << buildThreads
+			<< (buildThreads == 1 ? " thread" : " threads") << ", SAH cost " << sceneBvh.getSahCost() << ")" << endl;
+
+		// Render the hierarchy
+		hierarchy = &sceneBvh;
+	}
+	else if (options.accelerator != "list")
+	{
+		// Unknown acceleration structure
+		cerr << "Unknown acceleration structure: " << options.accelerator << endl;
+		return 1;
+	}
+
+	// **** MATERIALS **** //
+
+	// Material table, holding the compact data block of every material
+	materialTable table;
+
+	// Add the scene's materials to the table
+	scene.bindMaterials(table);
+
+	// Number the scene's objects, so hits report which object was hit
+	scene.assignObjectIndices();
+
+	// Materials to shade with - the table, or null to use virtual scatter calls
+	const materialTable* materials = &table;
+
+	// Check which material dispatch was requested
+	if (options.materialDispatch == "virtual")
+	{
+		// Shade through virtual calls
+		materials = nullptr;
+	}
+	else if (options.materialDispatch != "table")
+	{
+		// Unknown material dispatch
+		cerr << "Unknown material dispatch: " << options.materialDispatch << endl;
+		return 1;
+	}
+
+	// **** LIGHTS **** //
+
+	// Lights of the scene - every emissive sphere, and the sky
+	sceneLights lights;
+	auto lightBuildStart = chrono::steady_clock::now();
+	lights.gather(scene);
+	auto lightBuildEnd = chrono::steady_clock::now();
+
+	// Output light statistics
+	cout << "Lights gathered: " << lights.getLightCount() << " lights, hierarchy of " << lights.getHierarchy().getNodeCount() << " nodes in "
+		<< chrono::duration<double, milli>(lightBuildEnd - lightBuildStart).count() << " ms" << endl;
+
+	// Check if the scene is lit at night
+	if (options.scene == "lights" || options.scene == "manylights")
+	{
+		// Dim the sky, so the sphere lights dominate
+		lights.setSkyIntensity(0.02f);
+	}
+
+	// Check if an environment map was requested
+	environmentMap environment;
+	if (options.environmentMap.empty() == false)
+	{
+		// Load the map, sampled as a light in place of the gradient sky
+		if (environment.load(options.environmentMap) == false)
+		{
+			// Map could not be loaded
+			return 1;
+		}
+		lights.setEnvironment(&environment);
+
+		// Output map statistics
+		cout << "Environment map loaded: " << environment.getWidth() << "x" << environment.getHeight() << " texels" << endl;
+	}
+
+	// Check which light selection was requested
+	if (options.lightSampler == "bvh" || options.lightSampler == "uniform")
+	{
+		// Pick lights with the hierarchy, or uniformly
+		lights.setUseHierarchy(options.lightSampler == "bvh");
+	}
+	else
+	{
+		// Unknown light selection
+		cerr << "Unknown light sampler: " << options.lightSampler << endl;
+		return 1;
+	}
+
+	// **** LIGHT SAMPLING BENCHMARK **** //
+
+	// Check if the light sampling benchmark was requested
+	if (options.benchmarkLights)
+	{
+		// Compare uniform and hierarchy light selection at equal time and exit
+		return lightSamplingBenchmark(cam, scene, options.accelerator == "bvh" ? &sceneBvh : nullptr, table, lights, options) ? 0 : 1;
+	}
+
+	// **** CONVERGENCE BENCHMARK **** //
+
+	// Check if the convergence benchmark was requested
+	if (options.benchmarkConvergence)
+	{
+		// Compare the samplers against a reference and exit
+		return convergenceBenchmark(cam, scene, options.accelerator == "bvh" ? &sceneBvh : nullptr, table, lights, options) ? 0 : 1;
+	}
+
+	// **** SAMPLER **** //
+
+	// Sampler for the pixel, lens and bounce random numbers
+	shared_ptr<sampler> samp = createSampler(options.sampler, options.seed, samplesPerPixel);
+
+	// Check the sampler was created
+	if (samp == nullptr)
+	{
+		// Unknown sampler
+		cerr << "Unknown sampler: " << options.sampler << endl;
+		return 1;
+	}
+
+	// Fingerprint of the scene and samples, which renders adding their samples together must share
+	string sceneName = options.scene == "mesh" && options.meshFile.empty() == false ? options.scene + ":" + options.meshFile : options.scene;
+	sceneFingerprint fingerprint = makeFingerprint(sceneName, options.sceneSeed, options.sampler, options.seed, samplesPerPixel);
+
+	// **** RENDER ANIMATION **** //
+
+	// Check if an animation was requested
+	if (options.animationFile.empty() == false)
+	{
+		// Read the keyframes
+		keyframeAnimation animation;
+		if (animation.load(options.animationFile) == false)
+		{
+			// Keyframes could not be read
+			return 1;
+		}
+
+		// Render every frame, starting from the camera above
+		cameraSettings baseCamera = { lookFrom, lookAt, verticalUp, verticalFoV, aperture, static_cast<float>(distanceToFocus) };
+		return renderAnimation(animation, baseCamera, scene, options.accelerator == "bvh" ? &sceneBvh : nullptr, table, materials, lights, options) ? 0 : 1;
+	}
+
+	// **** RENDER IMAGE **** //
+
+	// Frame buffer, holding the sum of the samples of each pixel
+	vector<colour> frameBuffer(imageWidth * imageHeight, colour(0.0f, 0.0f, 0.0f));
+
+	// AOV buffers, filled in the same pass if they are written or the denoiser needs them
+	shared_ptr<aovBuffers> aovs = options.denoise || options.writeAovs ? make_shared<aovBuffers>(imageWidth * imageHeight) : nullptr;
+
+	// Description of the specialised kernel, if one is used
+	string kernel;
+
+	// Check if this process is a worker of a distributed render
+	if (options.workerAddress.empty() == false)
+	{
+		// Render each job's range of samples, until the coordinator has no more
+		return runWorker(options.workerAddress, imageWidth, imageHeight, fingerprint, [&](int firstSample, int sampleCount, vector<colour>& jobBuffer, aovBuffers* jobAovs)
+		{
+			// Draw the range's samples from the sampler of the whole render
+			sampleRangeSampler rangeSampler(*samp, firstSample);
+			renderOptions jobOptions = options;
+			jobOptions.samplesPerPixel = sampleCount;
+			string jobKernel;
+			return renderFrame(cam, scene, hierarchy, table, materials, lights, rangeSampler, jobOptions, jobBuffer, jobAovs, jobKernel);
+		}) ? 0 : 1;
+	}
+
+	// Time the render
+	auto renderStart = chrono::steady_clock::now();
+
+	// Check if the render is distributed
+	if (options.workers > 0 || options.port > 0)
+	{
+		// Split the samples into about four jobs per worker, unless a job size was given
+		int jobSamples = options.jobSamples > 0 ? options.jobSamples : max(1, samplesPerPixel / (4 * max(options.workers, 1)));
+
+		// Render across worker processes, each started with this command line
+		if (runCoordinator(vector<string>(argv, argv + argc), options.workers, options.port, imageWidth, imageHeight, fingerprint, samplesPerPixel, jobSamples, frameBuffer, aovs.get()) == false)
+		{
+			// Render could not be finished
+			return 1;
+		}
+	}
+	else if (renderFrame(cam, scene, hierarchy, table, materials, lights, *samp, options, frameBuffer, aovs.get(), kernel) == false)
+	{
+		// Unknown integrator
+		return 1;
+	}
+
+	// End the line on the console window
+	cout << endl;
+
+	// Check if a specialised kernel was used
+	if (kernel.empty() == false)
+	{
+		// Output the kernel used
+		cout << "Kernel: " << kernel << endl;
+	}
+
+	// Output render time
+	cout << "Render time: " << chrono::duration<double>(chrono::steady_clock::now() - renderStart).count() << " s" << endl;
+
+	// **** WRITE AOVS **** //
+
+	// Check if the AOV files were requested
+	if (options.writeAovs)
+	{
+		// Write each AOV next to the image
+		if (!writeAovs(fileName, *aovs, imageWidth, imageHeight))
+		{
+			// Exit - the reason has been output
+			return 1;
+		}
+
+		// Output message to console indicating that the AOV files have been created
+		cout << "AOVs written to " << fileName << "_*.pfm" << endl;
+	}
+
+	// **** WRITE PARTIAL IMAGE **** //
+
+	// Check if the partial image was requested
+	if (options.writePartial)
+	{
+		// Write the sums before any denoising, so merged renders stay unbiased
+		if (partialImage(imageWidth, imageHeight, fingerprint, frameBuffer, samplesPerPixel).write(fileName + ".partial") == false)
+		{
+			// Exit - the reason has been output
+			return 1;
+		}
+
+		// Output message to console indicating that the partial image has been created
+		cout << "Partial image written to " << fileName << ".partial" << endl;
+	}
+
+	// **** DENOISE **** //
+
+	// Check if the denoiser was requested
+	if (options.denoise)
+	{
+		// Filter the frame buffer in place
+		auto denoiseStart = chrono::steady_clock::now();
+		denoise(frameBuffer, *aovs, imageWidth, imageHeight, samplesPerPixel);
+
+		// Output denoise time
+		cout << "Denoise time: " << chrono::duration<double>(chrono::steady_clock::now() - denoiseStart).count() << " s" << endl;
+	}
+
+	// Iterate over each pixel, from the top of the image
+	for (const auto& pixelColour : frameBuffer)
+	{
+		// Invoke the write colour function
+		writeColour(pixelColour, imgVector, samplesPerPixel);
+	}
 
 	// **** CREATE JPG FILE **** //
 
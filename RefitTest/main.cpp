@@ -0,0 +1,231 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * REFIT TEST
+ *
+ * Checks that refitting the BVH after objects move gives the same
+ * bounds and the same hits as building it again from scratch, with
+ * both presets, and that a hierarchy built from bounds is left as
+ * it is by refit and update. Run by ctest; exits with 1 if any
+ * check fails.
+ */
+
+// Header files
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Common Library header files
+#include "common/common.h"
+#include "common/aabb.h"
+#include "common/bvh.h"
+#include "common/material.h"
+#include "common/sphere.h"
+
+// Namespace
+using namespace std;
+
+// Number of spheres, frames they move for, and rays traced
+const int sphereCount = 5000;
+const int frameCount = 10;
+const int rayCount = 20000;
+
+// Half the width of the box the spheres start in, their radius, and the furthest they move in a frame
+const float boxSize = 20.0f;
+const float sphereRadius = 0.2f;
+const float maxSpeed = 0.5f;
+
+/*
+ * CHECK FUNCTION
+ *
+ * Function outputs the result of a check, and records a failure
+ */
+void check(bool passed, const string& description, bool& allPassed)
+{
+	// Output the result
+	cout << (passed ? "PASS " : "FAIL ") << description << endl;
+	allPassed = allPassed && passed;
+}
+
+/*
+ * SAME BOX FUNCTION
+ *
+ * Function determines if two boxes have exactly the same corners
+ */
+bool sameBox(const aabb& a, const aabb& b)
+{
+	// Compare each axis of both corners
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (a.getMin()[axis] != b.getMin()[axis] || a.getMax()[axis] != b.getMax()[axis])
+		{
+			// Corners differ
+			return false;
+		}
+	}
+
+	// Return true
+	return true;
+}
+
+/*
+ * COUNT DIFFERENT HITS FUNCTION
+ *
+ * Function traces each ray through two hierarchies, and returns
+ * the number of rays whose closest hit differs
+ */
+int countDifferentHits(const bvh& a, const bvh& b, const vector<ray>& rays)
+{
+	// Trace each ray through both
+	int different = 0;
+	for (const auto& r : rays)
+	{
+		hitRecord recA, recB;
+		bool hitA = a.hit(r, 0.001f, infinity, recA);
+		bool hitB = b.hit(r, 0.001f, infinity, recB);
+		if (hitA != hitB || (hitA && (recA.t != recB.t || recA.materialPointer != recB.materialPointer)))
+		{
+			// Missed by one, or a different closest hit
+			different++;
+		}
+	}
+
+	// Return the count
+	return different;
+}
+
+ /*
+  * MAIN FUNCTION
+  *
+  * The first function that is invoked when the application is loaded.
+  *
+  * Runs each check, returning 1 if any fails.
+  */
+int main()
+{
+	// Whether every check has passed
+	bool allPassed = true;
+
+	// Fixed random numbers
+	mt19937 generator(47);
+	uniform_real_distribution<float> inBox(-boxSize, boxSize);
+	uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+	// Rays from random points in the box, in random directions
+	vector<ray> rays;
+	for (int i = 0; i < rayCount; i++)
+	{
+		rays.push_back(ray(point3(inBox(generator), inBox(generator), inBox(generator)), vec3(unit(generator), unit(generator), unit(generator))));
+	}
+
+	// **** REFIT AGAINST REBUILD **** //
+
+	// Check each preset
+	const bvhPreset presets[] = { BVH_QUALITY, BVH_FAST };
+	const char* presetNames[] = { "quality", "fast" };
+	for (int p = 0; p < 2; p++)
+	{
+		// Place the spheres, each with its own material so hits can be told apart, and give each a velocity
+		vector<shared_ptr<hittable>> spheres;
+		vector<point3> centres;
+		vector<vec3> velocities;
+		for (int i = 0; i < sphereCount; i++)
+		{
+			centres.push_back(point3(inBox(generator), inBox(generator), inBox(generator)));
+			velocities.push_back(maxSpeed * vec3(unit(generator), unit(generator), unit(generator)));
+			spheres.push_back(make_shared<sphere>(centres.back(), sphereRadius, make_shared<lambertian>(colour(0.5, 0.5, 0.5))));
+		}
+
+		// Build the hierarchies to refit, and to update with a rebuild threshold
+		bvh refitted, updated;
+		refitted.setBuildSettings(presets[p], 1);
+		updated.setBuildSettings(presets[p], 1);
+		refitted.build(spheres);
+		updated.build(spheres);
+
+		// Move the spheres frame by frame, scattering them far from where the trees were built
+		int worstDifferences = 0;
+		bool boundsMatch = true;
+		int rebuildCount = 0;
+		for (int frame = 0; frame < frameCount; frame++)
+		{
+			// Move each sphere
+			for (int i = 0; i < sphereCount; i++)
+			{
+				centres[i] += velocities[i];
+				spheres[i]->setCentre(centres[i]);
+			}
+
+			// Refit and update, and build a fresh hierarchy over the moved spheres
+			refitted.refit();
+			rebuildCount += updated.update(1.5f) ? 1 : 0;
+			bvh rebuilt;
+			rebuilt.setBuildSettings(presets[p], 1);
+			rebuilt.build(spheres);
+
+			// Compare the root bounds
+			aabb refittedBox, updatedBox, rebuiltBox;
+			refitted.boundingBox(refittedBox);
+			updated.boundingBox(updatedBox);
+			rebuilt.boundingBox(rebuiltBox);
+			boundsMatch = boundsMatch && sameBox(refittedBox, rebuiltBox) && sameBox(updatedBox, rebuiltBox);
+
+			// Compare the hits
+			worstDifferences = max(worstDifferences, countDifferentHits(refitted, rebuilt, rays));
+			worstDifferences = max(worstDifferences, countDifferentHits(updated, rebuilt, rays));
+		}
+
+		// Output the results
+		string name = string(presetNames[p]) + " preset";
+		check(boundsMatch, name + ": refitted and updated root bounds match a rebuild on every frame", allPassed);
+		check(worstDifferences == 0, name + ": refitted and updated hits match a rebuild on every frame (" + to_string(worstDifferences) + " rays differ)", allPassed);
+		check(refitted.getSahCost() > refitted.getBuildSahCost(), name + ": refit kept the old tree, its SAH cost growing from " + to_string(refitted.getBuildSahCost())
+			+ " to " + to_string(refitted.getSahCost()), allPassed);
+		check(rebuildCount > 0, name + ": update rebuilt the degraded tree " + to_string(rebuildCount) + " times", allPassed);
+	}
+
+	// **** HIERARCHY BUILT FROM BOUNDS **** //
+
+	// Build over bounds alone, as a triangle mesh does
+	vector<aabb> bounds;
+	for (int i = 0; i < sphereCount; i++)
+	{
+		point3 centre(inBox(generator), inBox(generator), inBox(generator));
+		bounds.push_back(aabb(centre - vec3(sphereRadius, sphereRadius, sphereRadius), centre + vec3(sphereRadius, sphereRadius, sphereRadius)));
+	}
+	vector<int> order;
+	bvh fromBounds;
+	fromBounds.buildFromBounds(bounds, order);
+	aabb boxBefore, boxAfter;
+	fromBounds.boundingBox(boxBefore);
+	float costBefore = fromBounds.getSahCost();
+
+	// Refit and update, which have no objects to take new bounds from
+	fromBounds.refit();
+	bool rebuilt = fromBounds.update(1.5f);
+	fromBounds.boundingBox(boxAfter);
+	check(fromBounds.isBuiltFromBounds() && rebuilt == false && sameBox(boxBefore, boxAfter) && fromBounds.getSahCost() == costBefore,
+		"refit and update leave a hierarchy built from bounds unchanged", allPassed);
+
+	// Output the result
+	cout << (allPassed ? "All refit checks passed" : "Refit checks failed") << endl;
+
+	// Return 0 if every check passed
+	return allPassed ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * WATERTIGHT TEST
+ *
+ * Checks that rays cannot slip through a closed triangle mesh -
+ * rays from inside and outside are fired through points on every
+ * edge two triangles share, and through every vertex, where a test
+ * which is not watertight lets some pass between the triangles.
+ * Run by ctest; exits with 1 if any check fails.
+ */
+
+// Header files
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Common Library header files
+#include "common/common.h"
+#include "common/material.h"
+#include "common/triangleMesh.h"
+
+// Namespace
+using namespace std;
+
+// Times the faces of the octahedron are split in four
+const int subdivisions = 4;
+
+// Centre and radii of the closed mesh, stretched so no edge lies along an axis
+const point3 meshCentre(0.3f, -0.2f, 0.1f);
+const vec3 meshRadii(1.3f, 0.9f, 1.1f);
+
+// Points along each edge the rays are fired through
+const float edgeFractions[] = { 0.5f, 1.0f / 3.0f, 0.1f, 0.77f };
+
+/*
+ * CHECK FUNCTION
+ *
+ * Function outputs the result of a check, and records a failure
+ */
+void check(bool passed, const string& description, bool& allPassed)
+{
+	// Output the result
+	cout << (passed ? "PASS " : "FAIL ") << description << endl;
+	allPassed = allPassed && passed;
+}
+
+/*
+ * MIDPOINT FUNCTION
+ *
+ * Function returns the vertex halfway along an edge of the unit
+ * sphere, adding it the first time the edge is split
+ */
+int midpoint(int a, int b, vector<point3>& vertices, map<pair<int, int>, int>& midpoints)
+{
+	// Check if the edge has been split already
+	pair<int, int> edge(min(a, b), max(a, b));
+	auto found = midpoints.find(edge);
+	if (found != midpoints.end())
+	{
+		// Return the vertex already added
+		return found->second;
+	}
+
+	// Add the midpoint, pushed out onto the sphere
+	vertices.push_back(unitVector(vertices[a] + vertices[b]));
+	midpoints[edge] = static_cast<int>(vertices.size()) - 1;
+	return midpoints[edge];
+}
+
+ /*
+  * MAIN FUNCTION
+  *
+  * The first function that is invoked when the application is loaded.
+  *
+  * Runs each check, returning 1 if any fails.
+  */
+int main()
+{
+	// Whether every check has passed
+	bool allPassed = true;
+
+	// **** CLOSED MESH **** //
+
+	// Octahedron, wound to face outwards
+	vector<point3> vertices = { point3(1, 0, 0), point3(-1, 0, 0), point3(0, 1, 0), point3(0, -1, 0), point3(0, 0, 1), point3(0, 0, -1) };
+	vector<int> indices = { 0, 2, 4, 2, 1, 4, 1, 3, 4, 3, 0, 4, 2, 0, 5, 1, 2, 5, 3, 1, 5, 0, 3, 5 };
+
+	// Split each face in four, onto the sphere
+	for (int level = 0; level < subdivisions; level++)
+	{
+		map<pair<int, int>, int> midpoints;
+		vector<int> split;
+		for (size_t i = 0; i < indices.size(); i += 3)
+		{
+			int a = indices[i], b = indices[i + 1], c = indices[i + 2];
+			int ab = midpoint(a, b, vertices, midpoints);
+			int bc = midpoint(b, c, vertices, midpoints);
+			int ca = midpoint(c, a, vertices, midpoints);
+			int faces[12] = { a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca };
+			split.insert(split.end(), faces, faces + 12);
+		}
+		indices.swap(split);
+	}
+
+	// Stretch and move the sphere
+	for (auto& vertex : vertices)
+	{
+		vertex = meshCentre + vec3(meshRadii.getX() * vertex.getX(), meshRadii.getY() * vertex.getY(), meshRadii.getZ() * vertex.getZ());
+	}
+
+	// Find the edges, each of which must be shared by two triangles for the mesh to be closed
+	map<pair<int, int>, int> edges;
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		for (int corner = 0; corner < 3; corner++)
+		{
+			int a = indices[i + corner], b = indices[i + (corner + 1) % 3];
+			edges[make_pair(min(a, b), max(a, b))]++;
+		}
+	}
+	bool closed = true;
+	for (const auto& edge : edges)
+	{
+		closed = closed && edge.second == 2;
+	}
+	check(closed, "every one of the " + to_string(edges.size()) + " edges of the " + to_string(indices.size() / 3) + " triangle mesh is shared by two triangles", allPassed);
+
+	// Build the mesh, keeping the points the rays are fired through
+	vector<point3> edgePoints;
+	for (const auto& edge : edges)
+	{
+		for (float fraction : edgeFractions)
+		{
+			edgePoints.push_back(vertices[edge.first.first] + fraction * (vertices[edge.first.second] - vertices[edge.first.first]));
+		}
+	}
+	vector<point3> vertexPoints = vertices;
+	triangleMesh mesh(move(vertices), move(indices), vector<vec3>(), make_shared<lambertian>(colour(0.5, 0.5, 0.5)));
+
+	// **** RAYS THROUGH EDGES AND VERTICES **** //
+
+	// Points inside the mesh the rays start from
+	mt19937 generator(50);
+	uniform_real_distribution<float> unit(-0.5f, 0.5f);
+	vector<point3> insideOrigins = { meshCentre };
+	for (int i = 0; i < 3; i++)
+	{
+		insideOrigins.push_back(meshCentre + vec3(unit(generator), unit(generator), unit(generator)));
+	}
+
+	// Fire rays through each point, from inside and from outside beyond it
+	const vector<point3>* targetSets[] = { &edgePoints, &vertexPoints };
+	const char* targetNames[] = { "points on shared edges", "vertices" };
+	for (int s = 0; s < 2; s++)
+	{
+		int rayCount = 0, missedHits = 0, missedOcclusions = 0;
+		for (const auto& target : *targetSets[s])
+		{
+			// Each inside origin, and a point beyond the target jittered off the line from the centre
+			vector<point3> origins = insideOrigins;
+			origins.push_back(meshCentre + 4.0f * (target - meshCentre) + vec3(unit(generator), unit(generator), unit(generator)));
+			for (const auto& origin : origins)
+			{
+				// The ray reaches the target at t = 1, so must hit before t = 2
+				ray r(origin, target - origin);
+				hitRecord rec;
+				rayCount++;
+				missedHits += mesh.hit(r, 0.001f, 2.0f, rec) ? 0 : 1;
+				missedOcclusions += mesh.occluded(r, 0.001f, 2.0f) ? 0 : 1;
+			}
+		}
+		check(missedHits == 0, "every ray through " + string(targetNames[s]) + " hits the mesh (" + to_string(missedHits) + " of " + to_string(rayCount) + " missed)", allPassed);
+		check(missedOcclusions == 0, "every ray through " + string(targetNames[s]) + " is blocked by the mesh (" + to_string(missedOcclusions) + " of " + to_string(rayCount)
+			+ " passed)", allPassed);
+	}
+
+	// Output the result
+	cout << (allPassed ? "All watertight checks passed" : "Watertight checks failed") << endl;
+
+	// Return 0 if every check passed
+	return allPassed ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * AXIS-ALIGNED BOUNDING BOX HEADER FILE
+ *
+ * Header file containing the axis-aligned bounding box class used
+ * by the acceleration structures
+ */
+
+// Declare ifndef directive for AABB_H
+#ifndef AABB_H
+
+// Define AABB_H
+#define AABB_H
+
+// Header files
+#include "common.h"
+
+// Largest relative rounding error of the slab parameters, gamma(3) - three rounded operations of half an epsilon each
+const float slabRoundingError = 3.0f * 0.5f * std::numeric_limits<float>::epsilon() / (1.0f - 3.0f * 0.5f * std::numeric_limits<float>::epsilon());
+
+// Scale on each slab's exit parameter, so rounding never moves a point on a box's face outside it - a ray through
+// a vertex shared by several triangles would otherwise miss every box holding them, and slip through the mesh
+const float slabExitScale = 1.0f + 2.0f * slabRoundingError;
+
+/* ==================================================================
+ * AABB CLASS
+ *
+ * Class for an axis-aligned bounding box, described by a minimum
+ * and maximum corner
+ * ==================================================================
+ */
+class aabb
+{
+	// Public functions
+	public:
+		/*
+		 * DEFAULT AABB CONSTRUCTOR
+		 *
+		 * When invoked, creates an empty (inverted) bounding box,
+		 * which grows to fit the first point or box added to it
+		 */
+		aabb() :
+			_minimum(infinity, infinity, infinity), _maximum(-infinity, -infinity, -infinity) {}
+
+		/*
+		 * AABB CONSTRUCTOR
+		 *
+		 * When invoked, creates a bounding box from a minimum
+		 * and maximum corner
+		 */
+		aabb(const point3& a, const point3& b) :
+			_minimum(a), _maximum(b) {}
+
+		/*
+		 * GET MINIMUM FUNCTION
+		 *
+		 * Function returns the minimum corner of the box
+		 */
+		point3 getMin() const
+		{
+			// Return the minimum corner
+			return _minimum;
+		}
+
+		/*
+		 * GET MAXIMUM FUNCTION
+		 *
+		 * Function returns the maximum corner of the box
+		 */
+		point3 getMax() const
+		{
+			// Return the maximum corner
+			return _maximum;
+		}
+
+		/*
+		 * GET CENTROID FUNCTION
+		 *
+		 * Function returns the centre point of the box
+		 */
+		point3 getCentroid() const
+		{
+			// Return the mid point of the two corners
+			return 0.5f * (_minimum + _maximum);
+		}
+
+		/*
+		 * GROW FUNCTION
+		 *
+		 * Function expands the box to contain a point
+		 */
+		void grow(const point3& p)
+		{
+			// Expand each axis in turn
+			for (int axis = 0; axis < 3; axis++)
+			{
+				// Take the minimum and maximum against the point
+				_minimum[axis] = fmin(_minimum[axis], p[axis]);
+				_maximum[axis] = fmax(_maximum[axis], p[axis]);
+			}
+		}
+
+		/*
+		 * GROW FUNCTION
+		 *
+		 * Function expands the box to contain another box. An
+		 * empty box leaves it unchanged
+		 */
+		void grow(const aabb& box)
+		{
+			// Expand each axis in turn - corner by corner, as the corners of an empty box are inverted
+			for (int axis = 0; axis < 3; axis++)
+			{
+				// Take the minimum and maximum against the other box
+				_minimum[axis] = fmin(_minimum[axis], box._minimum[axis]);
+				_maximum[axis] = fmax(_maximum[axis], box._maximum[axis]);
+			}
+		}
+
+		/*
+		 * SURFACE AREA FUNCTION
+		 *
+		 * Function returns the surface area of the box. Used by
+		 * the surface area heuristic. Empty boxes return 0
+		 */
+		float surfaceArea() const
+		{
+			// Determine the extent of the box
+			vec3 extent = _maximum - _minimum;
+
+			// Check if the box is empty
+			if (extent.getX() < 0 || extent.getY() < 0 || extent.getZ() < 0)
+			{
+				// Empty box, has no area
+				return 0.0f;
+			}
+
+			// Determine and return the surface area
+			return 2.0f * (extent.getX() * extent.getY() + extent.getY() * extent.getZ() + extent.getZ() * extent.getX());
+		}
+
+		/*
+		 * HIT FUNCTION
+		 *
+		 * Function determines if a ray passes through the box
+		 * within tMin and tMax, using the slab method
+		 */
+		bool hit(const ray& r, float tMin, float tMax) const
+		{
+			// Obtain the inverse ray direction
+			vec3 invDirection(1.0f / r.getDirection().getX(), 1.0f / r.getDirection().getY(), 1.0f / r.getDirection().getZ());
+
+			// Test with the inverse direction
+			return hit(r.getOrigin(), invDirection, tMin, tMax);
+		}
+
+		/*
+		 * HIT FUNCTION
+		 *
+		 * Function determines if a ray, given by its origin and
+		 * precomputed inverse direction, passes through the box
+		 * within tMin and tMax. Avoids the divisions when the
+		 * same ray is tested against many boxes
+		 */
+		bool hit(const point3& origin, const vec3& invDirection, float tMin, float tMax) const
+		{
+			// Check each slab in turn
+			for (int axis = 0; axis < 3; axis++)
+			{
+				// Determine the ray parameters at the two planes of the slab
+				float t0 = (_minimum[axis] - origin[axis]) * invDirection[axis];
+				float t1 = (_maximum[axis] - origin[axis]) * invDirection[axis];
+
+				// Order the parameters, so t0 is the entry point
+				if (invDirection[axis] < 0.0f)
+				{
+					// Swap entry and exit
+					float temp = t0;
+					t0 = t1;
+					t1 = temp;
+				}
+
+				// Narrow the ray interval to the slab, widened by the rounding error
+				t1 *= slabExitScale;
+				tMin = t0 > tMin ? t0 : tMin;
+				tMax = t1 < tMax ? t1 : tMax;
+
+				// Check if the interval is empty
+				if (tMax < tMin)
+				{
+					// Ray misses the box
+					return false;
+				}
+			}
+
+			// Ray passes through the box
+			return true;
+		}
+
+	// Private variables
+	private:
+		// Minimum corner
+		point3 _minimum;
+
+		// Maximum corner
+		point3 _maximum;
+};
+
+/*
+ * SURROUNDING BOX FUNCTION
+ *
+ * Function returns the box which contains two boxes
+ */
+inline aabb surroundingBox(const aabb& box0, const aabb& box1)
+{
+	// Start from the first box
+	aabb box = box0;
+
+	// Grow to fit the second box
+	box.grow(box1);
+
+	// Return the surrounding box
+	return box;
+}
+
+// End ifndef directive for AABB_H
+#endif
@@ -0,0 +1,207 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * AOV HEADER FILE
+ *
+ * Header file containing the arbitrary output variable (AOV)
+ * buffers - per-pixel properties of the first surface seen by each
+ * camera ray, filled by the integrators in the same pass as the
+ * colour - and the function writing them to PFM files for
+ * compositing and debugging
+ */
+
+// Declare ifndef directive for AOV_H
+#ifndef AOV_H
+
+// Define AOV_H
+#define AOV_H
+
+// Header files
+#include "common.h"
+#include "hittable.h"
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * AOV BUFFERS STRUCT
+ *
+ * Struct holding the AOV buffers, ordered from the top row of the
+ * image down like the frame buffer. Like the frame buffer, the
+ * albedo and normal hold the sum over a pixel's samples. Depth and
+ * the indices cannot be averaged, so they come from the pixel's
+ * first sample
+ * ==================================================================
+ */
+struct aovBuffers
+{
+	// Albedo of the first hit
+	vector<colour> albedo;
+
+	// Normal of the first hit, facing the camera, or zero for a miss
+	vector<vec3> normal;
+
+	// Distance from the camera to the first hit, or infinity for a miss
+	vector<float> depth;
+
+	// Index of the first hit's material in the material table, or -1 for a miss
+	vector<int> materialIndex;
+
+	// Index of the first hit's object in the scene, or -1 for a miss
+	vector<int> objectIndex;
+
+	// Number of samples added to each pixel
+	vector<int> sampleCount;
+
+	/*
+	 * AOV BUFFERS CONSTRUCTOR
+	 *
+	 * When invoked, creates empty buffers for an image with the
+	 * given number of pixels
+	 */
+	aovBuffers(int pixelCount) :
+		albedo(pixelCount, colour(0.0f, 0.0f, 0.0f)), normal(pixelCount, vec3(0.0f, 0.0f, 0.0f)), depth(pixelCount, infinity),
+		materialIndex(pixelCount, -1), objectIndex(pixelCount, -1), sampleCount(pixelCount, 0) {}
+
+	/*
+	 * ADD HIT FUNCTION
+	 *
+	 * Function adds the first hit of one of a pixel's samples,
+	 * from camera ray r
+	 */
+	void addHit(int pixel, const ray& r, const hitRecord& rec, const colour& hitAlbedo)
+	{
+		// Add the hit's properties
+		albedo[pixel] += hitAlbedo;
+		normal[pixel] += rec.normal;
+
+		// Check if this is the pixel's first sample
+		if (sampleCount[pixel]++ == 0)
+		{
+			// Record the distance and indices - camera rays are not unit length
+			depth[pixel] = rec.t * r.getDirection().length();
+			materialIndex[pixel] = rec.materialIndex;
+			objectIndex[pixel] = rec.objectIndex;
+		}
+	}
+
+	/*
+	 * ADD MISS FUNCTION
+	 *
+	 * Function adds one of a pixel's samples which escaped the
+	 * scene. The sky is given a white albedo, so it passes through
+	 * the denoiser unchanged
+	 */
+	void addMiss(int pixel)
+	{
+		// White albedo, no normal, and the depth and indices keep their miss values
+		albedo[pixel] += colour(1.0f, 1.0f, 1.0f);
+		sampleCount[pixel]++;
+	}
+};
+
+/*
+ * WRITE PFM FUNCTION
+ *
+ * Function writes a floating point image with 1 or 3 channels to a
+ * portable float map file. Pixels are given from the top row down;
+ * PFM stores the bottom row first. Returns false, after printing
+ * the reason, if the file cannot be written
+ */
+inline bool writePfm(const string& fileName, int imageWidth, int imageHeight, int channels, const vector<float>& pixels)
+{
+	// Open the file
+	ofstream file(fileName, ios::binary);
+	if (!file)
+	{
+		// File could not be opened
+		cerr << "Could not open AOV file " << fileName << endl;
+		return false;
+	}
+
+	// Write the header - a negative scale marks little-endian data
+	uint16_t endianTest = 1;
+	bool littleEndian = *reinterpret_cast<uint8_t*>(&endianTest) == 1;
+	file << (channels == 3 ? "PF" : "Pf") << "\n" << imageWidth << " " << imageHeight << "\n" << (littleEndian ? "-1.0" : "1.0") << "\n";
+
+	// Write the rows, from the bottom of the image up
+	for (int j = imageHeight - 1; j >= 0; j--)
+	{
+		file.write(reinterpret_cast<const char*>(&pixels[static_cast<size_t>(j) * imageWidth * channels]), sizeof(float) * imageWidth * channels);
+	}
+
+	// Check the file was written
+	if (!file)
+	{
+		// Write failed
+		cerr << "Could not write AOV file " << fileName << endl;
+		return false;
+	}
+
+	// Return true
+	return true;
+}
+
+/*
+ * WRITE AOVS FUNCTION
+ *
+ * Function writes each AOV to its own PFM file, named after the
+ * output file - depth, normal, albedo, material and object. The
+ * albedo and normal are averaged over the pixel's samples, and the
+ * indices are written as floats. Returns false if any file cannot
+ * be written
+ */
+inline bool writeAovs(const string& fileName, const aovBuffers& aovs, int imageWidth, int imageHeight)
+{
+	// Number of pixels
+	const int pixelCount = imageWidth * imageHeight;
+
+	// Flattened channels of each AOV
+	vector<float> depth(pixelCount), normal(pixelCount * 3), albedo(pixelCount * 3), materialIndex(pixelCount), objectIndex(pixelCount);
+
+	// Fill the channels
+	for (int i = 0; i < pixelCount; i++)
+	{
+		// Scale from sums to means
+		float scale = aovs.sampleCount[i] > 0 ? 1.0f / aovs.sampleCount[i] : 0.0f;
+
+		// Copy each AOV
+		depth[i] = aovs.depth[i];
+		for (int c = 0; c < 3; c++)
+		{
+			normal[3 * i + c] = scale * aovs.normal[i][c];
+			albedo[3 * i + c] = scale * aovs.albedo[i][c];
+		}
+		materialIndex[i] = static_cast<float>(aovs.materialIndex[i]);
+		objectIndex[i] = static_cast<float>(aovs.objectIndex[i]);
+	}
+
+	// Write each file
+	return writePfm(fileName + "_depth.pfm", imageWidth, imageHeight, 1, depth)
+		&& writePfm(fileName + "_normal.pfm", imageWidth, imageHeight, 3, normal)
+		&& writePfm(fileName + "_albedo.pfm", imageWidth, imageHeight, 3, albedo)
+		&& writePfm(fileName + "_material.pfm", imageWidth, imageHeight, 1, materialIndex)
+		&& writePfm(fileName + "_object.pfm", imageWidth, imageHeight, 1, objectIndex);
+}
+
+// End ifndef directive for AOV_H
+#endif
@@ -0,0 +1,280 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * BLUE NOISE HEADER FILE
+ *
+ * Header file containing the blue noise mask class. The mask is a
+ * tileable square of values in [0, 1) where neighbouring pixels
+ * have very different values, so error spread by it over the image
+ * has no low frequency clumps
+ */
+
+// Declare ifndef directive for BLUE_NOISE_H
+#ifndef BLUE_NOISE_H
+
+// Define BLUE_NOISE_H
+#define BLUE_NOISE_H
+
+// Header files
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * BLUE NOISE MASK CLASS
+ *
+ * Class for a tileable blue noise mask, generated with Ulichney's
+ * void-and-cluster method. Every pixel is ranked by the order it is
+ * added to a binary pattern which is kept as evenly spread as
+ * possible, and the rank becomes the value
+ * ==================================================================
+ */
+class blueNoiseMask
+{
+	// Public functions
+	public:
+		/*
+		 * BLUE NOISE MASK CONSTRUCTOR
+		 *
+		 * When invoked, generates a size x size mask. The mask is
+		 * the same every time, as the starting pattern uses a
+		 * fixed seed
+		 */
+		blueNoiseMask(int size) : _size(size), _values(size * size)
+		{
+			// Generate the mask
+			generate();
+		}
+
+		/*
+		 * GET SIZE FUNCTION
+		 *
+		 * Function returns the width and height of the mask
+		 */
+		int getSize() const
+		{
+			// Return size
+			return _size;
+		}
+
+		/*
+		 * GET VALUE FUNCTION
+		 *
+		 * Function returns the value at (x, y), wrapping around
+		 * so the mask tiles. Coordinates must not be negative
+		 */
+		float getValue(int x, int y) const
+		{
+			// Return the wrapped value
+			return _values[(y % _size) * _size + (x % _size)];
+		}
+
+	// Private
+	private:
+		// Width and height of the mask
+		int _size;
+
+		// Values in [0, 1)
+		vector<float> _values;
+
+		// Binary pattern, and the energy of each pixel
+		vector<char> _pattern;
+		vector<float> _energy;
+
+		// Gaussian weight for each toroidal offset
+		vector<float> _weights;
+
+		/*
+		 * SET PIXEL FUNCTION
+		 *
+		 * Function sets or clears a pixel of the binary pattern,
+		 * updating the energy of every pixel
+		 */
+		void setPixel(int pixel, bool on)
+		{
+			// Set the pixel
+			_pattern[pixel] = on ? 1 : 0;
+
+			// Sign of the energy change
+			float sign = on ? 1.0f : -1.0f;
+
+			// Position of the pixel
+			int px = pixel % _size;
+			int py = pixel / _size;
+
+			// Update the energy of every pixel by its wrapped offset from this one
+			for (int y = 0; y < _size; y++)
+			{
+				// Wrapped row offset
+				int dy = (y - py + _size) % _size;
+
+				for (int x = 0; x < _size; x++)
+				{
+					// Wrapped column offset
+					int dx = (x - px + _size) % _size;
+					_energy[y * _size + x] += sign * _weights[dy * _size + dx];
+				}
+			}
+		}
+
+		/*
+		 * TIGHTEST CLUSTER FUNCTION
+		 *
+		 * Function returns the set pixel with the highest energy
+		 */
+		int tightestCluster() const
+		{
+			// Search the set pixels
+			int best = -1;
+			for (int i = 0; i < _size * _size; i++)
+			{
+				if (_pattern[i] && (best < 0 || _energy[i] > _energy[best])) best = i;
+			}
+
+			// Return the pixel
+			return best;
+		}
+
+		/*
+		 * LARGEST VOID FUNCTION
+		 *
+		 * Function returns the clear pixel with the lowest energy
+		 */
+		int largestVoid() const
+		{
+			// Search the clear pixels
+			int best = -1;
+			for (int i = 0; i < _size * _size; i++)
+			{
+				if (!_pattern[i] && (best < 0 || _energy[i] < _energy[best])) best = i;
+			}
+
+			// Return the pixel
+			return best;
+		}
+
+		/*
+		 * GENERATE FUNCTION
+		 *
+		 * Function generates the mask with void-and-cluster
+		 */
+		void generate()
+		{
+			// Number of pixels
+			const int pixelCount = _size * _size;
+
+			// Spread of the energy filter, as suggested by Ulichney
+			const float sigma = 1.5f;
+
+			// Build the filter weights for every wrapped offset
+			_weights.resize(pixelCount);
+			for (int dy = 0; dy < _size; dy++)
+			{
+				for (int dx = 0; dx < _size; dx++)
+				{
+					// Shortest distance around the torus
+					int wx = dx < _size - dx ? dx : _size - dx;
+					int wy = dy < _size - dy ? dy : _size - dy;
+					_weights[dy * _size + dx] = exp(-(wx * wx + wy * wy) / (2.0f * sigma * sigma));
+				}
+			}
+
+			// Start with an empty pattern
+			_pattern.assign(pixelCount, 0);
+			_energy.assign(pixelCount, 0.0f);
+
+			// Set a tenth of the pixels at random - fixed seed, so the mask never changes
+			mt19937 rng(0x5eed);
+			uniform_int_distribution<int> randomPixel(0, pixelCount - 1);
+			int onesCount = 0;
+			while (onesCount < pixelCount / 10)
+			{
+				int pixel = randomPixel(rng);
+				if (!_pattern[pixel])
+				{
+					setPixel(pixel, true);
+					onesCount++;
+				}
+			}
+
+			// Spread the starting pattern - move the tightest cluster into the largest void until stable
+			while (true)
+			{
+				// Remove the tightest cluster
+				int cluster = tightestCluster();
+				setPixel(cluster, false);
+
+				// Find the largest void
+				int hole = largestVoid();
+
+				// Check if the pixel would go back where it was
+				if (hole == cluster)
+				{
+					// Stable, restore the pixel and stop
+					setPixel(cluster, true);
+					break;
+				}
+
+				// Fill the void
+				setPixel(hole, true);
+			}
+
+			// Keep the starting pattern and energy for the second phase
+			vector<char> prototype = _pattern;
+			vector<float> prototypeEnergy = _energy;
+
+			// Rank of each pixel
+			vector<int> rank(pixelCount, 0);
+
+			// First phase - rank the starting pixels by removing the tightest cluster
+			for (int r = onesCount - 1; r >= 0; r--)
+			{
+				int cluster = tightestCluster();
+				setPixel(cluster, false);
+				rank[cluster] = r;
+			}
+
+			// Second phase - rank the remaining pixels by filling the largest void. Past half
+			// the pixels this is the same as Ulichney's third phase, removing the tightest
+			// cluster of clear pixels, as the energies of set and clear pixels sum to a constant
+			_pattern = prototype;
+			_energy = prototypeEnergy;
+			for (int r = onesCount; r < pixelCount; r++)
+			{
+				int hole = largestVoid();
+				setPixel(hole, true);
+				rank[hole] = r;
+			}
+
+			// Convert each rank to a value in [0, 1)
+			for (int i = 0; i < pixelCount; i++)
+			{
+				_values[i] = (rank[i] + 0.5f) / pixelCount;
+			}
+
+			// Release the working state
+			_pattern.clear();
+			_energy.clear();
+			_weights.clear();
+		}
+};
+
+// End ifndef directive for BLUE_NOISE_H
+#endif
@@ -0,0 +1,1475 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * BOUNDING VOLUME HIERARCHY HEADER FILE
+ *
+ * Header file containing the bounding volume hierarchy (BVH) class,
+ * which is an extension of the abstract hittable class.
+ *
+ * The hierarchy is built with the binned surface area heuristic
+ * (SAH), or from Morton codes for a fast build, across several
+ * threads, and stored as a flat array of nodes, so traversal walks a
+ * contiguous block of memory rather than chasing pointers. When
+ * objects move, the hierarchy can be refitted - its node bounds
+ * recomputed, keeping the tree - rather than rebuilt. It can also
+ * be built over bare bounds, such as a mesh's triangles, and walked
+ * with the owner's own test of the primitives in each leaf
+ */
+
+// Declare ifndef directive for BVH_H
+#ifndef BVH_H
+
+// Define BVH_H
+#define BVH_H
+
+// Headers
+#include "hittable.h"
+#include "hittableList.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Namespaces
+using namespace std;
+
+/* ==================================================================
+ * BVH PRESET ENUM
+ *
+ * How the hierarchy is built - quality splits with the binned SAH,
+ * fast sorts the objects along a Morton curve and splits where the
+ * codes change (an LBVH), trading some traversal speed for a much
+ * faster build
+ * ==================================================================
+ */
+enum bvhPreset
+{
+	BVH_QUALITY,
+	BVH_FAST
+};
+
+/* ==================================================================
+ * BVH NODE STRUCT
+ *
+ * Struct for a node of the flattened hierarchy. Interior nodes
+ * store the index of their left child, with the right child
+ * directly after it. Leaf nodes store the index of their first
+ * object and the number of objects
+ * ==================================================================
+ */
+struct bvhNode
+{
+	// Bounds of the node
+	aabb bounds;
+
+	// Left child index (interior) or first object index (leaf)
+	int leftFirst;
+
+	// Number of objects - 0 for interior nodes
+	int count;
+
+	// Split axis, used to order traversal of the children
+	int axis;
+};
+
+/* ==================================================================
+ * BVH CLASS
+ *
+ * Class for a bounding volume hierarchy over a list of hittable
+ * objects. Extension of the hittable abstract class.
+ * ==================================================================
+ */
+class bvh : public hittable
+{
+	// Public
+	public:
+		/*
+		 * DEFAULT BVH CONSTRUCTOR
+		 *
+		 * When invoked, creates an empty hierarchy
+		 */
+		bvh() {}
+
+		/*
+		 * BVH CONSTRUCTOR
+		 *
+		 * When invoked, builds a hierarchy over the objects
+		 * in a hittable list
+		 */
+		bvh(const hittableList& list)
+		{
+			// Build over the list's objects
+			build(list.getObjects());
+		}
+
+		/*
+		 * BUILD FUNCTION
+		 *
+		 * Function builds the hierarchy over a set of objects,
+		 * replacing any previous hierarchy
+		 */
+		void build(const vector<shared_ptr<hittable>>& objects);
+
+		/*
+		 * BUILD FROM BOUNDS FUNCTION
+		 *
+		 * Function builds the hierarchy over primitives known only
+		 * by their bounds, such as the triangles of a mesh, and
+		 * returns in order the primitive each leaf position
+		 * refers to. Such a hierarchy has no objects to hit or
+		 * refit, and is walked with the traverse function
+		 */
+		void buildFromBounds(const vector<aabb>& bounds, vector<int>& order);
+
+		/*
+		 * SET BUILD SETTINGS FUNCTION
+		 *
+		 * Function sets the preset and number of threads used by
+		 * later builds. A thread count below 1 uses one thread
+		 */
+		void setBuildSettings(bvhPreset preset, int threadCount);
+
+		/*
+		 * REFIT FUNCTION
+		 *
+		 * Function recomputes the bounds of every node from the
+		 * objects' current bounds, bottom up, keeping the tree. Used
+		 * when objects move but none are added or removed. A
+		 * hierarchy built from bounds is left as it is
+		 */
+		void refit();
+
+		/*
+		 * UPDATE FUNCTION
+		 *
+		 * Function refits the hierarchy after objects have moved,
+		 * then rebuilds it if the refitted tree's SAH cost has grown
+		 * past rebuildThreshold times its cost when built. Returns
+		 * true if the hierarchy was rebuilt. A hierarchy built from
+		 * bounds is left as it is
+		 */
+		bool update(float rebuildThreshold);
+
+		/*
+		 * GET SAH COST FUNCTION
+		 *
+		 * Function returns the SAH cost of the hierarchy - the
+		 * expected cost of tracing a ray through it, relative to
+		 * the area of the root
+		 */
+		float getSahCost() const;
+
+		/*
+		 * GET BUILD SAH COST FUNCTION
+		 *
+		 * Function returns the SAH cost of the hierarchy when it
+		 * was last built
+		 */
+		float getBuildSahCost() const
+		{
+			// Return the cost when built
+			return _buildCost;
+		}
+
+		/*
+		 * HIT FUNCTION
+		 *
+		 * Function determines the closest object hit by a ray
+		 */
+		virtual bool hit(const ray& r, float tMin, float tMax, hitRecord& rec) const override;
+
+		/*
+		 * OCCLUDED FUNCTION
+		 *
+		 * Function determines if any object blocks a ray,
+		 * stopping at the first one found
+		 */
+		virtual bool occluded(const ray& r, float tMin, float tMax) const override;
+
+		/*
+		 * BOUNDING BOX FUNCTION
+		 *
+		 * Function obtains the box which bounds the hierarchy
+		 */
+		virtual bool boundingBox(aabb& outputBox) const override;
+
+		/*
+		 * BIND MATERIALS FUNCTION
+		 *
+		 * Function binds the materials of every object
+		 */
+		virtual void bindMaterials(materialTable& table) override
+		{
+			// Examine each object
+			for (const auto& object : _objects)
+			{
+				// Bind the object's materials
+				object->bindMaterials(table);
+			}
+		}
+
+		/*
+		 * HIT PACKET FUNCTION
+		 *
+		 * Function traverses the hierarchy with a whole packet of
+		 * rays. A node is visited if any active lane hits it, so
+		 * coherent rays share the cost of each node test
+		 */
+		virtual void hitPacket(const rayPacket& packet, float tMin, float tMax[], hitRecord rec[], bool hits[]) const override;
+
+		/*
+		 * TRAVERSE FUNCTION
+		 *
+		 * Function walks the hierarchy with a ray, nearest child
+		 * first, calling leafHit(first, count, tMax) for each leaf
+		 * it reaches before tMax. leafHit returns true if it hit a
+		 * primitive, having lowered tMax to the hit. Stops at the
+		 * first leaf hit if stopAtFirstHit is true. Returns true
+		 * if any leaf was hit
+		 */
+		template <typename LeafHit>
+		bool traverse(const ray& r, float tMin, float& tMax, bool stopAtFirstHit, const LeafHit& leafHit) const;
+
+		/*
+		 * GET NODES FUNCTION
+		 *
+		 * Function returns the flattened nodes, root first
+		 */
+		const vector<bvhNode>& getNodes() const
+		{
+			// Return the node vector
+			return _nodes;
+		}
+
+		/*
+		 * IS BUILT FROM BOUNDS FUNCTION
+		 *
+		 * Function determines if the hierarchy was built from
+		 * bounds, rather than over objects
+		 */
+		bool isBuiltFromBounds() const
+		{
+			// Nodes with no objects behind them
+			return _nodes.empty() == false && _objects.empty();
+		}
+
+		/*
+		 * GET NODE COUNT FUNCTION
+		 *
+		 * Function returns the number of nodes in the hierarchy
+		 */
+		int getNodeCount() const
+		{
+			// Return the size of the node vector
+			return static_cast<int>(_nodes.size());
+		}
+
+	// Private
+	private:
+		// Flattened nodes, root at index 0
+		vector<bvhNode> _nodes;
+
+		// Objects, reordered so each leaf covers a contiguous range
+		vector<shared_ptr<hittable>> _objects;
+
+		// Bounds of each object
+		vector<aabb> _objectBounds;
+
+		// Original index of each object, permuted along with the bounds while building
+		vector<int> _order;
+
+		// SAH cost when last built
+		float _buildCost = 0.0f;
+
+		// Build preset, and number of threads used to build
+		bvhPreset _preset = BVH_QUALITY;
+		int _threadCount = 1;
+
+		// Morton code of each object's centroid, used while building with the fast preset
+		vector<uint32_t> _mortonCodes;
+
+		// Maximum number of objects in a leaf
+		static const int _maxLeafSize = 4;
+
+		// Number of bins used when evaluating the SAH
+		static const int _binCount = 12;
+
+		// Maximum depth of traversal stack
+		static const int _stackSize = 64;
+
+		// Cost of visiting a node, relative to testing an object, for the SAH cost of the hierarchy
+		static constexpr float _traversalCost = 1.0f;
+
+		// Smallest node whose objects are binned across threads
+		static const int _parallelBinSize = 1 << 15;
+
+		/* ==============================================================
+		 * BVH BINS STRUCT
+		 *
+		 * Struct for the SAH bins of a node along each axis. Each
+		 * thread fills its own, then they are merged
+		 * ==============================================================
+		 */
+		struct bvhBins
+		{
+			// Bounds of the objects in each bin
+			aabb bounds[3][_binCount];
+
+			// Number of objects in each bin
+			int count[3][_binCount];
+		};
+
+		/*
+		 * BUILD NODES FUNCTION
+		 *
+		 * Function builds the nodes over the object bounds,
+		 * permuting the bounds and order so each leaf covers a
+		 * contiguous range
+		 */
+		void buildNodes();
+
+		/*
+		 * SPLIT TOP FUNCTION
+		 *
+		 * Function splits the top levels of the tree on this
+		 * thread, binning large nodes in parallel, and records
+		 * the nodes at taskDepth as subtrees to build
+		 */
+		void splitTop(int nodeIndex, int depth, int taskDepth, int threadCount, vector<int>& tasks);
+
+		/*
+		 * BUILD SUBTREES FUNCTION
+		 *
+		 * Function subdivides the nodes recorded by split top,
+		 * sharing the subtrees between threadCount threads, then
+		 * splices the subtrees into the node array
+		 */
+		void buildSubtrees(const vector<int>& tasks, int depth, int threadCount);
+
+		/*
+		 * SUBDIVIDE FUNCTION
+		 *
+		 * Function splits a node of a node array in two, then
+		 * subdivides the children
+		 */
+		void subdivide(vector<bvhNode>& nodes, int nodeIndex, int depth);
+
+		/*
+		 * SPLIT NODE FUNCTION
+		 *
+		 * Function splits a node of a node array in two, with the
+		 * SAH or at a Morton code bit depending on the preset,
+		 * adding its children to the end of the array. Returns
+		 * false if the node is left as a leaf
+		 */
+		bool splitNode(vector<bvhNode>& nodes, int nodeIndex, int depth, int threadCount);
+
+		/*
+		 * FIND BEST SPLIT FUNCTION
+		 *
+		 * Function bins the centroids of a node's objects and
+		 * returns the cheapest split axis and position under
+		 * the SAH, along with its cost
+		 */
+		float findBestSplit(const bvhNode& node, int& bestAxis, float& bestPosition, int threadCount) const;
+
+		/*
+		 * FIND MORTON SPLIT FUNCTION
+		 *
+		 * Function returns the number of a node's objects, sorted
+		 * by Morton code, which go to its left child, and the axis
+		 * of the split
+		 */
+		int findMortonSplit(const bvhNode& node, int& axis) const;
+
+		/*
+		 * SORT BY MORTON CODE FUNCTION
+		 *
+		 * Function orders the objects along a Morton curve through
+		 * their centroids, so every node covers a contiguous run
+		 * of codes
+		 */
+		void sortByMortonCode(const aabb& centroidBounds);
+
+		/*
+		 * REFIT NODES FUNCTION
+		 *
+		 * Function recomputes the bounds of every node from the
+		 * object bounds, bottom up
+		 */
+		void refitNodes();
+
+		/*
+		 * RUN IN CHUNKS FUNCTION
+		 *
+		 * Function splits the range [first, first + count) into
+		 * chunkCount chunks and calls work(chunk, begin, end) for
+		 * each, on its own thread - the first on this thread
+		 */
+		template <typename Work>
+		static void runInChunks(int first, int count, int chunkCount, const Work& work)
+		{
+			// Start a thread for each chunk after the first
+			vector<thread> threads;
+			for (int chunk = 1; chunk < chunkCount; chunk++)
+			{
+				int begin = first + static_cast<int>(static_cast<long long>(count) * chunk / chunkCount);
+				int end = first + static_cast<int>(static_cast<long long>(count) * (chunk + 1) / chunkCount);
+				threads.push_back(thread(work, chunk, begin, end));
+			}
+
+			// Work on the first chunk here, then wait for the rest
+			work(0, first, first + static_cast<int>(static_cast<long long>(count) / chunkCount));
+			for (auto& t : threads)
+			{
+				t.join();
+			}
+		}
+};
+
+/*
+ * BUILD FUNCTION
+ *
+ * Function builds the hierarchy over a set of objects,
+ * replacing any previous hierarchy
+ */
+void bvh::build(const vector<shared_ptr<hittable>>& objects)
+{
+	// Clear the previous hierarchy
+	_nodes.clear();
+	_objects.clear();
+	_objectBounds.clear();
+	_buildCost = 0.0f;
+
+	// Examine each object
+	for (const auto& object : objects)
+	{
+		// Temporary box
+		aabb box;
+
+		// Check if the object can be bounded
+		if (object->boundingBox(box) == false)
+		{
+			// Object cannot be placed in the hierarchy
+			cerr << "No bounding box in bvh constructor." << endl;
+			continue;
+		}
+
+		// Add object and its bounds
+		_objects.push_back(object);
+		_objectBounds.push_back(box);
+	}
+
+	// Build the nodes
+	buildNodes();
+
+	// Reorder the objects to follow the leaves
+	vector<shared_ptr<hittable>> objectsInOrder(_objects.size());
+	for (size_t i = 0; i < _order.size(); i++)
+	{
+		objectsInOrder[i] = move(_objects[_order[i]]);
+	}
+	_objects.swap(objectsInOrder);
+	vector<int>().swap(_order);
+}
+
+/*
+ * BUILD FROM BOUNDS FUNCTION
+ *
+ * Function builds the hierarchy over primitives known only
+ * by their bounds, such as the triangles of a mesh, and
+ * returns in order the primitive each leaf position
+ * refers to. Such a hierarchy has no objects to hit or
+ * refit, and is walked with the traverse function
+ */
+void bvh::buildFromBounds(const vector<aabb>& bounds, vector<int>& order)
+{
+	// Clear the previous hierarchy
+	_nodes.clear();
+	_objects.clear();
+	_objectBounds = bounds;
+	_buildCost = 0.0f;
+
+	// Build the nodes
+	buildNodes();
+
+	// Return the order, and release the bounds - there is nothing to refit from
+	order.swap(_order);
+	vector<int>().swap(_order);
+	vector<aabb>().swap(_objectBounds);
+}
+
+/*
+ * BUILD NODES FUNCTION
+ *
+ * Function builds the nodes over the object bounds,
+ * permuting the bounds and order so each leaf covers a
+ * contiguous range
+ */
+void bvh::buildNodes()
+{
+	// Start with every object in its original place
+	const int objectCount = static_cast<int>(_objectBounds.size());
+	_order.resize(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		_order[i] = i;
+	}
+
+	// Check if there is anything to build
+	if (objectCount == 0)
+	{
+		// Empty hierarchy
+		return;
+	}
+
+	// Reserve the worst case number of nodes
+	_nodes.reserve(2 * objectCount);
+
+	// Create the root node, covering every object
+	bvhNode root;
+	root.leftFirst = 0;
+	root.count = objectCount;
+	root.axis = 0;
+
+	// Determine the root bounds, and the bounds of the centroids
+	aabb centroidBounds;
+	for (const auto& box : _objectBounds)
+	{
+		// Grow the root to fit the object
+		root.bounds.grow(box);
+		centroidBounds.grow(box.getCentroid());
+	}
+
+	// Add the root node
+	_nodes.push_back(root);
+
+	// Check if the fast preset was requested
+	if (_preset == BVH_FAST)
+	{
+		// Sort the objects along a Morton curve
+		sortByMortonCode(centroidBounds);
+	}
+
+	// Small hierarchies are built on this thread, as starting threads would cost more than they save
+	int threadCount = objectCount >= _parallelBinSize ? _threadCount : 1;
+
+	// Split the top of the tree until there are a few subtrees for each thread - none with one thread
+	int taskDepth = 0;
+	while (threadCount > 1 && (1 << taskDepth) < 4 * threadCount)
+	{
+		taskDepth++;
+	}
+	vector<int> tasks;
+	splitTop(0, 0, taskDepth, threadCount, tasks);
+
+	// Build the subtrees
+	buildSubtrees(tasks, taskDepth, threadCount);
+
+	// Morton splits ignore the bounds, so the fast preset bounds every node once the tree is built
+	if (_preset == BVH_FAST)
+	{
+		refitNodes();
+		vector<uint32_t>().swap(_mortonCodes);
+	}
+
+	// Record the cost of the new hierarchy
+	_buildCost = getSahCost();
+}
+
+/*
+ * SET BUILD SETTINGS FUNCTION
+ *
+ * Function sets the preset and number of threads used by
+ * later builds. A thread count below 1 uses one thread
+ */
+void bvh::setBuildSettings(bvhPreset preset, int threadCount)
+{
+	// Record the settings
+	_preset = preset;
+	_threadCount = max(1, threadCount);
+}
+
+/*
+ * REFIT FUNCTION
+ *
+ * Function recomputes the bounds of every node from the
+ * objects' current bounds, bottom up, keeping the tree. Used
+ * when objects move but none are added or removed. A
+ * hierarchy built from bounds is left as it is
+ */
+void bvh::refit()
+{
+	// Check if the hierarchy was built from bounds - they were released after the build, and its primitives cannot move
+	if (isBuiltFromBounds())
+	{
+		// Nodes still bound the primitives
+		return;
+	}
+
+	// Obtain the current bounds of each object
+	for (size_t i = 0; i < _objects.size(); i++)
+	{
+		// Keep the old bounds if the object can no longer be bounded
+		_objects[i]->boundingBox(_objectBounds[i]);
+	}
+
+	// Bound the nodes
+	refitNodes();
+}
+
+/*
+ * REFIT NODES FUNCTION
+ *
+ * Function recomputes the bounds of every node from the
+ * object bounds, bottom up
+ */
+void bvh::refitNodes()
+{
+	// Children are always stored after their parent, so a reverse sweep visits them first
+	for (int nodeIndex = static_cast<int>(_nodes.size()) - 1; nodeIndex >= 0; nodeIndex--)
+	{
+		// Obtain the node
+		bvhNode& node = _nodes[nodeIndex];
+		aabb bounds;
+
+		// Check if the node is a leaf
+		if (node.count > 0)
+		{
+			// Grow to fit each object in the leaf
+			for (int i = node.leftFirst; i < node.leftFirst + node.count; i++)
+			{
+				bounds.grow(_objectBounds[i]);
+			}
+		}
+		else
+		{
+			// Grow to fit both children
+			bounds.grow(_nodes[node.leftFirst].bounds);
+			bounds.grow(_nodes[node.leftFirst + 1].bounds);
+		}
+
+		// Store the new bounds
+		node.bounds = bounds;
+	}
+}
+
+/*
+ * UPDATE FUNCTION
+ *
+ * Function refits the hierarchy after objects have moved,
+ * then rebuilds it if the refitted tree's SAH cost has grown
+ * past rebuildThreshold times its cost when built. Returns
+ * true if the hierarchy was rebuilt. A hierarchy built from
+ * bounds is left as it is
+ */
+bool bvh::update(float rebuildThreshold)
+{
+	// Check if the hierarchy was built from bounds - it has no objects to rebuild over
+	if (isBuiltFromBounds())
+	{
+		// Nothing has moved
+		return false;
+	}
+
+	// Refit the tree - linear in the number of nodes
+	refit();
+
+	// Check if the tree has degraded too far - moving objects stretch the nodes they share
+	if (getSahCost() <= rebuildThreshold * _buildCost)
+	{
+		// Refitted tree is good enough
+		return false;
+	}
+
+	// Rebuild over the same objects - copied, as build clears the object vector
+	vector<shared_ptr<hittable>> objects = _objects;
+	build(objects);
+	return true;
+}
+
+/*
+ * GET SAH COST FUNCTION
+ *
+ * Function returns the SAH cost of the hierarchy - the
+ * expected cost of tracing a ray through it, relative to
+ * the area of the root
+ */
+float bvh::getSahCost() const
+{
+	// Check if the hierarchy is empty, or has no area to compare against
+	if (_nodes.empty() || _nodes[0].bounds.surfaceArea() <= 0.0f)
+	{
+		// No cost
+		return 0.0f;
+	}
+
+	// Sum the area of each node, weighted by the cost of what is done on reaching it
+	float cost = 0.0f;
+	for (const auto& node : _nodes)
+	{
+		// Leaves test their objects, interior nodes their children
+		cost += node.bounds.surfaceArea() * (node.count > 0 ? node.count : _traversalCost);
+	}
+
+	// Return the cost relative to the root, the chance of reaching each node
+	return cost / _nodes[0].bounds.surfaceArea();
+}
+
+/*
+ * SPLIT TOP FUNCTION
+ *
+ * Function splits the top levels of the tree on this
+ * thread, binning large nodes in parallel, and records
+ * the nodes at taskDepth as subtrees to build
+ */
+void bvh::splitTop(int nodeIndex, int depth, int taskDepth, int threadCount, vector<int>& tasks)
+{
+	// Check if the node is deep enough to be a subtree of its own
+	if (depth == taskDepth)
+	{
+		// Build the node's subtree later
+		tasks.push_back(nodeIndex);
+		return;
+	}
+
+	// Split the node, binning with every thread, then split its children
+	if (splitNode(_nodes, nodeIndex, depth, threadCount))
+	{
+		int leftChildIndex = _nodes[nodeIndex].leftFirst;
+		splitTop(leftChildIndex, depth + 1, taskDepth, threadCount, tasks);
+		splitTop(leftChildIndex + 1, depth + 1, taskDepth, threadCount, tasks);
+	}
+}
+
+/*
+ * BUILD SUBTREES FUNCTION
+ *
+ * Function subdivides the nodes recorded by split top,
+ * sharing the subtrees between threadCount threads, then
+ * splices the subtrees into the node array
+ */
+void bvh::buildSubtrees(const vector<int>& tasks, int depth, int threadCount)
+{
+	// Check if there is only one thread
+	if (threadCount == 1)
+	{
+		// Subdivide each node in place
+		for (int task : tasks)
+		{
+			subdivide(_nodes, task, depth);
+		}
+		return;
+	}
+
+	// Each subtree is built into its own node array, rooted at a copy of its node
+	vector<vector<bvhNode>> subtrees(tasks.size());
+	atomic<int> nextTask(0);
+	runInChunks(0, threadCount, threadCount, [&](int, int, int)
+	{
+		// Take subtrees until none are left - object ranges of different subtrees never overlap
+		for (int task = nextTask++; task < static_cast<int>(tasks.size()); task = nextTask++)
+		{
+			subtrees[task].push_back(_nodes[tasks[task]]);
+			subdivide(subtrees[task], 0, depth);
+		}
+	});
+
+	// Splice each subtree into the node array, in task order so the layout does not depend on timing
+	for (size_t task = 0; task < tasks.size(); task++)
+	{
+		// Subtree nodes after the root go to the end of the array
+		const vector<bvhNode>& subtree = subtrees[task];
+		int offset = static_cast<int>(_nodes.size()) - 1;
+		for (size_t k = 0; k < subtree.size(); k++)
+		{
+			// Move child indices along with the nodes
+			bvhNode node = subtree[k];
+			if (node.count == 0)
+			{
+				node.leftFirst += offset;
+			}
+
+			// The root replaces the node the subtree was built from
+			if (k == 0)
+			{
+				_nodes[tasks[task]] = node;
+			}
+			else
+			{
+				_nodes.push_back(node);
+			}
+		}
+	}
+}
+
+/*
+ * SUBDIVIDE FUNCTION
+ *
+ * Function splits a node of a node array in two, then
+ * subdivides the children
+ */
+void bvh::subdivide(vector<bvhNode>& nodes, int nodeIndex, int depth)
+{
+	// Split the node on this thread
+	if (splitNode(nodes, nodeIndex, depth, 1))
+	{
+		// Subdivide the children
+		int leftChildIndex = nodes[nodeIndex].leftFirst;
+		subdivide(nodes, leftChildIndex, depth + 1);
+		subdivide(nodes, leftChildIndex + 1, depth + 1);
+	}
+}
+
+/*
+ * SPLIT NODE FUNCTION
+ *
+ * Function splits a node of a node array in two, with the
+ * SAH or at a Morton code bit depending on the preset,
+ * adding its children to the end of the array. Returns
+ * false if the node is left as a leaf
+ */
+bool bvh::splitNode(vector<bvhNode>& nodes, int nodeIndex, int depth, int threadCount)
+{
+	// Copy of the node - the vector may grow below
+	bvhNode node = nodes[nodeIndex];
+
+	// Check if the node is small enough for a leaf, or too deep to traverse
+	if (node.count <= _maxLeafSize || depth >= _stackSize - 2)
+	{
+		// Leave node as a leaf
+		return false;
+	}
+
+	// Split axis, and number of objects on the left
+	int axis = 0;
+	int leftCount = 0;
+
+	// Check which preset is used
+	if (_preset == BVH_FAST)
+	{
+		// Split where the Morton codes change - the objects are already in order
+		leftCount = findMortonSplit(node, axis);
+	}
+	else
+	{
+		// Find the best split
+		float splitPosition = 0.0f;
+		float splitCost = findBestSplit(node, axis, splitPosition, threadCount);
+
+		// Check if splitting is cheaper than leaving the node as a leaf
+		if (splitCost >= node.count * node.bounds.surfaceArea())
+		{
+			// Leaf is cheaper
+			return false;
+		}
+
+		// Partition the objects about the split position
+		int i = node.leftFirst;
+		int j = node.leftFirst + node.count - 1;
+		while (i <= j)
+		{
+			// Check which side of the plane the object's centroid lies
+			if (_objectBounds[i].getCentroid()[axis] < splitPosition)
+			{
+				// Left side, move on
+				i++;
+			}
+			else
+			{
+				// Right side, swap to the end
+				swap(_order[i], _order[j]);
+				swap(_objectBounds[i], _objectBounds[j]);
+				j--;
+			}
+		}
+
+		// Determine the number of objects on the left
+		leftCount = i - node.leftFirst;
+	}
+
+	// Check if the split put everything on one side
+	if (leftCount == 0 || leftCount == node.count)
+	{
+		// Cannot split, leave as a leaf
+		return false;
+	}
+
+	// Create the two children
+	int leftChildIndex = static_cast<int>(nodes.size());
+	bvhNode leftChild;
+	leftChild.leftFirst = node.leftFirst;
+	leftChild.count = leftCount;
+	leftChild.axis = 0;
+	bvhNode rightChild;
+	rightChild.leftFirst = node.leftFirst + leftCount;
+	rightChild.count = node.count - leftCount;
+	rightChild.axis = 0;
+
+	// Determine the bounds of the children - the fast preset bounds every node once the tree is built
+	if (_preset != BVH_FAST)
+	{
+		for (int k = leftChild.leftFirst; k < leftChild.leftFirst + leftChild.count; k++)
+		{
+			// Grow the left child
+			leftChild.bounds.grow(_objectBounds[k]);
+		}
+		for (int k = rightChild.leftFirst; k < rightChild.leftFirst + rightChild.count; k++)
+		{
+			// Grow the right child
+			rightChild.bounds.grow(_objectBounds[k]);
+		}
+	}
+
+	// Add the children
+	nodes.push_back(leftChild);
+	nodes.push_back(rightChild);
+
+	// Turn the node into an interior node
+	nodes[nodeIndex].leftFirst = leftChildIndex;
+	nodes[nodeIndex].count = 0;
+	nodes[nodeIndex].axis = axis;
+
+	// Return true
+	return true;
+}
+
+/*
+ * FIND BEST SPLIT FUNCTION
+ *
+ * Function bins the centroids of a node's objects and
+ * returns the cheapest split axis and position under
+ * the SAH, along with its cost. Large nodes are binned
+ * across threadCount threads
+ */
+float bvh::findBestSplit(const bvhNode& node, int& bestAxis, float& bestPosition, int threadCount) const
+{
+	// Best cost found so far
+	float bestCost = infinity;
+
+	// Bin small nodes on this thread
+	int chunkCount = node.count >= _parallelBinSize ? threadCount : 1;
+
+	// Determine the bounds of the centroids, a part of the objects on each thread
+	vector<aabb> chunkCentroidBounds(chunkCount);
+	runInChunks(node.leftFirst, node.count, chunkCount, [&](int chunk, int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			// Grow by the object's centroid
+			chunkCentroidBounds[chunk].grow(_objectBounds[i].getCentroid());
+		}
+	});
+	aabb centroidBounds;
+	for (const auto& box : chunkCentroidBounds)
+	{
+		centroidBounds.grow(box);
+	}
+
+	// Scale from position to bin index along each axis - 0 where the centroids are all in one plane
+	float scale[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		float extent = centroidBounds.getMax()[axis] - centroidBounds.getMin()[axis];
+		scale[axis] = extent > 0.0f ? _binCount / extent : 0.0f;
+	}
+
+	// Place each object in its bin along every axis, a part of the objects on each thread
+	vector<bvhBins> chunkBins(chunkCount);
+	runInChunks(node.leftFirst, node.count, chunkCount, [&](int chunk, int begin, int end)
+	{
+		bvhBins& bins = chunkBins[chunk];
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (int bin = 0; bin < _binCount; bin++)
+			{
+				bins.count[axis][bin] = 0;
+			}
+		}
+		for (int i = begin; i < end; i++)
+		{
+			point3 centroid = _objectBounds[i].getCentroid();
+			for (int axis = 0; axis < 3; axis++)
+			{
+				// Determine the bin index, and add the object to the bin
+				int bin = min(_binCount - 1, static_cast<int>((centroid[axis] - centroidBounds.getMin()[axis]) * scale[axis]));
+				bins.count[axis][bin]++;
+				bins.bounds[axis][bin].grow(_objectBounds[i]);
+			}
+		}
+	});
+
+	// Merge the threads' bins into the first
+	bvhBins& bins = chunkBins[0];
+	for (int chunk = 1; chunk < chunkCount; chunk++)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (int bin = 0; bin < _binCount; bin++)
+			{
+				bins.count[axis][bin] += chunkBins[chunk].count[axis][bin];
+				bins.bounds[axis][bin].grow(chunkBins[chunk].bounds[axis][bin]);
+			}
+		}
+	}
+
+	// Examine each axis
+	for (int axis = 0; axis < 3; axis++)
+	{
+		// Check if the centroids are all in one plane
+		if (scale[axis] == 0.0f)
+		{
+			// Cannot split along this axis
+			continue;
+		}
+
+		// Areas and counts to the left and right of each plane between bins
+		float leftArea[_binCount - 1], rightArea[_binCount - 1];
+		int leftCount[_binCount - 1], rightCount[_binCount - 1];
+
+		// Sweep from both ends at once
+		aabb leftBox, rightBox;
+		int leftSum = 0, rightSum = 0;
+		for (int i = 0; i < _binCount - 1; i++)
+		{
+			// Grow from the left
+			leftSum += bins.count[axis][i];
+			leftCount[i] = leftSum;
+			leftBox.grow(bins.bounds[axis][i]);
+			leftArea[i] = leftBox.surfaceArea();
+
+			// Grow from the right
+			rightSum += bins.count[axis][_binCount - 1 - i];
+			rightCount[_binCount - 2 - i] = rightSum;
+			rightBox.grow(bins.bounds[axis][_binCount - 1 - i]);
+			rightArea[_binCount - 2 - i] = rightBox.surfaceArea();
+		}
+
+		// Evaluate the cost of each plane
+		float boundsMin = centroidBounds.getMin()[axis];
+		float binWidth = (centroidBounds.getMax()[axis] - boundsMin) / _binCount;
+		for (int i = 0; i < _binCount - 1; i++)
+		{
+			// Determine the SAH cost
+			float planeCost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+
+			// Check if this is the cheapest plane so far
+			if (planeCost < bestCost)
+			{
+				// Record the plane
+				bestCost = planeCost;
+				bestAxis = axis;
+				bestPosition = boundsMin + binWidth * (i + 1);
+			}
+		}
+	}
+
+	// Return the best cost
+	return bestCost;
+}
+
+/*
+ * FIND MORTON SPLIT FUNCTION
+ *
+ * Function returns the number of a node's objects, sorted
+ * by Morton code, which go to its left child, and the axis
+ * of the split
+ */
+int bvh::findMortonSplit(const bvhNode& node, int& axis) const
+{
+	// Obtain the codes of the first and last objects
+	int first = node.leftFirst;
+	int last = node.leftFirst + node.count - 1;
+	uint32_t firstCode = _mortonCodes[first];
+	uint32_t lastCode = _mortonCodes[last];
+
+	// Check if every object has the same code
+	if (firstCode == lastCode)
+	{
+		// Split the objects in half
+		axis = 0;
+		return node.count / 2;
+	}
+
+	// Find the highest bit the codes differ in - the codes share every bit above it
+	int bit = 31;
+	while (((firstCode ^ lastCode) >> bit) == 0)
+	{
+		bit--;
+	}
+
+	// Bits cycle through z, y and x from the lowest
+	axis = 2 - bit % 3;
+
+	// Find the first object with the bit set
+	auto split = partition_point(_mortonCodes.begin() + first, _mortonCodes.begin() + last + 1, [bit](uint32_t code) { return ((code >> bit) & 1u) == 0; });
+	return static_cast<int>(split - (_mortonCodes.begin() + first));
+}
+
+/*
+ * SORT BY MORTON CODE FUNCTION
+ *
+ * Function orders the objects along a Morton curve through
+ * their centroids, so every node covers a contiguous run
+ * of codes
+ */
+void bvh::sortByMortonCode(const aabb& centroidBounds)
+{
+	// Determine the code of each object, 10 bits per axis, a part of the objects on each thread
+	const int objectCount = static_cast<int>(_objectBounds.size());
+	vector<uint64_t> keys(objectCount);
+	runInChunks(0, objectCount, objectCount >= _parallelBinSize ? _threadCount : 1, [&](int, int begin, int end)
+	{
+		for (int i = begin; i < end; i++)
+		{
+			// Quantise the centroid within the centroid bounds
+			point3 centroid = _objectBounds[i].getCentroid();
+			uint32_t code = 0;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				float extent = centroidBounds.getMax()[axis] - centroidBounds.getMin()[axis];
+				float position = extent > 0.0f ? (centroid[axis] - centroidBounds.getMin()[axis]) / extent : 0.0f;
+				uint32_t cell = static_cast<uint32_t>(min(1023.0f, position * 1024.0f));
+
+				// Spread the cell's bits out to every third bit, and interleave the axes
+				cell = (cell * 0x00010001u) & 0xFF0000FFu;
+				cell = (cell * 0x00000101u) & 0x0F00F00Fu;
+				cell = (cell * 0x00000011u) & 0xC30C30C3u;
+				cell = (cell * 0x00000005u) & 0x49249249u;
+				code |= cell << (2 - axis);
+			}
+
+			// Key holds the code above the object's index
+			keys[i] = (static_cast<uint64_t>(code) << 32) | static_cast<uint32_t>(i);
+		}
+	});
+
+	// Radix sort the keys by code, 10 bits at a time - the indices below keep equal codes in order
+	vector<uint64_t> sorted(objectCount);
+	for (int shift = 32; shift < 62; shift += 10)
+	{
+		// Count the keys with each digit, then turn the counts into starting positions
+		vector<int> starts(1025, 0);
+		for (uint64_t key : keys)
+		{
+			starts[((key >> shift) & 1023u) + 1]++;
+		}
+		for (int digit = 0; digit < 1024; digit++)
+		{
+			starts[digit + 1] += starts[digit];
+		}
+
+		// Place each key after the earlier keys with its digit
+		for (uint64_t key : keys)
+		{
+			sorted[starts[(key >> shift) & 1023u]++] = key;
+		}
+		keys.swap(sorted);
+	}
+
+	// Reorder the objects, bounds and codes
+	vector<int> order(objectCount);
+	vector<aabb> objectBounds(objectCount);
+	_mortonCodes.resize(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		uint32_t index = static_cast<uint32_t>(keys[i]);
+		order[i] = _order[index];
+		objectBounds[i] = _objectBounds[index];
+		_mortonCodes[i] = static_cast<uint32_t>(keys[i] >> 32);
+	}
+	_order.swap(order);
+	_objectBounds.swap(objectBounds);
+}
+
+/*
+ * HIT FUNCTION
+ *
+ * Function determines the closest object hit by a ray
+ */
+bool bvh::hit(const ray& r, float tMin, float tMax, hitRecord& rec) const
+{
+	// Closest ray parameter so far
+	float closestSoFar = tMax;
+
+	// Walk the hierarchy, testing the objects of each leaf reached
+	return traverse(r, tMin, closestSoFar, false, [&](int first, int count, float& closest)
+	{
+		// Hit anything boolean
+		bool hitAnything = false;
+
+		// Examine each object in the leaf
+		for (int i = first; i < first + count; i++)
+		{
+			// Check if the object is hit before the closest hit so far
+			if (_objects[i]->hit(r, tMin, closest, rec))
+			{
+				// Object hit, record closest hit
+				hitAnything = true;
+				closest = rec.t;
+			}
+		}
+
+		// Return value of hit anything
+		return hitAnything;
+	});
+}
+
+/*
+ * OCCLUDED FUNCTION
+ *
+ * Function determines if any object blocks a ray,
+ * stopping at the first one found
+ */
+bool bvh::occluded(const ray& r, float tMin, float tMax) const
+{
+	// Walk the hierarchy until an object blocks the ray - the interval never shrinks
+	return traverse(r, tMin, tMax, true, [&](int first, int count, float&)
+	{
+		// Examine each object in the leaf
+		for (int i = first; i < first + count; i++)
+		{
+			// Check if the object blocks the ray
+			if (_objects[i]->occluded(r, tMin, tMax))
+			{
+				// Blocked, no need to look further
+				return true;
+			}
+		}
+
+		// Nothing in the leaf blocks the ray
+		return false;
+	});
+}
+
+/*
+ * TRAVERSE FUNCTION
+ *
+ * Function walks the hierarchy with a ray, nearest child
+ * first, calling leafHit(first, count, tMax) for each leaf
+ * it reaches before tMax. leafHit returns true if it hit a
+ * primitive, having lowered tMax to the hit. Stops at the
+ * first leaf hit if stopAtFirstHit is true. Returns true
+ * if any leaf was hit
+ */
+template <typename LeafHit>
+bool bvh::traverse(const ray& r, float tMin, float& tMax, bool stopAtFirstHit, const LeafHit& leafHit) const
+{
+	// Check if the hierarchy is empty
+	if (_nodes.empty())
+	{
+		// Nothing to hit
+		return false;
+	}
+
+	// Obtain the ray origin and inverse direction once
+	point3 origin = r.getOrigin();
+	vec3 direction = r.getDirection();
+	vec3 invDirection(1.0f / direction.getX(), 1.0f / direction.getY(), 1.0f / direction.getZ());
+
+	// Hit anything boolean
+	bool hitAnything = false;
+
+	// Traversal stack
+	int stack[_stackSize];
+	int stackTop = 0;
+	stack[stackTop++] = 0;
+
+	// Traverse until the stack is empty
+	while (stackTop > 0)
+	{
+		// Obtain the next node
+		const bvhNode& node = _nodes[stack[--stackTop]];
+
+		// Check if the ray misses the node, or only hits beyond the closest hit
+		if (node.bounds.hit(origin, invDirection, tMin, tMax) == false)
+		{
+			// Skip the node
+			continue;
+		}
+
+		// Check if the node is a leaf
+		if (node.count > 0)
+		{
+			// Test the leaf's primitives
+			if (leafHit(node.leftFirst, node.count, tMax))
+			{
+				// Leaf hit, stop if any hit will do
+				hitAnything = true;
+				if (stopAtFirstHit)
+				{
+					return true;
+				}
+			}
+		}
+		else
+		{
+			// Push the far child first, so the near child is visited first
+			if (direction[node.axis] > 0.0f)
+			{
+				// Left child is nearer
+				stack[stackTop++] = node.leftFirst + 1;
+				stack[stackTop++] = node.leftFirst;
+			}
+			else
+			{
+				// Right child is nearer
+				stack[stackTop++] = node.leftFirst;
+				stack[stackTop++] = node.leftFirst + 1;
+			}
+		}
+	}
+
+	// Return value of hit anything
+	return hitAnything;
+}
+
+/*
+ * BOUNDING BOX FUNCTION
+ *
+ * Function obtains the box which bounds the hierarchy
+ */
+bool bvh::boundingBox(aabb& outputBox) const
+{
+	// Check if the hierarchy is empty
+	if (_nodes.empty())
+	{
+		// Nothing to bound
+		return false;
+	}
+
+	// Return the bounds of the root
+	outputBox = _nodes[0].bounds;
+	return true;
+}
+
+/*
+ * HIT PACKET FUNCTION
+ *
+ * Function traverses the hierarchy with a whole packet of
+ * rays. A node is visited if any active lane hits it, so
+ * coherent rays share the cost of each node test
+ */
+void bvh::hitPacket(const rayPacket& packet, float tMin, float tMax[], hitRecord rec[], bool hits[]) const
+{
+	// Check if the hierarchy is empty
+	if (_nodes.empty())
+	{
+		// Nothing to hit
+		return;
+	}
+
+	// Find the first active lane, used to order the children
+	int leadLane = 0;
+	while (leadLane < packetWidth - 1 && packet.active[leadLane] == 0)
+	{
+		// Move to the next lane
+		leadLane++;
+	}
+
+	// Traversal stack
+	int stack[_stackSize];
+	int stackTop = 0;
+	stack[stackTop++] = 0;
+
+	// Traverse until the stack is empty
+	while (stackTop > 0)
+	{
+		// Obtain the next node
+		const bvhNode& node = _nodes[stack[--stackTop]];
+
+		// Obtain the node bounds as vectors
+		const point3 boundsMin = node.bounds.getMin();
+		const point3 boundsMax = node.bounds.getMax();
+		const float4 minX(boundsMin.getX()), minY(boundsMin.getY()), minZ(boundsMin.getZ());
+		const float4 maxX(boundsMax.getX()), maxY(boundsMax.getY()), maxZ(boundsMax.getZ());
+
+		// Mask of lanes which hit the node
+		float4 anyHit(0.0f);
+
+		// Slab test, 4 lanes at a time
+		for (int lane = 0; lane < packetWidth; lane += simdWidth)
+		{
+			// Load the lanes' origins and inverse directions
+			float4 originX = float4::load(packet.originX + lane);
+			float4 originY = float4::load(packet.originY + lane);
+			float4 originZ = float4::load(packet.originZ + lane);
+			float4 invDirectionX = float4::load(packet.invDirectionX + lane);
+			float4 invDirectionY = float4::load(packet.invDirectionY + lane);
+			float4 invDirectionZ = float4::load(packet.invDirectionZ + lane);
+
+			// Determine the slab parameters on each axis
+			float4 tx0 = (minX - originX) * invDirectionX;
+			float4 tx1 = (maxX - originX) * invDirectionX;
+			float4 ty0 = (minY - originY) * invDirectionY;
+			float4 ty1 = (maxY - originY) * invDirectionY;
+			float4 tz0 = (minZ - originZ) * invDirectionZ;
+			float4 tz1 = (maxZ - originZ) * invDirectionZ;
+
+			// Determine the entry and exit parameters, widening each slab's exit by the rounding error as the single ray test does
+			const float4 exitScale(slabExitScale);
+			float4 entry = maximum(maximum(minimum(tx0, tx1), minimum(ty0, ty1)), maximum(minimum(tz0, tz1), float4(tMin)));
+			float4 exit = minimum(minimum(exitScale * maximum(tx0, tx1), exitScale * maximum(ty0, ty1)), minimum(exitScale * maximum(tz0, tz1), float4::load(tMax + lane)));
+
+			// Lane hits if it is active and its interval is not empty
+			anyHit = anyHit | ((entry <= exit) & float4::loadMask(packet.active + lane));
+		}
+
+		// Check if every lane misses the node
+		if (anyTrue(anyHit) == false)
+		{
+			// Skip the node
+			continue;
+		}
+
+		// Check if the node is a leaf
+		if (node.count > 0)
+		{
+			// Test each object in the leaf against the whole packet
+			for (int i = node.leftFirst; i < node.leftFirst + node.count; i++)
+			{
+				// Packet test
+				_objects[i]->hitPacket(packet, tMin, tMax, rec, hits);
+			}
+		}
+		else
+		{
+			// Obtain the lead lane's direction along the split axis
+			float leadDirection = node.axis == 0 ? packet.directionX[leadLane] : (node.axis == 1 ? packet.directionY[leadLane] : packet.directionZ[leadLane]);
+
+			// Push the far child first, so the near child is visited first
+			if (leadDirection > 0.0f)
+			{
+				// Left child is nearer
+				stack[stackTop++] = node.leftFirst + 1;
+				stack[stackTop++] = node.leftFirst;
+			}
+			else
+			{
+				// Right child is nearer
+				stack[stackTop++] = node.leftFirst;
+				stack[stackTop++] = node.leftFirst + 1;
+			}
+		}
+	}
+}
+
+// End ifndef directive for BVH_H
+#endif
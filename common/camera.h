@@ -4,7 +4,7 @@
  * GRAEME B. WHITE - 40415739
  *
  * DATE OF CREATION: 11/10/2020
- * DATE LAST MODIFIED: 11/10/2020
+ * DATE LAST MODIFIED: 18/10/2026
  * ==================================================================
  * PATH-TRACING PROTOTYPE
  *
@@ -28,6 +28,7 @@
 
 // Headers
 #include "common.h"
+#include "sampler.h"
 
 /* ==================================================================
  * CAMERA CLASS
@@ -48,9 +49,12 @@ class camera
 		 * sets values for aspect ratio, view port height, viewport
 		 * width, and focal length. Also determines and sets the 
 		 * origin, horizontal axis, vertical axis and the lower 
-		 * left corner.
+		 * left corner. The shutter is open from shutterOpen to
+		 * shutterClose - rays are spread over the interval, so
+		 * moving objects are blurred
 		 */
-		camera(point3& lookFrom, point3 lookAt, vec3 verticalUp, float verticalFoV, float aspectRatio, float aperture, float focusDistance)
+		camera(point3& lookFrom, point3 lookAt, vec3 verticalUp, float verticalFoV, float aspectRatio, float aperture, float focusDistance, float shutterOpen = 0.0f, float shutterClose = 0.0f)
+			: _shutterOpen(shutterOpen), _shutterClose(shutterClose)
 		{
 			// Determine theta in radians
 			auto theta = degreesToRadians(verticalFoV);
@@ -93,17 +97,96 @@ class camera
 		 * GET RAY FUNCTION
 		 * 
 		 * Function returns a ray from the camera, based on u, v coordinates
+		 * and a lens sample, cast at time. Checks for a lens on every call -
+		 * render kernels which know the camera type call the pinhole or thin
+		 * lens function directly
 		 */
-		ray getRay(float s, float t) const
+		ray getRay(float s, float t, const sample2D& lensSample, float time = 0.0f) const
+		{
+			// Check if the camera has a lens
+			if (hasLens())
+			{
+				// Return ray through the lens
+				return getThinLensRay(s, t, lensSample, time);
+			}
+
+			// Return ray from the camera origin
+			return getPinholeRay(s, t, time);
+		}
+
+		/*
+		 * GET PINHOLE RAY FUNCTION
+		 * 
+		 * Function returns a ray from the camera origin, based on u, v
+		 * coordinates, ignoring the lens
+		 */
+		ray getPinholeRay(float s, float t, float time = 0.0f) const
+		{
+			// Return ray, based on camera position
+			return ray(_origin, _lowerLeftCorner + s * _horizontal + t * _vertical - _origin, time);
+		}
+
+		/*
+		 * GET THIN LENS RAY FUNCTION
+		 * 
+		 * Function returns a ray from the point on the lens given by the
+		 * lens sample, based on u, v coordinates, giving defocus blur
+		 */
+		ray getThinLensRay(float s, float t, const sample2D& lensSample, float time = 0.0f) const
 		{
 			// Determine rd
-			vec3 rd = _lensRadius * randomInUnitDisk();
+			vec3 rd = _lensRadius * sampleUnitDisk(lensSample);
 
 			// Determine the offset
 			vec3 offset = _u * rd.getX() + _v * rd.getY();
 
 			// Return ray, based on camera position
-			return ray(_origin + offset, _lowerLeftCorner + s * _horizontal + t * _vertical - _origin - offset);
+			return ray(_origin + offset, _lowerLeftCorner + s * _horizontal + t * _vertical - _origin - offset, time);
+		}
+
+		/*
+		 * HAS LENS FUNCTION
+		 * 
+		 * Function returns true if the camera has an aperture, and so
+		 * gives defocus blur
+		 */
+		bool hasLens() const
+		{
+			// Check the lens radius
+			return _lensRadius > 0.0f;
+		}
+
+		/*
+		 * HAS MOTION BLUR FUNCTION
+		 * 
+		 * Function returns true if the shutter is open for an
+		 * interval, rather than an instant
+		 */
+		bool hasMotionBlur() const
+		{
+			// Check the shutter interval
+			return _shutterClose > _shutterOpen;
+		}
+
+		/*
+		 * SAMPLE TIME FUNCTION
+		 * 
+		 * Function returns the time a camera ray is cast, from the
+		 * time dimension of the sample. An instant shutter uses no
+		 * dimension
+		 */
+		float sampleTime(sampler& samp) const
+		{
+			// Check if the shutter is open for an interval
+			if (!hasMotionBlur())
+			{
+				// Every ray is cast when the shutter opens
+				return _shutterOpen;
+			}
+
+			// Spread the rays over the interval
+			samp.setDimension(timeDimension);
+			return _shutterOpen + samp.get1D() * (_shutterClose - _shutterOpen);
 		}
 
 	// Private variables
@@ -125,6 +208,10 @@ class camera
 
 		// Lens redius
 		float _lensRadius;
+
+		// Shutter interval
+		float _shutterOpen;
+		float _shutterClose;
 };
 
 // End ifndef directive for CAMERA_H
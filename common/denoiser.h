@@ -0,0 +1,246 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * DENOISER HEADER FILE
+ *
+ * Header file containing the denoiser - an edge-aware a-trous
+ * wavelet filter, after the spatial part of SVGF (Schied et al.
+ * 2017), guided by the albedo and normal AOVs.
+ *
+ * The colour is divided by the albedo first, so texture-like detail
+ * in the albedo is kept sharp and only the lighting is blurred. The
+ * filter is then applied several times with a 5x5 kernel whose taps
+ * spread twice as far each time. Each tap is weighted down where the
+ * normals differ, where the albedos differ, and where the lighting
+ * differs by more than the noise expected there, estimated from the
+ * local variance of the lighting's luminance
+ */
+
+// Declare ifndef directive for DENOISER_H
+#ifndef DENOISER_H
+
+// Define DENOISER_H
+#define DENOISER_H
+
+// Header files
+#include "common.h"
+#include "aov.h"
+#include <vector>
+
+// Namespace
+using namespace std;
+
+// Default number of a-trous passes - the last pass's taps are 8 pixels apart
+const int denoiserPassCount = 4;
+
+// Sharpness of the normal, luminance and albedo edge-stopping weights
+const float denoiserNormalPower = 128.0f;
+const float denoiserLuminanceScale = 4.0f;
+const float denoiserAlbedoScale = 0.1f;
+
+// Smallest albedo divided out, so near-black surfaces do not amplify noise
+const float denoiserMinimumAlbedo = 0.01f;
+
+/*
+ * LUMINANCE FUNCTION
+ *
+ * Function returns the luminance of a linear colour
+ */
+inline float luminance(const colour& c)
+{
+	// Rec. 709 weights
+	return 0.2126f * c.getX() + 0.7152f * c.getY() + 0.0722f * c.getZ();
+}
+
+/*
+ * DENOISE FUNCTION
+ *
+ * Function denoises the frame buffer in place, guided by the AOV
+ * buffers. Both hold sums over samplesPerPixel samples, and the
+ * frame buffer is left holding sums so it is written as before
+ */
+inline void denoise(vector<colour>& frameBuffer, const aovBuffers& aovs, int imageWidth, int imageHeight, int samplesPerPixel, int passCount = denoiserPassCount)
+{
+	// Number of pixels, and the scale from sums to means
+	const int pixelCount = imageWidth * imageHeight;
+	const float scale = 1.0f / samplesPerPixel;
+
+	// Per-pixel albedo, unit normal, lighting and its variance
+	vector<colour> albedo(pixelCount);
+	vector<vec3> normal(pixelCount);
+	vector<colour> lighting(pixelCount);
+	vector<float> variance(pixelCount);
+
+	// Divide the albedo out of each pixel's colour
+	for (int i = 0; i < pixelCount; i++)
+	{
+		// Obtain the pixel's mean albedo and normal
+		albedo[i] = scale * aovs.albedo[i];
+		float normalLength = aovs.normal[i].length();
+		normal[i] = normalLength > 0.0f ? aovs.normal[i] / normalLength : vec3(0.0f, 0.0f, 0.0f);
+
+		// Divide the mean colour by the albedo
+		colour c = scale * frameBuffer[i];
+		lighting[i] = colour(c.getX() / fmax(albedo[i].getX(), denoiserMinimumAlbedo),
+			c.getY() / fmax(albedo[i].getY(), denoiserMinimumAlbedo),
+			c.getZ() / fmax(albedo[i].getZ(), denoiserMinimumAlbedo));
+	}
+
+	// Estimate the variance of each pixel's luminance from its 5x5 neighbourhood - one frame gives no history to use
+	for (int y = 0; y < imageHeight; y++)
+	{
+		for (int x = 0; x < imageWidth; x++)
+		{
+			// Accumulate the first and second moments of the neighbours on the same surface
+			int p = y * imageWidth + x;
+			float sum = 0.0f, sumSquared = 0.0f;
+			int count = 0;
+			for (int dy = -2; dy <= 2; dy++)
+			{
+				for (int dx = -2; dx <= 2; dx++)
+				{
+					// Check the neighbour is in the image and faces the same way
+					int qx = x + dx, qy = y + dy;
+					if (qx < 0 || qx >= imageWidth || qy < 0 || qy >= imageHeight || dot(normal[p], normal[qy * imageWidth + qx]) < 0.8f * normal[p].lengthSquared())
+					{
+						// Skip the neighbour
+						continue;
+					}
+
+					// Add the neighbour's luminance
+					float l = luminance(lighting[qy * imageWidth + qx]);
+					sum += l;
+					sumSquared += l * l;
+					count++;
+				}
+			}
+
+			// Variance of the neighbourhood
+			float mean = sum / count;
+			variance[p] = fmax(0.0f, sumSquared / count - mean * mean);
+		}
+	}
+
+	// Weights of the 5x5 B3 spline kernel, along one axis
+	const float kernel[3] = { 3.0f / 8.0f, 1.0f / 4.0f, 1.0f / 16.0f };
+
+	// Output of each pass
+	vector<colour> filtered(pixelCount);
+	vector<float> filteredVariance(pixelCount);
+
+	// Filter with taps spread further each pass
+	for (int pass = 0; pass < passCount; pass++)
+	{
+		// Spacing of the taps
+		const int step = 1 << pass;
+
+		// Filter each pixel
+		for (int y = 0; y < imageHeight; y++)
+		{
+			for (int x = 0; x < imageWidth; x++)
+			{
+				// Obtain the centre pixel
+				int p = y * imageWidth + x;
+				float centreLuminance = luminance(lighting[p]);
+
+				// Blur the variance over 3x3 before using it, as SVGF does, so one noisy estimate does not stop the filter
+				float blurredVariance = 0.0f, varianceWeight = 0.0f;
+				for (int dy = -1; dy <= 1; dy++)
+				{
+					for (int dx = -1; dx <= 1; dx++)
+					{
+						// Check the neighbour is in the image
+						int qx = x + dx, qy = y + dy;
+						if (qx >= 0 && qx < imageWidth && qy >= 0 && qy < imageHeight)
+						{
+							// Add the neighbour's variance with a 1-2-1 weight
+							float w = (dx == 0 ? 2.0f : 1.0f) * (dy == 0 ? 2.0f : 1.0f);
+							blurredVariance += w * variance[qy * imageWidth + qx];
+							varianceWeight += w;
+						}
+					}
+				}
+				float luminanceScale = denoiserLuminanceScale * sqrt(blurredVariance / varianceWeight) + 1e-4f;
+
+				// Accumulate the weighted taps
+				colour sum(0.0f, 0.0f, 0.0f);
+				float sumVariance = 0.0f;
+				float sumWeight = 0.0f;
+				for (int dy = -2; dy <= 2; dy++)
+				{
+					for (int dx = -2; dx <= 2; dx++)
+					{
+						// Check the tap is in the image
+						int qx = x + dx * step, qy = y + dy * step;
+						if (qx < 0 || qx >= imageWidth || qy < 0 || qy >= imageHeight)
+						{
+							// Skip the tap
+							continue;
+						}
+						int q = qy * imageWidth + qx;
+
+						// Normal weight - two misses match each other, and nothing else
+						float normalWeight;
+						if (normal[p].lengthSquared() > 0.0f && normal[q].lengthSquared() > 0.0f)
+						{
+							normalWeight = pow(fmax(0.0f, dot(normal[p], normal[q])), denoiserNormalPower);
+						}
+						else
+						{
+							normalWeight = normal[p].lengthSquared() == normal[q].lengthSquared() ? 1.0f : 0.0f;
+						}
+
+						// Luminance weight, relative to the noise expected at the centre
+						float luminanceWeight = exp(-fabs(centreLuminance - luminance(lighting[q])) / luminanceScale);
+
+						// Albedo weight
+						vec3 albedoDifference = albedo[p] - albedo[q];
+						float albedoWeight = exp(-albedoDifference.lengthSquared() / denoiserAlbedoScale);
+
+						// Combined weight of the tap
+						float w = kernel[dx < 0 ? -dx : dx] * kernel[dy < 0 ? -dy : dy] * normalWeight * luminanceWeight * albedoWeight;
+
+						// Add the tap, and its variance with the squared weight
+						sum += w * lighting[q];
+						sumVariance += w * w * variance[q];
+						sumWeight += w;
+					}
+				}
+
+				// Normalise - the centre tap always has a positive weight
+				filtered[p] = sum / sumWeight;
+				filteredVariance[p] = sumVariance / (sumWeight * sumWeight);
+			}
+		}
+
+		// Use the output as the next pass's input
+		lighting.swap(filtered);
+		variance.swap(filteredVariance);
+	}
+
+	// Multiply the albedo back in, and return to sums over the samples
+	for (int i = 0; i < pixelCount; i++)
+	{
+		// Remodulate each channel by the albedo which was divided out
+		frameBuffer[i] = static_cast<float>(samplesPerPixel) * colour(lighting[i].getX() * fmax(albedo[i].getX(), denoiserMinimumAlbedo),
+			lighting[i].getY() * fmax(albedo[i].getY(), denoiserMinimumAlbedo),
+			lighting[i].getZ() * fmax(albedo[i].getZ(), denoiserMinimumAlbedo));
+	}
+}
+
+// End ifndef directive for DENOISER_H
+#endif
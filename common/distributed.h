@@ -0,0 +1,1060 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * DISTRIBUTED RENDERING HEADER FILE
+ *
+ * Header file containing the coordinator and worker of a render
+ * split across processes. The coordinator divides the samples per
+ * pixel into jobs - ranges of samples over the whole image - and
+ * hands them out over TCP to worker processes, which run the same
+ * program with the same options and so build the same scene - the
+ * hello carries the worker's scene fingerprint, and a worker whose
+ * scene, seeds or samples per pixel differ is turned away. Each
+ * worker returns the float sums of its range, which the coordinator
+ * adds up in double. Every sample is keyed by its pixel and absolute
+ * sample index, so the render draws exactly the samples of a render
+ * in one process. The sums are rounded in a different order, though
+ * - per job in float, then across jobs in double, rather than all in
+ * one float - so the two images are statistically equivalent, not
+ * identical. For a given job size the result does not depend on
+ * which worker rendered which job, so a job handed to another worker
+ * gives the same image.
+ *
+ * A worker which disconnects or dies mid-job has its job handed to
+ * another worker. Messages are sent in the byte order of the
+ * machine; a worker of the other byte order fails the hello check.
+ * Sockets are POSIX only - on other platforms distributed rendering
+ * reports that it is unavailable
+ */
+
+// Declare ifndef directive for DISTRIBUTED_H
+#ifndef DISTRIBUTED_H
+
+// Define DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+// Header files
+#include "common.h"
+#include "aov.h"
+#include "sceneFingerprint.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// POSIX socket and process header files
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Namespace
+using namespace std;
+
+// Value starting every message, so a stray connection or a mismatched byte order is rejected
+const uint32_t distributedMagic = 0x50544a42;
+
+// Message types
+enum messageType : uint32_t
+{
+	// Worker to coordinator, on connecting - the image size and scene it renders
+	MESSAGE_HELLO = 1,
+
+	// Coordinator to worker - a range of samples to render
+	MESSAGE_JOB = 2,
+
+	// Worker to coordinator - the sums of a job, followed by the pixels
+	MESSAGE_RESULT = 3,
+
+	// Coordinator to worker - no more jobs, exit
+	MESSAGE_QUIT = 4
+};
+
+/* ==================================================================
+ * MESSAGE HEADER STRUCT
+ *
+ * Struct starting every message. Fields a message does not use are
+ * zero
+ * ==================================================================
+ */
+struct messageHeader
+{
+	// Always distributedMagic
+	uint32_t magic;
+
+	// Message type
+	uint32_t type;
+
+	// Index of the job
+	uint32_t job;
+
+	// First sample, and number of samples, of the job
+	uint32_t firstSample;
+	uint32_t sampleCount;
+
+	// Image size
+	uint32_t imageWidth;
+	uint32_t imageHeight;
+
+	// Whether the job fills, and the result carries, AOV buffers
+	uint32_t hasAovs;
+
+	// Scene, sampler and seeds of the worker, in its hello
+	sceneFingerprint fingerprint;
+};
+
+// Floats per pixel of a result - colour, then albedo, normal and depth if it carries AOVs
+const int resultColourFloats = 3;
+const int resultAovFloats = 7;
+
+// Integers per pixel of a result carrying AOVs - material, object and sample count
+const int resultAovIntegers = 3;
+
+/*
+ * MAKE HEADER FUNCTION
+ *
+ * Function returns a message header of a type, with every other
+ * field zero
+ */
+inline messageHeader makeHeader(messageType type)
+{
+	// Fill the header
+	messageHeader header = {};
+	header.magic = distributedMagic;
+	header.type = type;
+	return header;
+}
+
+/*
+ * PACK RESULT FUNCTION
+ *
+ * Function copies a job's frame buffer, and its AOV buffers if
+ * any, into the flat arrays sent to the coordinator
+ */
+inline void packResult(const vector<colour>& frameBuffer, const aovBuffers* aovs, vector<float>& floats, vector<int32_t>& integers)
+{
+	// Size the arrays
+	const int pixelCount = static_cast<int>(frameBuffer.size());
+	const int floatsPerPixel = resultColourFloats + (aovs != nullptr ? resultAovFloats : 0);
+	floats.resize(static_cast<size_t>(pixelCount) * floatsPerPixel);
+	integers.resize(aovs != nullptr ? static_cast<size_t>(pixelCount) * resultAovIntegers : 0);
+
+	// Copy each pixel
+	for (int i = 0; i < pixelCount; i++)
+	{
+		// Colour
+		float* f = &floats[static_cast<size_t>(i) * floatsPerPixel];
+		for (int c = 0; c < 3; c++)
+		{
+			f[c] = frameBuffer[i][c];
+		}
+
+		// AOVs, if any
+		if (aovs != nullptr)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				f[3 + c] = aovs->albedo[i][c];
+				f[6 + c] = aovs->normal[i][c];
+			}
+			f[9] = aovs->depth[i];
+			integers[3 * i] = aovs->materialIndex[i];
+			integers[3 * i + 1] = aovs->objectIndex[i];
+			integers[3 * i + 2] = aovs->sampleCount[i];
+		}
+	}
+}
+
+// **** POSIX IMPLEMENTATION **** //
+
+#ifndef _WIN32
+
+/*
+ * SEND ALL FUNCTION
+ *
+ * Function sends a whole block of bytes on a socket, however many
+ * calls it takes. Returns false if the connection fails
+ */
+inline bool sendAll(int socket, const void* data, size_t size)
+{
+	// Send until everything has gone
+	const char* bytes = static_cast<const char*>(data);
+	while (size > 0)
+	{
+		ssize_t sent = send(socket, bytes, size, 0);
+		if (sent < 0 && errno == EINTR)
+		{
+			// Interrupted, try again
+			continue;
+		}
+		if (sent <= 0)
+		{
+			// Connection failed
+			return false;
+		}
+		bytes += sent;
+		size -= static_cast<size_t>(sent);
+	}
+
+	// Return true
+	return true;
+}
+
+/*
+ * RECEIVE ALL FUNCTION
+ *
+ * Function receives a whole block of bytes from a socket, however
+ * many calls it takes. Returns false if the connection closes or
+ * fails first
+ */
+inline bool receiveAll(int socket, void* data, size_t size)
+{
+	// Receive until everything has arrived
+	char* bytes = static_cast<char*>(data);
+	while (size > 0)
+	{
+		ssize_t received = recv(socket, bytes, size, 0);
+		if (received < 0 && errno == EINTR)
+		{
+			// Interrupted, try again
+			continue;
+		}
+		if (received <= 0)
+		{
+			// Connection closed or failed
+			return false;
+		}
+		bytes += received;
+		size -= static_cast<size_t>(received);
+	}
+
+	// Return true
+	return true;
+}
+
+/*
+ * CONNECT TO COORDINATOR FUNCTION
+ *
+ * Function connects to a coordinator at "host:port", retrying for a
+ * few seconds so workers may be started before the coordinator.
+ * Returns the socket, or -1 after printing the reason
+ */
+inline int connectToCoordinator(const string& address)
+{
+	// Split the address at its last colon
+	size_t colon = address.rfind(':');
+	if (colon == string::npos || colon == 0 || colon + 1 == address.size())
+	{
+		// Address has no port
+		cerr << "Coordinator address must be host:port, not " << address << endl;
+		return -1;
+	}
+	string host = address.substr(0, colon);
+	string port = address.substr(colon + 1);
+
+	// Retry every 100 ms for 5 seconds
+	for (int attempt = 0; attempt < 50; attempt++)
+	{
+		// Look up the host
+		addrinfo hints = {};
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		addrinfo* results = nullptr;
+		int lookup = getaddrinfo(host.c_str(), port.c_str(), &hints, &results);
+		if (lookup != 0)
+		{
+			// Host cannot be found
+			cerr << "Could not resolve coordinator " << address << ": " << gai_strerror(lookup) << endl;
+			return -1;
+		}
+
+		// Try each address of the host
+		for (addrinfo* result = results; result != nullptr; result = result->ai_next)
+		{
+			int s = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+			if (s >= 0 && connect(s, result->ai_addr, result->ai_addrlen) == 0)
+			{
+				// Connected
+				freeaddrinfo(results);
+				return s;
+			}
+			if (s >= 0)
+			{
+				close(s);
+			}
+		}
+		freeaddrinfo(results);
+
+		// Wait before trying again
+		usleep(100000);
+	}
+
+	// Coordinator never answered
+	cerr << "Could not connect to coordinator " << address << endl;
+	return -1;
+}
+
+/*
+ * RUN WORKER FUNCTION
+ *
+ * Function connects to the coordinator and renders the jobs it
+ * hands out until it has no more. renderJob(firstSample,
+ * sampleCount, frameBuffer, aovs) renders a range of samples into
+ * zeroed buffers, with aovs null if the job has none, returning
+ * false on failure. Returns false, after printing the reason, if
+ * the coordinator is lost or a job fails
+ */
+template <typename RenderJob>
+bool runWorker(const string& address, int imageWidth, int imageHeight, const sceneFingerprint& fingerprint, RenderJob renderJob)
+{
+	// Losing the coordinator is reported by send, rather than by a signal
+	signal(SIGPIPE, SIG_IGN);
+
+	// Connect to the coordinator
+	int connection = connectToCoordinator(address);
+	if (connection < 0)
+	{
+		// Reason has been output
+		return false;
+	}
+
+	// Introduce the worker with its image size and scene
+	messageHeader hello = makeHeader(MESSAGE_HELLO);
+	hello.imageWidth = static_cast<uint32_t>(imageWidth);
+	hello.imageHeight = static_cast<uint32_t>(imageHeight);
+	hello.fingerprint = fingerprint;
+	if (!sendAll(connection, &hello, sizeof(hello)))
+	{
+		// Coordinator closed the connection
+		cerr << "Lost the coordinator at " << address << endl;
+		close(connection);
+		return false;
+	}
+
+	// Buffers of each job, and the arrays they are sent in
+	const int pixelCount = imageWidth * imageHeight;
+	vector<colour> frameBuffer;
+	vector<float> floats;
+	vector<int32_t> integers;
+
+	// Render jobs until told to stop
+	while (true)
+	{
+		// Wait for the next message
+		messageHeader message;
+		if (!receiveAll(connection, &message, sizeof(message)) || message.magic != distributedMagic)
+		{
+			// Coordinator closed the connection, or sent something else
+			cerr << "Lost the coordinator at " << address << endl;
+			close(connection);
+			return false;
+		}
+
+		// Check if there are no more jobs
+		if (message.type == MESSAGE_QUIT)
+		{
+			// Done
+			close(connection);
+			return true;
+		}
+
+		// Render the job into zeroed buffers
+		frameBuffer.assign(pixelCount, colour(0.0f, 0.0f, 0.0f));
+		aovBuffers jobAovs(message.hasAovs != 0 ? pixelCount : 0);
+		aovBuffers* aovs = message.hasAovs != 0 ? &jobAovs : nullptr;
+		if (!renderJob(static_cast<int>(message.firstSample), static_cast<int>(message.sampleCount), frameBuffer, aovs))
+		{
+			// Reason has been output - the coordinator hands the job to another worker
+			close(connection);
+			return false;
+		}
+
+		// Send the result
+		messageHeader result = message;
+		result.type = MESSAGE_RESULT;
+		packResult(frameBuffer, aovs, floats, integers);
+		if (!sendAll(connection, &result, sizeof(result))
+			|| !sendAll(connection, floats.data(), floats.size() * sizeof(float))
+			|| !sendAll(connection, integers.data(), integers.size() * sizeof(int32_t)))
+		{
+			// Coordinator closed the connection
+			cerr << "Lost the coordinator at " << address << endl;
+			close(connection);
+			return false;
+		}
+	}
+}
+
+/* ==================================================================
+ * COORDINATOR CLASS
+ *
+ * Class for the coordinator of a distributed render. Holds the
+ * jobs, the connected workers, and the sums of the finished jobs,
+ * kept in double precision so the image does not depend on the
+ * order the results arrive in
+ * ==================================================================
+ */
+class coordinator
+{
+	// Public functions
+	public:
+		/*
+		 * COORDINATOR CONSTRUCTOR
+		 *
+		 * When invoked, creates a coordinator for an image,
+		 * splitting its samples per pixel into jobs of jobSamples
+		 * samples each. Only workers with the same fingerprint are
+		 * accepted. AOVs are gathered if aovs is not null
+		 */
+		coordinator(int imageWidth, int imageHeight, const sceneFingerprint& fingerprint, int samplesPerPixel, int jobSamples, aovBuffers* aovs) :
+			_imageWidth(imageWidth), _imageHeight(imageHeight), _fingerprint(fingerprint), _aovs(aovs), _listener(-1), _reassigned(0), _workersSeen(0)
+		{
+			// Split the samples into jobs
+			for (int first = 0; first < samplesPerPixel; first += jobSamples)
+			{
+				sampleJob job;
+				job.firstSample = first;
+				job.sampleCount = min(jobSamples, samplesPerPixel - first);
+				_jobs.push_back(job);
+				_pending.push_back(static_cast<int>(_jobs.size()) - 1);
+			}
+			_jobsRemaining = static_cast<int>(_jobs.size());
+
+			// Zero the sums
+			const size_t pixelCount = static_cast<size_t>(imageWidth) * imageHeight;
+			_colour.assign(pixelCount * 3, 0.0);
+			if (aovs != nullptr)
+			{
+				_albedo.assign(pixelCount * 3, 0.0);
+				_normal.assign(pixelCount * 3, 0.0);
+			}
+		}
+
+		/*
+		 * COORDINATOR DESTRUCTOR
+		 *
+		 * When invoked, closes every socket
+		 */
+		~coordinator()
+		{
+			// Close the workers and the listener
+			for (const auto& worker : _workers)
+			{
+				close(worker.socket);
+			}
+			if (_listener >= 0)
+			{
+				close(_listener);
+			}
+		}
+
+		/*
+		 * RUN FUNCTION
+		 *
+		 * Function listens for workers, starts workerCount local
+		 * ones by running the program again with workerArguments
+		 * and "--worker", hands out every job, and writes the sums
+		 * to the frame buffer and the AOV buffers. Port 0 listens
+		 * on a free port of the loopback interface only; any other
+		 * port is open to workers on other machines. Returns false,
+		 * after printing the reason, if every worker is lost
+		 */
+		bool run(const vector<string>& workerArguments, int workerCount, int port, vector<colour>& frameBuffer)
+		{
+			// Lost workers are reported by send, rather than by a signal
+			signal(SIGPIPE, SIG_IGN);
+
+			// Start listening
+			if (!openListener(port))
+			{
+				// Reason has been output
+				return false;
+			}
+
+			// Start the local workers
+			vector<pid_t> children;
+			if (!startWorkers(workerArguments, workerCount, children))
+			{
+				// Reason has been output
+				stopWorkers(children);
+				return false;
+			}
+
+			// Hand out jobs until every one is done
+			bool succeeded = true;
+			while (_jobsRemaining > 0)
+			{
+				// Forget local workers which have exited
+				reapWorkers(children, false);
+
+				// Check some worker can still finish the render - remote workers may connect later
+				if (port == 0 && _workers.empty() && children.empty())
+				{
+					// Every worker has gone
+					cerr << endl << "All workers were lost with " << _jobsRemaining << " jobs remaining" << endl;
+					succeeded = false;
+					break;
+				}
+
+				// Wait for a connection or a result
+				vector<pollfd> polled;
+				polled.push_back(pollfd{ _listener, POLLIN, 0 });
+				for (const auto& worker : _workers)
+				{
+					polled.push_back(pollfd{ worker.socket, POLLIN, 0 });
+				}
+				if (poll(polled.data(), polled.size(), 100) < 0 && errno != EINTR)
+				{
+					// Polling failed
+					cerr << endl << "Coordinator poll failed: " << strerror(errno) << endl;
+					succeeded = false;
+					break;
+				}
+
+				// Read each worker with something to say, from the back so workers can be removed
+				for (int w = static_cast<int>(_workers.size()) - 1; w >= 0; w--)
+				{
+					if (polled[w + 1].revents != 0 && !receiveResult(_workers[w]))
+					{
+						// Worker has gone - hand its job to another
+						dropWorker(w);
+					}
+				}
+
+				// Accept a new worker
+				if (polled[0].revents & POLLIN)
+				{
+					acceptWorker();
+				}
+
+				// Give every idle worker a job
+				dispatchJobs();
+			}
+
+			// Tell the workers to exit, and wait for the local ones
+			stopWorkers(children);
+
+			// Check the render finished
+			if (!succeeded)
+			{
+				// Reason has been output
+				return false;
+			}
+
+			// Write the sums
+			for (size_t i = 0; i < frameBuffer.size(); i++)
+			{
+				frameBuffer[i] = colour(static_cast<float>(_colour[3 * i]), static_cast<float>(_colour[3 * i + 1]), static_cast<float>(_colour[3 * i + 2]));
+				if (_aovs != nullptr)
+				{
+					_aovs->albedo[i] = colour(static_cast<float>(_albedo[3 * i]), static_cast<float>(_albedo[3 * i + 1]), static_cast<float>(_albedo[3 * i + 2]));
+					_aovs->normal[i] = vec3(static_cast<float>(_normal[3 * i]), static_cast<float>(_normal[3 * i + 1]), static_cast<float>(_normal[3 * i + 2]));
+				}
+			}
+
+			// Output statistics
+			cout << "\rDistributed " << _jobs.size() << " jobs over " << _workersSeen << " workers, " << _reassigned << " reassigned" << endl;
+
+			// Return true
+			return true;
+		}
+
+	// Private
+	private:
+		/* ==============================================================
+		 * SAMPLE JOB STRUCT
+		 *
+		 * Struct for a job - a range of samples over the whole image
+		 * ==============================================================
+		 */
+		struct sampleJob
+		{
+			// First sample, and number of samples
+			int firstSample;
+			int sampleCount;
+		};
+
+		/* ==============================================================
+		 * WORKER CONNECTION STRUCT
+		 *
+		 * Struct for a connected worker, and the job it is rendering
+		 * ==============================================================
+		 */
+		struct workerConnection
+		{
+			// Socket of the connection
+			int socket;
+
+			// Job being rendered, or -1 if idle
+			int job;
+		};
+
+		// Image size
+		int _imageWidth;
+		int _imageHeight;
+
+		// Scene, sampler and seeds every worker must match
+		sceneFingerprint _fingerprint;
+
+		// AOV buffers to fill, or null
+		aovBuffers* _aovs;
+
+		// Listening socket
+		int _listener;
+
+		// Every job, the jobs waiting for a worker, and the number not yet done
+		vector<sampleJob> _jobs;
+		deque<int> _pending;
+		int _jobsRemaining;
+
+		// Connected workers
+		vector<workerConnection> _workers;
+
+		// Number of jobs handed out again after their worker was lost, and of workers which connected
+		int _reassigned;
+		int _workersSeen;
+
+		// Sums of the colour, albedo and normal of the finished jobs
+		vector<double> _colour;
+		vector<double> _albedo;
+		vector<double> _normal;
+
+		// Arrays a result is received into
+		vector<float> _floats;
+		vector<int32_t> _integers;
+
+		/*
+		 * OPEN LISTENER FUNCTION
+		 *
+		 * Function opens the listening socket. Returns false, after
+		 * printing the reason, if it cannot
+		 */
+		bool openListener(int port)
+		{
+			// Create the socket, reusable straight after a previous render
+			_listener = socket(AF_INET, SOCK_STREAM, 0);
+			int reuse = 1;
+			setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+			// Local workers only on a free port, or any worker on a chosen one
+			sockaddr_in address = {};
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = htonl(port == 0 ? INADDR_LOOPBACK : INADDR_ANY);
+			address.sin_port = htons(static_cast<uint16_t>(port));
+			if (_listener < 0 || bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(_listener, 64) != 0)
+			{
+				// Port is unavailable
+				cerr << "Coordinator could not listen on port " << port << ": " << strerror(errno) << endl;
+				return false;
+			}
+
+			// Keep the socket from the worker processes
+			fcntl(_listener, F_SETFD, FD_CLOEXEC);
+
+			// Find the port chosen, and output it for remote workers
+			socklen_t length = sizeof(address);
+			getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &length);
+			cout << "Coordinator listening on port " << ntohs(address.sin_port) << endl;
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * START WORKERS FUNCTION
+		 *
+		 * Function starts workerCount copies of the program, told to
+		 * connect back to the coordinator. Their console output is
+		 * discarded, apart from errors. Returns false, after printing
+		 * the reason, if one cannot be started
+		 */
+		bool startWorkers(const vector<string>& workerArguments, int workerCount, vector<pid_t>& children)
+		{
+			// Address of the listening socket
+			sockaddr_in address = {};
+			socklen_t length = sizeof(address);
+			getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &length);
+			string coordinatorAddress = "127.0.0.1:" + to_string(ntohs(address.sin_port));
+
+			// Build the command line
+			vector<string> arguments = workerArguments;
+			arguments.push_back("--worker");
+			arguments.push_back(coordinatorAddress);
+			vector<char*> argv;
+			for (auto& argument : arguments)
+			{
+				argv.push_back(&argument[0]);
+			}
+			argv.push_back(nullptr);
+
+			// Start each worker
+			for (int w = 0; w < workerCount; w++)
+			{
+				pid_t child = fork();
+				if (child < 0)
+				{
+					// Process could not be created
+					cerr << "Could not start worker: " << strerror(errno) << endl;
+					return false;
+				}
+				if (child == 0)
+				{
+					// Worker process - silence its progress, then run the program
+					int devNull = open("/dev/null", O_WRONLY);
+					if (devNull >= 0)
+					{
+						dup2(devNull, STDOUT_FILENO);
+						close(devNull);
+					}
+					execvp(argv[0], argv.data());
+					cerr << "Could not run worker " << argv[0] << ": " << strerror(errno) << endl;
+					_exit(127);
+				}
+				children.push_back(child);
+			}
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * REAP WORKERS FUNCTION
+		 *
+		 * Function forgets the local workers which have exited, waiting
+		 * for all of them if wait is true
+		 */
+		static void reapWorkers(vector<pid_t>& children, bool wait)
+		{
+			// Check each child
+			for (size_t c = 0; c < children.size(); )
+			{
+				int status;
+				pid_t reaped = waitpid(children[c], &status, wait ? 0 : WNOHANG);
+				if (reaped == children[c] || (reaped < 0 && errno != EINTR))
+				{
+					// Child has exited
+					children.erase(children.begin() + c);
+				}
+				else
+				{
+					// Still running
+					c++;
+				}
+			}
+		}
+
+		/*
+		 * STOP WORKERS FUNCTION
+		 *
+		 * Function tells every connected worker to exit, and waits
+		 * for the local workers - any still starting up are told
+		 * to exit as soon as they connect
+		 */
+		void stopWorkers(vector<pid_t>& children)
+		{
+			// Tell each worker to exit - one which has gone already does not matter
+			messageHeader quit = makeHeader(MESSAGE_QUIT);
+			while (true)
+			{
+				for (const auto& worker : _workers)
+				{
+					sendAll(worker.socket, &quit, sizeof(quit));
+					close(worker.socket);
+				}
+				_workers.clear();
+
+				// Check if every local worker has exited
+				reapWorkers(children, false);
+				if (children.empty() || _listener < 0)
+				{
+					break;
+				}
+
+				// Wait for a late worker to connect
+				pollfd polled = { _listener, POLLIN, 0 };
+				if (poll(&polled, 1, 100) > 0)
+				{
+					acceptWorker();
+				}
+			}
+
+			// Close the listener
+			if (_listener >= 0)
+			{
+				close(_listener);
+				_listener = -1;
+			}
+		}
+
+		/*
+		 * ACCEPT WORKER FUNCTION
+		 *
+		 * Function accepts a connecting worker, if its hello matches
+		 * the image and scene being rendered
+		 */
+		void acceptWorker()
+		{
+			// Accept the connection
+			int s = accept(_listener, nullptr, nullptr);
+			if (s < 0)
+			{
+				// Connection was abandoned
+				return;
+			}
+			fcntl(s, F_SETFD, FD_CLOEXEC);
+
+			// Results are large, but jobs are small and should not wait
+			int noDelay = 1;
+			setsockopt(s, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+			// Check the hello
+			messageHeader hello;
+			if (!receiveAll(s, &hello, sizeof(hello)) || hello.magic != distributedMagic || hello.type != MESSAGE_HELLO)
+			{
+				// Not a worker
+				cerr << endl << "Rejected a connection which is not a worker" << endl;
+				close(s);
+				return;
+			}
+			if (hello.imageWidth != static_cast<uint32_t>(_imageWidth) || hello.imageHeight != static_cast<uint32_t>(_imageHeight))
+			{
+				// Worker renders a different image
+				cerr << endl << "Rejected a worker rendering " << hello.imageWidth << "x" << hello.imageHeight << " rather than "
+					<< _imageWidth << "x" << _imageHeight << endl;
+				close(s);
+				return;
+			}
+			if (!sameRender(hello.fingerprint, _fingerprint))
+			{
+				// Worker builds a different scene, or draws different samples - its results would not add up
+				cerr << endl << "Rejected a worker rendering " << describeFingerprint(hello.fingerprint) << " rather than "
+					<< describeFingerprint(_fingerprint) << endl;
+				close(s);
+				return;
+			}
+
+			// Add the worker, idle
+			_workers.push_back(workerConnection{ s, -1 });
+			_workersSeen++;
+		}
+
+		/*
+		 * DROP WORKER FUNCTION
+		 *
+		 * Function closes a worker's connection, putting its job, if
+		 * any, back at the front of the queue
+		 */
+		void dropWorker(int w)
+		{
+			// Requeue the job
+			int job = _workers[w].job;
+			if (job >= 0)
+			{
+				cerr << endl << "Worker lost, reassigning samples " << _jobs[job].firstSample << "-"
+					<< _jobs[job].firstSample + _jobs[job].sampleCount - 1 << endl;
+				_pending.push_front(job);
+				_reassigned++;
+			}
+
+			// Close the connection
+			close(_workers[w].socket);
+			_workers.erase(_workers.begin() + w);
+		}
+
+		/*
+		 * DISPATCH JOBS FUNCTION
+		 *
+		 * Function sends a waiting job to every idle worker
+		 */
+		void dispatchJobs()
+		{
+			// Check each worker, from the back so workers can be removed
+			for (int w = static_cast<int>(_workers.size()) - 1; w >= 0 && !_pending.empty(); w--)
+			{
+				// Skip busy workers
+				if (_workers[w].job >= 0)
+				{
+					continue;
+				}
+
+				// Send the next job
+				int job = _pending.front();
+				_pending.pop_front();
+				_workers[w].job = job;
+				messageHeader message = makeHeader(MESSAGE_JOB);
+				message.job = static_cast<uint32_t>(job);
+				message.firstSample = static_cast<uint32_t>(_jobs[job].firstSample);
+				message.sampleCount = static_cast<uint32_t>(_jobs[job].sampleCount);
+				message.imageWidth = static_cast<uint32_t>(_imageWidth);
+				message.imageHeight = static_cast<uint32_t>(_imageHeight);
+				message.hasAovs = _aovs != nullptr ? 1 : 0;
+				if (!sendAll(_workers[w].socket, &message, sizeof(message)))
+				{
+					// Worker has gone
+					dropWorker(w);
+				}
+			}
+		}
+
+		/*
+		 * RECEIVE RESULT FUNCTION
+		 *
+		 * Function receives the result of a worker's job and adds it
+		 * to the sums. Returns false if the worker has gone, or sent
+		 * something other than the result of its job
+		 */
+		bool receiveResult(workerConnection& worker)
+		{
+			// Receive the header - an idle worker only speaks by closing
+			messageHeader result;
+			if (worker.job < 0 || !receiveAll(worker.socket, &result, sizeof(result)) || result.magic != distributedMagic
+				|| result.type != MESSAGE_RESULT || result.job != static_cast<uint32_t>(worker.job))
+			{
+				// Worker has gone
+				return false;
+			}
+
+			// Receive the pixels
+			const size_t pixelCount = static_cast<size_t>(_imageWidth) * _imageHeight;
+			const int floatsPerPixel = resultColourFloats + (_aovs != nullptr ? resultAovFloats : 0);
+			_floats.resize(pixelCount * floatsPerPixel);
+			_integers.resize(_aovs != nullptr ? pixelCount * resultAovIntegers : 0);
+			if (!receiveAll(worker.socket, _floats.data(), _floats.size() * sizeof(float))
+				|| !receiveAll(worker.socket, _integers.data(), _integers.size() * sizeof(int32_t)))
+			{
+				// Worker has gone mid-result
+				return false;
+			}
+
+			// Add the job - only this worker holds it, so it is added once
+			addResult(_jobs[worker.job]);
+			_jobsRemaining--;
+			cout << "\rJobs remaining: " << _jobsRemaining << ' ' << flush;
+
+			// Worker is idle
+			worker.job = -1;
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * ADD RESULT FUNCTION
+		 *
+		 * Function adds the received result of a job to the sums.
+		 * Depth and the indices come from each pixel's first sample,
+		 * as in a render in one process
+		 */
+		void addResult(const sampleJob& job)
+		{
+			// Add each pixel
+			const size_t pixelCount = static_cast<size_t>(_imageWidth) * _imageHeight;
+			const int floatsPerPixel = resultColourFloats + (_aovs != nullptr ? resultAovFloats : 0);
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				// Colour
+				const float* f = &_floats[i * floatsPerPixel];
+				for (int c = 0; c < 3; c++)
+				{
+					_colour[3 * i + c] += f[c];
+				}
+
+				// AOVs, if any
+				if (_aovs != nullptr)
+				{
+					for (int c = 0; c < 3; c++)
+					{
+						_albedo[3 * i + c] += f[3 + c];
+						_normal[3 * i + c] += f[6 + c];
+					}
+					_aovs->sampleCount[i] += _integers[3 * i + 2];
+
+					// Check if the job holds the pixel's first sample
+					if (job.firstSample == 0)
+					{
+						_aovs->depth[i] = f[9];
+						_aovs->materialIndex[i] = _integers[3 * i];
+						_aovs->objectIndex[i] = _integers[3 * i + 1];
+					}
+				}
+			}
+		}
+};
+
+/*
+ * RUN COORDINATOR FUNCTION
+ *
+ * Function renders an image across worker processes, splitting its
+ * samples per pixel into jobs of jobSamples samples, accepting only
+ * workers with the same fingerprint. Returns false, after printing
+ * the reason, if the render cannot be finished
+ */
+inline bool runCoordinator(const vector<string>& workerArguments, int workerCount, int port, int imageWidth, int imageHeight, const sceneFingerprint& fingerprint,
+	int samplesPerPixel, int jobSamples, vector<colour>& frameBuffer, aovBuffers* aovs)
+{
+	// Render across the workers
+	coordinator render(imageWidth, imageHeight, fingerprint, samplesPerPixel, jobSamples, aovs);
+	return render.run(workerArguments, workerCount, port, frameBuffer);
+}
+
+#else
+
+// **** UNAVAILABLE IMPLEMENTATION **** //
+
+/*
+ * RUN WORKER FUNCTION
+ *
+ * Function reports that distributed rendering needs POSIX sockets
+ */
+template <typename RenderJob>
+bool runWorker(const string& address, int imageWidth, int imageHeight, const sceneFingerprint& fingerprint, RenderJob renderJob)
+{
+	// Unavailable
+	cerr << "Distributed rendering is not available on this platform" << endl;
+	return false;
+}
+
+/*
+ * RUN COORDINATOR FUNCTION
+ *
+ * Function reports that distributed rendering needs POSIX sockets
+ */
+inline bool runCoordinator(const vector<string>& workerArguments, int workerCount, int port, int imageWidth, int imageHeight, const sceneFingerprint& fingerprint,
+	int samplesPerPixel, int jobSamples, vector<colour>& frameBuffer, aovBuffers* aovs)
+{
+	// Unavailable
+	cerr << "Distributed rendering is not available on this platform" << endl;
+	return false;
+}
+
+#endif
+
+// End ifndef directive for DISTRIBUTED_H
+#endif
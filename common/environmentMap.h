@@ -0,0 +1,347 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * ENVIRONMENT MAP HEADER FILE
+ *
+ * Header file containing the environment map class - a high dynamic
+ * range image of the sky, in latitude-longitude layout, seen by rays
+ * which escape the scene. Directions are importance sampled in
+ * proportion to the sky's brightness, so a small bright sun is found
+ * by shadow rays rather than by chance
+ */
+
+// Declare ifndef directive for ENVIRONMENT_MAP_H
+#ifndef ENVIRONMENT_MAP_H
+
+// Define ENVIRONMENT_MAP_H
+#define ENVIRONMENT_MAP_H
+
+// Header files
+#include "common.h"
+#include "sampler.h"
+#include "stb/stb_image.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * ENVIRONMENT MAP CLASS
+ *
+ * Class for an environment map. The top row of the image is
+ * straight up (+y) and the bottom row straight down, and the
+ * columns go once around the horizon. Holds the texels and the
+ * tables used to sample them - a cumulative distribution over each
+ * row, and one over the rows
+ * ==================================================================
+ */
+class environmentMap
+{
+	// Public functions
+	public:
+		/*
+		 * DEFAULT ENVIRONMENT MAP CONSTRUCTOR
+		 *
+		 * When invoked, creates an empty map
+		 */
+		environmentMap() : _width(0), _height(0), _weightSum(0.0f) {}
+
+		/*
+		 * LOAD FUNCTION
+		 *
+		 * Function loads a high dynamic range image (such as a
+		 * Radiance .hdr file) and builds the sampling tables.
+		 * Returns false, after printing the reason, if the image
+		 * cannot be loaded
+		 */
+		bool load(const string& fileName)
+		{
+			// Load the image as floating point RGB
+			int width, height, channels;
+			float* data = stbi_loadf(fileName.c_str(), &width, &height, &channels, 3);
+
+			// Check the image was loaded
+			if (data == nullptr)
+			{
+				// Output the reason
+				cerr << "Could not load environment map " << fileName << ": " << stbi_failure_reason() << endl;
+				return false;
+			}
+
+			// Copy the texels
+			_width = width;
+			_height = height;
+			_texels.resize(width * height);
+			for (int i = 0; i < width * height; i++)
+			{
+				_texels[i] = colour(data[3 * i], data[3 * i + 1], data[3 * i + 2]);
+			}
+
+			// Release the image
+			stbi_image_free(data);
+
+			// Build the sampling tables
+			buildDistribution();
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * LOOKUP FUNCTION
+		 *
+		 * Function returns the radiance arriving from a direction -
+		 * the nearest texel, so no filtering cost
+		 */
+		colour lookup(const vec3& direction) const
+		{
+			// Find the texel and return it
+			int column, row;
+			float sinTheta;
+			directionToTexel(unitVector(direction), column, row, sinTheta);
+			return _texels[row * _width + column];
+		}
+
+		/*
+		 * SAMPLE FUNCTION
+		 *
+		 * Function samples a unit direction in proportion to the
+		 * brightness of the map, returning its solid angle pdf.
+		 * Returns false if the map has no light to sample
+		 */
+		bool sample(const sample2D& u, vec3& direction, float& pdf) const
+		{
+			// Check there is light to sample
+			if (_weightSum <= 0.0f)
+			{
+				// Nothing to sample
+				return false;
+			}
+
+			// Pick a row, then a column within it, keeping where in the texel each sample fell
+			float rowOffset, columnOffset;
+			int row = sampleTable(_marginalCdf.data(), _height, u.y, rowOffset);
+			int column = sampleTable(_conditionalCdf.data() + row * (_width + 1), _width, u.x, columnOffset);
+
+			// Convert to angles
+			float theta = pi * (row + rowOffset) / _height;
+			float phi = 2.0f * pi * (column + columnOffset) / _width;
+			float sinTheta = sin(theta);
+
+			// Check the direction is not at a pole, where the pdf is undefined
+			if (sinTheta <= 0.0f)
+			{
+				// No direction
+				return false;
+			}
+
+			// Build the direction and its pdf
+			direction = vec3(sinTheta * cos(phi), cos(theta), sinTheta * sin(phi));
+			pdf = texelPdf(column, row, sinTheta);
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * PDF FUNCTION
+		 *
+		 * Function returns the solid angle pdf with which sample
+		 * picks a direction
+		 */
+		float pdf(const vec3& direction) const
+		{
+			// Check there is light to sample
+			if (_weightSum <= 0.0f)
+			{
+				// Never sampled
+				return 0.0f;
+			}
+
+			// Find the texel, and return its pdf
+			int column, row;
+			float sinTheta;
+			directionToTexel(unitVector(direction), column, row, sinTheta);
+			return sinTheta > 0.0f ? texelPdf(column, row, sinTheta) : 0.0f;
+		}
+
+		/*
+		 * GET WIDTH FUNCTION
+		 *
+		 * Function returns the width of the map in texels
+		 */
+		int getWidth() const
+		{
+			// Return width
+			return _width;
+		}
+
+		/*
+		 * GET HEIGHT FUNCTION
+		 *
+		 * Function returns the height of the map in texels
+		 */
+		int getHeight() const
+		{
+			// Return height
+			return _height;
+		}
+
+	// Private
+	private:
+		// Size of the map in texels
+		int _width;
+		int _height;
+
+		// Radiance of each texel, top row first
+		vector<colour> _texels;
+
+		// Sampling weight of each texel - brightness times the solid angle it covers
+		vector<float> _weights;
+
+		// Sum of the weights
+		float _weightSum;
+
+		// Cumulative distribution over the columns of each row, _width + 1 entries per row
+		vector<float> _conditionalCdf;
+
+		// Cumulative distribution over the rows, _height + 1 entries
+		vector<float> _marginalCdf;
+
+		/*
+		 * BUILD DISTRIBUTION FUNCTION
+		 *
+		 * Function weights every texel by its mean radiance times
+		 * the sine of its angle from straight up, as rows near the
+		 * poles cover less of the sphere, then builds the
+		 * cumulative distributions
+		 */
+		void buildDistribution()
+		{
+			// Allocate the tables
+			_weights.resize(_width * _height);
+			_conditionalCdf.resize(_height * (_width + 1));
+			_marginalCdf.resize(_height + 1);
+
+			// Sum of the weights of each row
+			vector<float> rowSums(_height);
+
+			// Examine each row
+			for (int row = 0; row < _height; row++)
+			{
+				// Solid angle factor of the row
+				float sinTheta = sin(pi * (row + 0.5f) / _height);
+
+				// Accumulate the row's weights
+				float* cdf = &_conditionalCdf[row * (_width + 1)];
+				cdf[0] = 0.0f;
+				for (int column = 0; column < _width; column++)
+				{
+					// Weight the texel
+					const colour& texel = _texels[row * _width + column];
+					float weight = fmax(0.0f, (texel.getX() + texel.getY() + texel.getZ()) / 3.0f) * sinTheta;
+					_weights[row * _width + column] = weight;
+					cdf[column + 1] = cdf[column] + weight;
+				}
+
+				// Normalise the row, leaving an empty row all zero
+				rowSums[row] = cdf[_width];
+				for (int column = 1; column <= _width; column++)
+				{
+					cdf[column] = rowSums[row] > 0.0f ? cdf[column] / rowSums[row] : 0.0f;
+				}
+			}
+
+			// Accumulate the rows
+			_marginalCdf[0] = 0.0f;
+			for (int row = 0; row < _height; row++)
+			{
+				_marginalCdf[row + 1] = _marginalCdf[row] + rowSums[row];
+			}
+
+			// Normalise the rows
+			_weightSum = _marginalCdf[_height];
+			for (int row = 1; row <= _height; row++)
+			{
+				_marginalCdf[row] = _weightSum > 0.0f ? _marginalCdf[row] / _weightSum : 0.0f;
+			}
+		}
+
+		/*
+		 * SAMPLE TABLE FUNCTION
+		 *
+		 * Function finds the entry of a cumulative distribution with
+		 * count entries (count + 1 values) which sample u falls in,
+		 * and where within the entry it fell
+		 */
+		static int sampleTable(const float* cdf, int count, float u, float& offset)
+		{
+			// Find the last value not above u - entries with no weight are never chosen
+			int index = static_cast<int>(upper_bound(cdf, cdf + count + 1, u) - cdf) - 1;
+			index = max(0, min(index, count - 1));
+
+			// Determine where within the entry the sample fell
+			float width = cdf[index + 1] - cdf[index];
+			offset = width > 0.0f ? fmin((u - cdf[index]) / width, oneMinusEpsilon) : 0.5f;
+
+			// Return the entry
+			return index;
+		}
+
+		/*
+		 * TEXEL PDF FUNCTION
+		 *
+		 * Function returns the solid angle pdf of a direction in a
+		 * texel - its share of the weight, spread evenly over the
+		 * texel's area in the image, converted to solid angle
+		 */
+		float texelPdf(int column, int row, float sinTheta) const
+		{
+			// Density over the unit square of the image, over the area element of the sphere
+			float imagePdf = _weights[row * _width + column] * _width * _height / _weightSum;
+			return imagePdf / (2.0f * pi * pi * sinTheta);
+		}
+
+		/*
+		 * DIRECTION TO TEXEL FUNCTION
+		 *
+		 * Function finds the texel a unit direction points at, and
+		 * the sine of the direction's angle from straight up
+		 */
+		void directionToTexel(const vec3& direction, int& column, int& row, float& sinTheta) const
+		{
+			// Angle from straight up, and around the horizon
+			float cosTheta = clamp(direction.getY(), -1.0f, 1.0f);
+			float theta = acos(cosTheta);
+			float phi = atan2(direction.getZ(), direction.getX());
+			if (phi < 0.0f)
+			{
+				phi += 2.0f * pi;
+			}
+
+			// Find the texel
+			column = min(static_cast<int>(phi / (2.0f * pi) * _width), _width - 1);
+			row = min(static_cast<int>(theta / pi * _height), _height - 1);
+			sinTheta = sqrt(fmax(0.0f, 1.0f - cosTheta * cosTheta));
+		}
+};
+
+// End ifndef directive for ENVIRONMENT_MAP_H
+#endif
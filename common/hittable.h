@@ -4,7 +4,7 @@
  * GRAEME B. WHITE - 40415739
  *
  * DATE OF CREATION: 11/10/2020
- * DATE LAST MODIFIED: 14/10/2020
+ * DATE LAST MODIFIED: 18/10/2026
  * ==================================================================
  * PATH-TRACING PROTOTYPE
  *
@@ -29,10 +29,15 @@
 // Header files
 #include "common.h"
 #include "ray.h"
+#include "aabb.h"
+#include "rayPacket.h"
 
 // Forward declaration of Material class
 class material;
 
+// Forward declaration of Material Table class
+class materialTable;
+
 /*
  * ==================================================================
  * HIT RECORD STRUCT
@@ -51,6 +56,15 @@ struct hitRecord
 	// Material shared pointer
 	shared_ptr<material> materialPointer;
 
+	// Index of the material in the material table
+	int materialIndex;
+
+	// Index of the light hit in the scene lights, or -1
+	int lightIndex;
+
+	// Index of the object hit in the scene, or -1
+	int objectIndex;
+
 	// Ray parameter
 	float t;
 
@@ -109,6 +123,79 @@ class hittable
 		 * Function determines if an object has been hit by a ray
 		 */
 		virtual bool hit(const ray& r, float tMin, float tMax, hitRecord& rec) const = 0;
+
+		/*
+		 * OCCLUDED FUNCTION
+		 *
+		 * Function determines if anything blocks a ray between tMin
+		 * and tMax, as for a shadow ray. Any hit will do, so objects
+		 * override it to stop at the first one without filling in a
+		 * hit record. By default the closest hit is searched for
+		 */
+		virtual bool occluded(const ray& r, float tMin, float tMax) const
+		{
+			// Search for a hit, discarding the record
+			hitRecord rec;
+			return hit(r, tMin, tMax, rec);
+		}
+
+		/*
+		 * BOUNDING BOX FUNCTION
+		 *
+		 * Function obtains the box which bounds the object. Returns
+		 * false if the object cannot be bounded
+		 */
+		virtual bool boundingBox(aabb& outputBox) const = 0;
+
+		/*
+		 * BIND MATERIALS FUNCTION
+		 *
+		 * Function adds the object's materials to a material table,
+		 * so hits can record the material's index in the table
+		 */
+		virtual void bindMaterials(materialTable& table) = 0;
+
+		/*
+		 * SET OBJECT INDEX FUNCTION
+		 *
+		 * Function records the object's index in the scene, so hits
+		 * on it can report which object was hit. Objects which do
+		 * not report it ignore the index
+		 */
+		virtual void setObjectIndex(int index) {}
+
+		/*
+		 * SET CENTRE FUNCTION
+		 *
+		 * Function moves the object so it is centred on a point, for
+		 * animation. Returns false if the object cannot be moved.
+		 * Hierarchies over the object must be rebuilt afterwards
+		 */
+		virtual bool setCentre(const point3& centre) { return false; }
+
+		/*
+		 * HIT PACKET FUNCTION
+		 *
+		 * Function determines which active rays of a packet hit the
+		 * object before their current closest hit, tMax. Lanes which
+		 * hit have tMax, rec and hits updated. By default each lane is
+		 * tested on its own; objects with a vectorised test override it.
+		 * tMax must be 16-byte aligned
+		 */
+		virtual void hitPacket(const rayPacket& packet, float tMin, float tMax[], hitRecord rec[], bool hits[]) const
+		{
+			// Iterate over each lane
+			for (int lane = 0; lane < packetWidth; lane++)
+			{
+				// Check if lane is active and hits the object
+				if (packet.active[lane] && hit(packet.getRay(lane), tMin, tMax[lane], rec[lane]))
+				{
+					// Lane hit, shrink its interval and record the hit
+					tMax[lane] = rec[lane].t;
+					hits[lane] = true;
+				}
+			}
+		}
 };
 
 // End ifndef directive for HITTABLE_H
@@ -4,7 +4,7 @@
  * GRAEME B. WHITE - 40415739
  *
  * DATE OF CREATION: 11/10/2020
- * DATE LAST MODIFIED: 11/10/2020
+ * DATE LAST MODIFIED: 18/10/2026
  * ==================================================================
  * PATH-TRACING PROTOTYPE
  *
@@ -98,6 +98,63 @@ class hittableList : public hittable
 		 */
 		virtual bool hit(const ray& r, float tMin, float tMax, hitRecord& rec) const override;
 
+		/*
+		 * OCCLUDED FUNCTION
+		 *
+		 * Function determines if any object blocks a ray,
+		 * stopping at the first one found
+		 */
+		virtual bool occluded(const ray& r, float tMin, float tMax) const override;
+
+		/*
+		 * BOUNDING BOX FUNCTION
+		 *
+		 * Function obtains the box which bounds every object
+		 * in the list
+		 */
+		virtual bool boundingBox(aabb& outputBox) const override;
+
+		/*
+		 * BIND MATERIALS FUNCTION
+		 *
+		 * Function binds the materials of every object
+		 */
+		virtual void bindMaterials(materialTable& table) override
+		{
+			// Examine each object
+			for (const auto& object : _objects)
+			{
+				// Bind the object's materials
+				object->bindMaterials(table);
+			}
+		}
+
+		/*
+		 * ASSIGN OBJECT INDICES FUNCTION
+		 *
+		 * Function gives every object its index in the list,
+		 * reported by hits on it
+		 */
+		void assignObjectIndices()
+		{
+			// Examine each object
+			for (size_t i = 0; i < _objects.size(); i++)
+			{
+				// Set the object's index
+				_objects[i]->setObjectIndex(static_cast<int>(i));
+			}
+		}
+
+		/*
+		 * GET OBJECTS FUNCTION
+		 *
+		 * Function returns the list of objects
+		 */
+		const vector<shared_ptr<hittable>>& getObjects() const
+		{
+			// Return the object vector
+			return _objects;
+		}
 
 		// Private variables
 	private:
@@ -142,6 +199,68 @@ bool hittableList::hit(const ray& r, float tMin, float tMax, hitRecord& rec) con
 	return hitAnything;
 }
 
+/*
+ * OCCLUDED FUNCTION
+ *
+ * Function determines if any object blocks a ray,
+ * stopping at the first one found
+ */
+bool hittableList::occluded(const ray& r, float tMin, float tMax) const
+{
+	// Examine each object in objects list
+	for (const auto& object : _objects)
+	{
+		// Check if object blocks the ray
+		if (object->occluded(r, tMin, tMax))
+		{
+			// Blocked, no need to look further
+			return true;
+		}
+	}
+
+	// Nothing blocks the ray
+	return false;
+}
+
+/*
+ * BOUNDING BOX FUNCTION
+ *
+ * Function obtains the box which bounds every object
+ * in the list
+ */
+bool hittableList::boundingBox(aabb& outputBox) const
+{
+	// Check if the list is empty
+	if (_objects.empty())
+	{
+		// Nothing to bound
+		return false;
+	}
+
+	// Start from an empty box
+	outputBox = aabb();
+
+	// Examine each object in objects list
+	for (const auto& object : _objects)
+	{
+		// Temporary box
+		aabb tempBox;
+
+		// Check if the object can be bounded
+		if (object->boundingBox(tempBox) == false)
+		{
+			// Object is unbounded, so is the list
+			return false;
+		}
+
+		// Grow the box to fit the object
+		outputBox.grow(tempBox);
+	}
+
+	// Return true
+	return true;
+}
+
 // End ifndef directive of HITTABLE_LIST_H
 #endif
 
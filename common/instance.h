@@ -0,0 +1,178 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * HITTABLE INSTANCE CLASS
+ *
+ * Header file containing the hittable instance class - a placement
+ * of shared geometry, usually a bottom-level BVH, with an affine
+ * transform. Rays are moved into the geometry's object space
+ * rather than the geometry into the world, so any number of
+ * instances share one copy. A BVH over the instances forms the
+ * top level of a two-level hierarchy
+ */
+
+// Declare ifndef directive for INSTANCE_H
+#ifndef INSTANCE_H
+
+// Define INSTANCE_H
+#define INSTANCE_H
+
+// Header files
+#include "hittable.h"
+#include "transform.h"
+
+/* ==================================================================
+ * INSTANCE CLASS
+ *
+ * Class for instance objects. Extension of the hittable abstract
+ * class.
+ *
+ * Ray directions are transformed without normalising, so the ray
+ * parameter of a hit is the same in object and world space
+ * ==================================================================
+ */
+class instance : public hittable
+{
+	// Public
+	public:
+		/*
+		 * INSTANCE CONSTRUCTOR
+		 *
+		 * Creates an instance of object, placed in the world by
+		 * objectToWorld
+		 */
+		instance(shared_ptr<hittable> object, const affineTransform& objectToWorld) :
+			_object(object), _objectToWorld(objectToWorld), _worldToObject(objectToWorld.inverse()), _objectIndex(-1)
+		{
+			// Bound the object in the world once, as the instance does not move
+			aabb objectBox;
+			_hasBounds = _object->boundingBox(objectBox);
+			_worldBounds = _objectToWorld.transformBox(objectBox);
+		}
+
+		/*
+		 * HIT FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Hits the object with the ray moved into object space,
+		 * then moves the hit back into the world
+		 */
+		virtual bool hit(const ray& r, float tMin, float tMax, hitRecord& rec) const override
+		{
+			// Check if the object is hit by the ray in object space
+			if (_object->hit(objectRay(r), tMin, tMax, rec) == false)
+			{
+				// No hit
+				return false;
+			}
+
+			// Move the point into the world - t is unchanged
+			rec.p = r.at(rec.t);
+
+			// Move the normal with the inverse transpose - the side faced is unchanged, as the transform preserves dot products of normals and directions
+			rec.normal = unitVector(_worldToObject.transformNormalByInverse(rec.normal));
+
+			// Report the instance, rather than the object within the shared geometry - instanced lights are not gathered
+			rec.lightIndex = -1;
+			rec.objectIndex = _objectIndex;
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * OCCLUDED FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Determines if the object blocks the ray moved into
+		 * object space
+		 */
+		virtual bool occluded(const ray& r, float tMin, float tMax) const override
+		{
+			// Ask the object, in object space
+			return _object->occluded(objectRay(r), tMin, tMax);
+		}
+
+		/*
+		 * BOUNDING BOX FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Obtains the box which bounds the object's box in the
+		 * world
+		 */
+		virtual bool boundingBox(aabb& outputBox) const override
+		{
+			// Return the world bounds
+			outputBox = _worldBounds;
+			return _hasBounds;
+		}
+
+		/*
+		 * BIND MATERIALS FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Binds the shared object's materials - the table only
+		 * adds each material once, however many instances share it
+		 */
+		virtual void bindMaterials(materialTable& table) override
+		{
+			// Bind the object's materials
+			_object->bindMaterials(table);
+		}
+
+		/*
+		 * SET OBJECT INDEX FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Records the instance's index in the scene
+		 */
+		virtual void setObjectIndex(int index) override
+		{
+			// Record the object's index
+			_objectIndex = index;
+		}
+
+	// Private
+	private:
+		// Shared geometry
+		shared_ptr<hittable> _object;
+
+		// Transforms from object space to the world, and back
+		affineTransform _objectToWorld;
+		affineTransform _worldToObject;
+
+		// Bounds of the instance in the world, and whether the object could be bounded
+		aabb _worldBounds;
+		bool _hasBounds;
+
+		// Index of the instance in the scene, or -1
+		int _objectIndex;
+
+		/*
+		 * OBJECT RAY FUNCTION
+		 *
+		 * Function returns a world ray moved into object space
+		 */
+		ray objectRay(const ray& r) const
+		{
+			// Move the origin as a point, and the direction as a vector
+			return ray(_worldToObject.transformPoint(r.getOrigin()), _worldToObject.transformVector(r.getDirection()), r.getTime());
+		}
+};
+
+// End ifndef directive for INSTANCE_H
+#endif
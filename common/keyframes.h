@@ -0,0 +1,354 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * KEYFRAMES HEADER FILE
+ *
+ * Header file containing the camera settings struct and the keyframe
+ * animation class, read from a text file with one key per line:
+ *
+ *     <frame> lookfrom <x> <y> <z>
+ *     <frame> lookat <x> <y> <z>
+ *     <frame> fov <degrees>
+ *     <frame> aperture <diameter>
+ *     <frame> focus <distance>
+ *     <frame> orbit <degrees>
+ *     <frame> centre <object> <x> <y> <z>
+ *
+ * Each property is a separate track, interpolated linearly between
+ * its keys and held before the first and after the last. Orbit turns
+ * the camera about the vertical axis through the point looked at, so
+ * a turntable needs two keys. Centre moves an object of the scene.
+ * Blank lines and lines starting with # are ignored
+ */
+
+// Declare ifndef directive for KEYFRAMES_H
+#ifndef KEYFRAMES_H
+
+// Define KEYFRAMES_H
+#define KEYFRAMES_H
+
+// Header files
+#include "common.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * CAMERA SETTINGS STRUCT
+ *
+ * Struct containing the settings a camera is created from
+ * ==================================================================
+ */
+struct cameraSettings
+{
+	// Camera looking from
+	point3 lookFrom;
+
+	// Camera look at
+	point3 lookAt;
+
+	// Camera vertical up
+	vec3 verticalUp;
+
+	// Vertical field of view, in degrees
+	float verticalFoV;
+
+	// Camera aperture
+	float aperture;
+
+	// Distance to focus
+	float distanceToFocus;
+};
+
+/* ==================================================================
+ * KEYFRAME ANIMATION CLASS
+ *
+ * Class for a keyframe animation - a track of keys for each camera
+ * property, and for the centre of each object which moves
+ * ==================================================================
+ */
+class keyframeAnimation
+{
+	// Public functions
+	public:
+		/*
+		 * DEFAULT KEYFRAME ANIMATION CONSTRUCTOR
+		 *
+		 * When invoked, creates an animation with no keys
+		 */
+		keyframeAnimation() : _lastFrame(0) {}
+
+		/*
+		 * LOAD FUNCTION
+		 *
+		 * Function reads the keys from a keyframe file. Returns
+		 * false, after printing the file and line, if the file
+		 * cannot be read or a line is not a key
+		 */
+		bool load(const string& fileName)
+		{
+			// Open the file
+			ifstream file(fileName);
+			if (!file)
+			{
+				// File could not be opened
+				cerr << "Could not open keyframe file " << fileName << endl;
+				return false;
+			}
+
+			// Read each line
+			string line;
+			for (int lineNumber = 1; getline(file, line); lineNumber++)
+			{
+				// Skip blank lines and comments
+				istringstream words(line);
+				words >> ws;
+				if (words.eof() || words.peek() == '#')
+				{
+					continue;
+				}
+
+				// Read the frame and property, then the values the property takes
+				int frame;
+				string property;
+				bool valid = static_cast<bool>(words >> frame >> property) && frame >= 0;
+				int object = -1;
+				float x = 0.0f, y = 0.0f, z = 0.0f;
+				if (valid && (property == "lookfrom" || property == "lookat"))
+				{
+					valid = static_cast<bool>(words >> x >> y >> z);
+				}
+				else if (valid && (property == "fov" || property == "aperture" || property == "focus" || property == "orbit"))
+				{
+					valid = static_cast<bool>(words >> x);
+				}
+				else if (valid && property == "centre")
+				{
+					valid = static_cast<bool>(words >> object >> x >> y >> z) && object >= 0;
+				}
+				else
+				{
+					valid = false;
+				}
+
+				// Check nothing follows the values
+				string extra;
+				if (!valid || (words >> extra && extra[0] != '#'))
+				{
+					// Not a key
+					cerr << fileName << ":" << lineNumber << ": expected <frame> <property> <values>, not \"" << line << "\"" << endl;
+					return false;
+				}
+
+				// Add the key to its track
+				addKey(property == "centre" ? _centres[object] : getTrack(property), frame, vec3(x, y, z));
+				_lastFrame = max(_lastFrame, frame);
+			}
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * GET FRAME COUNT FUNCTION
+		 *
+		 * Function returns the number of frames up to and including
+		 * the last key
+		 */
+		int getFrameCount() const
+		{
+			// Return frame count
+			return _lastFrame + 1;
+		}
+
+		/*
+		 * GET CAMERA FUNCTION
+		 *
+		 * Function returns the camera settings at a frame. Properties
+		 * with no keys keep their value in base
+		 */
+		cameraSettings getCamera(int frame, const cameraSettings& base) const
+		{
+			// Evaluate each track
+			cameraSettings settings = base;
+			settings.lookFrom = evaluate(_lookFrom, frame, base.lookFrom);
+			settings.lookAt = evaluate(_lookAt, frame, base.lookAt);
+			settings.verticalFoV = evaluate(_verticalFoV, frame, vec3(base.verticalFoV, 0.0f, 0.0f)).getX();
+			settings.aperture = evaluate(_aperture, frame, vec3(base.aperture, 0.0f, 0.0f)).getX();
+			settings.distanceToFocus = evaluate(_distanceToFocus, frame, vec3(base.distanceToFocus, 0.0f, 0.0f)).getX();
+
+			// Turn the camera about the vertical axis through the point looked at (Rodrigues' rotation)
+			float angle = degreesToRadians(evaluate(_orbit, frame, vec3(0.0f, 0.0f, 0.0f)).getX());
+			vec3 axis = unitVector(settings.verticalUp);
+			vec3 offset = settings.lookFrom - settings.lookAt;
+			offset = cos(angle) * offset + sin(angle) * cross(axis, offset) + (1.0f - cos(angle)) * dot(axis, offset) * axis;
+			settings.lookFrom = settings.lookAt + offset;
+
+			// Return the settings
+			return settings;
+		}
+
+		/*
+		 * GET OBJECT CENTRES FUNCTION
+		 *
+		 * Function returns the index and centre, at a frame, of every
+		 * object with keys
+		 */
+		vector<pair<int, point3>> getObjectCentres(int frame) const
+		{
+			// Evaluate each object's track
+			vector<pair<int, point3>> centres;
+			for (const auto& track : _centres)
+			{
+				centres.push_back(make_pair(track.first, evaluate(track.second, frame, vec3(0.0f, 0.0f, 0.0f))));
+			}
+			return centres;
+		}
+
+	// Private
+	private:
+		/* ==============================================================
+		 * KEY STRUCT
+		 *
+		 * Struct for a key - a value at a frame. Scalar properties
+		 * use the first component
+		 * ==============================================================
+		 */
+		struct key
+		{
+			// Frame of the key
+			int frame;
+
+			// Value at the frame
+			vec3 value;
+		};
+
+		// Camera tracks
+		vector<key> _lookFrom;
+		vector<key> _lookAt;
+		vector<key> _verticalFoV;
+		vector<key> _aperture;
+		vector<key> _distanceToFocus;
+		vector<key> _orbit;
+
+		// Centre tracks, by object index
+		map<int, vector<key>> _centres;
+
+		// Last frame with a key
+		int _lastFrame;
+
+		/*
+		 * GET TRACK FUNCTION
+		 *
+		 * Function returns the camera track of a property
+		 */
+		vector<key>& getTrack(const string& property)
+		{
+			// Check the property
+			if (property == "lookfrom")
+			{
+				return _lookFrom;
+			}
+			else if (property == "lookat")
+			{
+				return _lookAt;
+			}
+			else if (property == "fov")
+			{
+				return _verticalFoV;
+			}
+			else if (property == "aperture")
+			{
+				return _aperture;
+			}
+			else if (property == "focus")
+			{
+				return _distanceToFocus;
+			}
+
+			// Orbit
+			return _orbit;
+		}
+
+		/*
+		 * ADD KEY FUNCTION
+		 *
+		 * Function adds a key to a track, keeping the track ordered by
+		 * frame. A second key at the same frame replaces the first
+		 */
+		static void addKey(vector<key>& track, int frame, const vec3& value)
+		{
+			// Find where the key belongs
+			auto position = lower_bound(track.begin(), track.end(), frame, [](const key& k, int f) { return k.frame < f; });
+			if (position != track.end() && position->frame == frame)
+			{
+				// Replace the key
+				position->value = value;
+			}
+			else
+			{
+				// Insert the key
+				key k;
+				k.frame = frame;
+				k.value = value;
+				track.insert(position, k);
+			}
+		}
+
+		/*
+		 * EVALUATE FUNCTION
+		 *
+		 * Function returns a track's value at a frame, interpolated
+		 * between the keys either side, or fallback if it has no keys
+		 */
+		static vec3 evaluate(const vector<key>& track, int frame, const vec3& fallback)
+		{
+			// Check the track has keys
+			if (track.empty())
+			{
+				// Keep the fallback
+				return fallback;
+			}
+
+			// Hold the first and last keys
+			if (frame <= track.front().frame)
+			{
+				return track.front().value;
+			}
+			if (frame >= track.back().frame)
+			{
+				return track.back().value;
+			}
+
+			// Find the keys either side, and interpolate
+			auto next = upper_bound(track.begin(), track.end(), frame, [](int f, const key& k) { return f < k.frame; });
+			auto previous = next - 1;
+			float t = static_cast<float>(frame - previous->frame) / static_cast<float>(next->frame - previous->frame);
+			return (1.0f - t) * previous->value + t * next->value;
+		}
+};
+
+// End ifndef directive for KEYFRAMES_H
+#endif
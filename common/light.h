@@ -0,0 +1,584 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * LIGHT HEADER FILE
+ *
+ * Header file containing the sphere light class, the scene lights
+ * class, and the direct lighting estimate used for next-event
+ * estimation. At each non-specular hit one light is picked, a point
+ * on it is sampled, and a shadow ray checks it can be seen - so small
+ * bright lights are found on every bounce rather than by chance.
+ * With many lights, the light hierarchy picks the ones likely to
+ * matter at the hit.
+ *
+ * Lights are also found by paths following the material's own
+ * scatter. Both estimates are kept, weighted by the power heuristic
+ * (multiple importance sampling), so each dominates where it has
+ * less variance - light sampling for large lights on rough surfaces,
+ * material sampling for small lights in glossy reflections
+ */
+
+// Declare ifndef directive for LIGHT_H
+#ifndef LIGHT_H
+
+// Define LIGHT_H
+#define LIGHT_H
+
+// Header files
+#include "common.h"
+#include "environmentMap.h"
+#include "hittable.h"
+#include "hittableList.h"
+#include "lightBvh.h"
+#include "material.h"
+#include "sampler.h"
+#include "sky.h"
+#include "sphere.h"
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * SPHERE LIGHT CLASS
+ *
+ * Class for a spherical area light. Directions towards the light are
+ * sampled uniformly within the cone the sphere subtends, which only
+ * produces directions which hit the light
+ * ==================================================================
+ */
+class sphereLight
+{
+	// Public functions
+	public:
+		/*
+		 * SPHERE LIGHT CONSTRUCTOR
+		 *
+		 * When invoked, creates a light with a centre, radius and
+		 * emitted radiance
+		 */
+		sphereLight(const point3& centre, float radius, const colour& radiance) :
+			_centre(centre), _radius(radius), _radiance(radiance) {}
+
+		/*
+		 * SAMPLE FUNCTION
+		 *
+		 * Function samples a unit direction from point p towards the
+		 * light, returning the distance to the light along it and the
+		 * solid angle pdf. Returns false if p is inside the light
+		 */
+		bool sample(const point3& p, const sample2D& u, vec3& direction, float& distance, float& pdf) const
+		{
+			// Vector and squared distance to the centre
+			vec3 toCentre = _centre - p;
+			float distanceSquared = toCentre.lengthSquared();
+			float radiusSquared = _radius * _radius;
+
+			// Check if the point is inside the light
+			if (distanceSquared <= radiusSquared)
+			{
+				// No cone to sample
+				return false;
+			}
+
+			// Determine the cone - 1 - cos is rearranged so it stays accurate for small, distant lights
+			float sinSquaredMax = radiusSquared / distanceSquared;
+			float cosMax = sqrt(fmax(0.0f, 1.0f - sinSquaredMax));
+			float oneMinusCosMax = sinSquaredMax / (1.0f + cosMax);
+
+			// Sample the cone uniformly
+			float oneMinusCos = u.x * oneMinusCosMax;
+			float cosTheta = 1.0f - oneMinusCos;
+			float sinTheta = sqrt(fmax(0.0f, oneMinusCos * (2.0f - oneMinusCos)));
+			float phi = 2.0f * pi * u.y;
+
+			// Build the direction around the axis to the centre
+			vec3 axis = toCentre / sqrt(distanceSquared);
+			vec3 tangent, bitangent;
+			orthonormalBasis(axis, tangent, bitangent);
+			direction = (sinTheta * cos(phi)) * tangent + (sinTheta * sin(phi)) * bitangent + cosTheta * axis;
+
+			// Determine the distance to the near side of the sphere
+			float b = dot(direction, toCentre);
+			float discriminant = b * b - (distanceSquared - radiusSquared);
+			distance = b - sqrt(fmax(0.0f, discriminant));
+
+			// Uniform over the cone's solid angle
+			pdf = 1.0f / (2.0f * pi * oneMinusCosMax);
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * PDF FUNCTION
+		 *
+		 * Function returns the solid angle pdf with which sample
+		 * picks any direction from p which hits the light
+		 */
+		float pdf(const point3& p) const
+		{
+			// Squared distance to the centre
+			float distanceSquared = (_centre - p).lengthSquared();
+			float radiusSquared = _radius * _radius;
+
+			// Check if the point is inside the light
+			if (distanceSquared <= radiusSquared)
+			{
+				// Never sampled
+				return 0.0f;
+			}
+
+			// Determine the cone and return the uniform pdf
+			float sinSquaredMax = radiusSquared / distanceSquared;
+			float oneMinusCosMax = sinSquaredMax / (1.0f + sqrt(fmax(0.0f, 1.0f - sinSquaredMax)));
+			return 1.0f / (2.0f * pi * oneMinusCosMax);
+		}
+
+		/*
+		 * GET RADIANCE FUNCTION
+		 *
+		 * Function returns the emitted radiance
+		 */
+		const colour& getRadiance() const
+		{
+			// Return radiance
+			return _radiance;
+		}
+
+		/*
+		 * GET BOUNDS FUNCTION
+		 *
+		 * Function returns the light's bounds for the light
+		 * hierarchy - its box, its power (pi times the surface
+		 * area times the mean radiance), and a cone holding every
+		 * direction, as the sphere emits from all sides
+		 */
+		lightBounds getBounds() const
+		{
+			// Determine the box and power
+			vec3 extent(_radius, _radius, _radius);
+			float meanRadiance = (_radiance.getX() + _radiance.getY() + _radiance.getZ()) / 3.0f;
+			float power = pi * 4.0f * pi * _radius * _radius * meanRadiance;
+
+			// Full cone of directions, with a spread of 90 degrees as the surface is diffuse
+			return lightBounds(aabb(_centre - extent, _centre + extent), vec3(0.0f, 0.0f, 1.0f), power, -1.0f, 0.0f);
+		}
+
+	// Private variables
+	private:
+		// Centre
+		point3 _centre;
+
+		// Radius
+		float _radius;
+
+		// Emitted radiance
+		colour _radiance;
+};
+
+/* ==================================================================
+ * SCENE LIGHTS CLASS
+ *
+ * Class holding every light of a scene - the sphere lights, and the
+ * sky seen by rays which escape. The sky is an environment map when
+ * one is set, sampled as a light alongside the spheres, and a
+ * gradient otherwise
+ * ==================================================================
+ */
+class sceneLights
+{
+	// Public functions
+	public:
+		/*
+		 * DEFAULT SCENE LIGHTS CONSTRUCTOR
+		 *
+		 * When invoked, creates an empty set of lights with the sky
+		 * at full intensity, picked with the light hierarchy
+		 */
+		sceneLights() : _skyIntensity(1.0f), _environment(nullptr), _useHierarchy(true) {}
+
+		/*
+		 * GATHER FUNCTION
+		 *
+		 * Function adds a light for every sphere in the scene with
+		 * an emissive material, and tells the sphere its index so
+		 * hits on it can find the light. Builds the light hierarchy
+		 * over them. Gathering again, after lights have moved,
+		 * replaces the lights
+		 */
+		void gather(hittableList& scene)
+		{
+			// Forget any lights gathered before
+			_lights.clear();
+
+			// Examine each object
+			for (const auto& object : scene.getObjects())
+			{
+				// Check if the object is an emissive sphere
+				sphere* s = dynamic_cast<sphere*>(object.get());
+				if (s != nullptr && s->getMaterial()->getType() == EMISSIVE_MATERIAL)
+				{
+					// Add the light
+					s->setLightIndex(static_cast<int>(_lights.size()));
+					_lights.push_back(sphereLight(s->getCentre(), fabs(s->getRadius()), s->getMaterial()->getData().emission));
+				}
+			}
+
+			// Build the hierarchy over the lights' bounds
+			vector<lightBounds> bounds;
+			for (const sphereLight& light : _lights)
+			{
+				bounds.push_back(light.getBounds());
+			}
+			_hierarchy.build(bounds);
+		}
+
+		/*
+		 * SET USE HIERARCHY FUNCTION
+		 *
+		 * Function sets if lights are picked with the hierarchy, in
+		 * proportion to their estimated contribution, or uniformly
+		 */
+		void setUseHierarchy(bool useHierarchy)
+		{
+			// Set selection
+			_useHierarchy = useHierarchy;
+		}
+
+		/*
+		 * GET HIERARCHY FUNCTION
+		 *
+		 * Function returns the light hierarchy
+		 */
+		const lightBvh& getHierarchy() const
+		{
+			// Return hierarchy
+			return _hierarchy;
+		}
+
+		/*
+		 * SET SKY INTENSITY FUNCTION
+		 *
+		 * Function scales the sky, so scenes lit by their own lights
+		 * can darken it
+		 */
+		void setSkyIntensity(float intensity)
+		{
+			// Set intensity
+			_skyIntensity = intensity;
+		}
+
+		/*
+		 * SET ENVIRONMENT FUNCTION
+		 *
+		 * Function sets the environment map used as the sky, or
+		 * nullptr for the gradient. The map must outlive the lights
+		 */
+		void setEnvironment(const environmentMap* environment)
+		{
+			// Set environment
+			_environment = environment;
+		}
+
+		/*
+		 * SKY RADIANCE FUNCTION
+		 *
+		 * Function returns the radiance of the sky seen by a ray
+		 * which escapes the scene
+		 */
+		colour skyRadiance(const ray& r) const
+		{
+			// Scaled environment map texel, or sky colour
+			return _skyIntensity * (_environment != nullptr ? _environment->lookup(r.getDirection()) : skyColour(r));
+		}
+
+		/*
+		 * GET LIGHT COUNT FUNCTION
+		 *
+		 * Function returns the number of sphere lights
+		 */
+		int getLightCount() const
+		{
+			// Return the number of lights
+			return static_cast<int>(_lights.size());
+		}
+
+		/*
+		 * HAS LIGHTS FUNCTION
+		 *
+		 * Function returns if there is anything for sampleLight to
+		 * sample - a sphere light or an environment map
+		 */
+		bool hasLights() const
+		{
+			// Check for either
+			return _lights.empty() == false || _environment != nullptr;
+		}
+
+		/*
+		 * SAMPLE LIGHT FUNCTION
+		 *
+		 * Function picks a light with the choice sample, for point p
+		 * on a surface with normal n, then samples a direction
+		 * towards it. The pdf includes the chance of picking the
+		 * light. Returns false if no direction could be sampled
+		 */
+		bool sampleLight(const point3& p, const vec3& n, float choice, const sample2D& u, vec3& direction, float& distance, float& pdf, colour& radiance) const
+		{
+			// Check if the environment map is picked
+			float environmentProbability = getEnvironmentProbability();
+			if (choice < environmentProbability)
+			{
+				// Sample a direction towards the sky
+				if (_environment->sample(u, direction, pdf) == false)
+				{
+					// Map is black
+					return false;
+				}
+
+				// Include the chance of picking the map, and obtain its radiance - the sky is never reached
+				pdf *= environmentProbability;
+				distance = infinity;
+				radiance = _skyIntensity * _environment->lookup(direction);
+
+				// Return true
+				return true;
+			}
+
+			// Check there is a sphere light
+			if (_lights.empty())
+			{
+				// Nothing to sample
+				return false;
+			}
+
+			// Reuse the choice sample for the sphere lights
+			choice = fmin((choice - environmentProbability) / (1.0f - environmentProbability), oneMinusEpsilon);
+
+			// Pick the light
+			int index;
+			float pmf;
+			if (_useHierarchy)
+			{
+				// In proportion to the light's estimated contribution
+				if (_hierarchy.sample(p, n, choice, index, pmf) == false)
+				{
+					// No light reaches the point
+					return false;
+				}
+			}
+			else
+			{
+				// Uniformly
+				int count = static_cast<int>(_lights.size());
+				index = static_cast<int>(choice * count);
+				index = index < count ? index : count - 1;
+				pmf = 1.0f / count;
+			}
+
+			// Sample the light
+			const sphereLight& light = _lights[index];
+			if (light.sample(p, u, direction, distance, pdf) == false)
+			{
+				// Point is inside the light
+				return false;
+			}
+
+			// Include the chance of picking the light, and obtain its radiance
+			pdf *= pmf * (1.0f - environmentProbability);
+			radiance = light.getRadiance();
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * LIGHT PDF FUNCTION
+		 *
+		 * Function returns the solid angle pdf with which sampleLight
+		 * picks a direction from point p, on a surface with normal
+		 * n, which hits the given light
+		 */
+		float lightPdf(const point3& p, const vec3& n, int lightIndex) const
+		{
+			// Chance of picking the light
+			float pmf = _useHierarchy ? _hierarchy.pmf(p, n, lightIndex) : 1.0f / static_cast<float>(_lights.size());
+
+			// Times the chance of not picking the environment map, and the pdf of the direction
+			return pmf > 0.0f ? pmf * (1.0f - getEnvironmentProbability()) * _lights[lightIndex].pdf(p) : 0.0f;
+		}
+
+		/*
+		 * ENVIRONMENT PDF FUNCTION
+		 *
+		 * Function returns the solid angle pdf with which sampleLight
+		 * picks the given direction towards the environment map, or
+		 * 0 if there is no map
+		 */
+		float environmentPdf(const vec3& direction) const
+		{
+			// Chance of picking the map, times the pdf of the direction
+			return _environment != nullptr ? getEnvironmentProbability() * _environment->pdf(direction) : 0.0f;
+		}
+
+	// Private variables
+	private:
+		// Sphere lights
+		vector<sphereLight> _lights;
+
+		// Scale of the sky
+		float _skyIntensity;
+
+		// Environment map used as the sky, or nullptr
+		const environmentMap* _environment;
+
+		// Hierarchy over the sphere lights
+		lightBvh _hierarchy;
+
+		// Pick lights with the hierarchy rather than uniformly
+		bool _useHierarchy;
+
+		/*
+		 * GET ENVIRONMENT PROBABILITY FUNCTION
+		 *
+		 * Function returns the chance sampleLight picks the
+		 * environment map - half the time when there are sphere
+		 * lights too, as the map's power cannot be compared with
+		 * theirs from a single point
+		 */
+		float getEnvironmentProbability() const
+		{
+			// No map, only a map, or both
+			return _environment == nullptr ? 0.0f : (_lights.empty() ? 1.0f : 0.5f);
+		}
+};
+
+/*
+ * POWER HEURISTIC FUNCTION
+ *
+ * Function returns the multiple importance sampling weight of a
+ * sample taken with pdf, against another strategy which would have
+ * taken it with otherPdf. Veach's power heuristic, with a power of 2
+ */
+inline float powerHeuristic(float pdf, float otherPdf)
+{
+	// Square each pdf
+	float squared = pdf * pdf;
+	float otherSquared = otherPdf * otherPdf;
+
+	// Return the weight, or 0 if neither strategy takes the sample
+	return squared + otherSquared > 0.0f ? squared / (squared + otherSquared) : 0.0f;
+}
+
+/*
+ * SAMPLE DIRECT LIGHT FUNCTION
+ *
+ * Function estimates the light arriving directly from the scene's
+ * lights at a hit, tracing a shadow ray to one sampled point and
+ * weighting it against the chance the material's own scatter would
+ * have found it. Works with a material data block or a material
+ * object. Samples come from the bounce's light dimensions
+ */
+template <typename World, typename Material>
+inline colour sampleDirectLight(const World& world, const sceneLights& lights, const ray& rayIn, const hitRecord& rec, const Material& m, sampler& samp, int bounce)
+{
+	// Check there is a light to sample, and the material can be lit by it
+	if (lights.hasLights() == false || isSpecularMaterial(m))
+	{
+		// No direct light
+		return colour(0.0f, 0.0f, 0.0f);
+	}
+
+	// Move the sampler to this bounce's light dimensions
+	samp.setDimension(bounceDimension(bounce) + lightDimensionOffset);
+	float choice = samp.get1D();
+	sample2D u = samp.get2D();
+
+	// Sample a direction towards a light
+	vec3 direction;
+	float distance, lightPdf;
+	colour radiance;
+	if (lights.sampleLight(rec.p, rec.normal, choice, u, direction, distance, lightPdf, radiance) == false)
+	{
+		// No direct light
+		return colour(0.0f, 0.0f, 0.0f);
+	}
+
+	// Check the material scatters light towards the light - also rules out lights behind the surface
+	float scatterPdf = materialPdf(m, rayIn, rec, direction);
+	if (scatterPdf <= 0.0f)
+	{
+		// No light reflected
+		return colour(0.0f, 0.0f, 0.0f);
+	}
+
+	// Check if anything blocks the light - stop just short of it, or run on to infinity for the sky
+	if (world.occluded(ray(rec.p, direction, rayIn.getTime()), 0.001f, distance * 0.999f))
+	{
+		// Light is blocked
+		return colour(0.0f, 0.0f, 0.0f);
+	}
+
+	// BSDF times the cosine and radiance, over the pdf, weighted against material sampling
+	float weight = powerHeuristic(lightPdf, scatterPdf);
+	return (weight / lightPdf) * (evalMaterial(m, rayIn, rec, direction) * radiance);
+}
+
+/*
+ * EMISSION WEIGHT FUNCTION
+ *
+ * Function returns the weight of the emission of a light hit by a
+ * ray scattered with pdf scatterPdf from a surface with normal
+ * scatterNormal, weighted against the chance light sampling at the
+ * ray's origin would have found it. A pdf of 0 marks a camera ray or
+ * a specular scatter, which light sampling cannot reproduce, so the
+ * emission counts in full
+ */
+inline float emissionWeight(const sceneLights& lights, const ray& r, const hitRecord& rec, float scatterPdf, const vec3& scatterNormal)
+{
+	// Check if the light could have been sampled
+	if (scatterPdf <= 0.0f || rec.lightIndex < 0)
+	{
+		// Full weight
+		return 1.0f;
+	}
+
+	// Weight against light sampling from the ray's origin
+	return powerHeuristic(scatterPdf, lights.lightPdf(r.getOrigin(), scatterNormal, rec.lightIndex));
+}
+
+/*
+ * ESCAPED RADIANCE FUNCTION
+ *
+ * Function returns the radiance of the sky seen by a ray which
+ * escapes the scene, scattered with pdf scatterPdf. When the sky is
+ * an environment map, it is weighted against the chance light
+ * sampling would have found the same direction
+ */
+inline colour escapedRadiance(const sceneLights& lights, const ray& r, float scatterPdf)
+{
+	// Weight against sampling the environment map, if it could have been sampled
+	float environmentPdf = scatterPdf > 0.0f ? lights.environmentPdf(r.getDirection()) : 0.0f;
+	float weight = environmentPdf > 0.0f ? powerHeuristic(scatterPdf, environmentPdf) : 1.0f;
+
+	// Return the weighted sky
+	return weight * lights.skyRadiance(r);
+}
+
+// End ifndef directive for LIGHT_H
+#endif
@@ -0,0 +1,775 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * LIGHT BVH HEADER FILE
+ *
+ * Header file containing the light bounds struct and the light
+ * bounding volume hierarchy class, which picks a light for a
+ * shading point in proportion to an estimate of the light it
+ * receives from each.
+ *
+ * Every node bounds the position, emitted power, and emission
+ * directions (a cone) of the lights below it. Sampling walks down
+ * from the root, choosing a child by its importance - power over
+ * squared distance, reduced where the cones or the surface face away
+ * - so with thousands of lights, nearby bright lights above the
+ * surface take almost every shadow ray. After Conty Estevez and
+ * Kulla, "Importance Sampling of Many Lights with Adaptive Tree
+ * Splitting", as described in PBRT, 4th edition
+ */
+
+// Declare ifndef directive for LIGHT_BVH_H
+#ifndef LIGHT_BVH_H
+
+// Define LIGHT_BVH_H
+#define LIGHT_BVH_H
+
+// Header files
+#include "common.h"
+#include "aabb.h"
+#include "sampler.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * LIGHT BOUNDS STRUCT
+ *
+ * Struct bounding a group of lights - the box holding them, their
+ * total power, and the cone of emission directions. Light leaves
+ * within cosThetaO of the axis, and spreads up to a further
+ * cosThetaE from there. A sphere light emits in every direction,
+ * so its cone is the whole sphere of directions
+ * ==================================================================
+ */
+struct lightBounds
+{
+	// Box holding the lights
+	aabb bounds;
+
+	// Axis of the emission cone
+	vec3 axis;
+
+	// Total emitted power
+	float power;
+
+	// Cosine of the cone's half angle, and of the spread beyond it
+	float cosThetaO;
+	float cosThetaE;
+
+	/*
+	 * DEFAULT LIGHT BOUNDS CONSTRUCTOR
+	 *
+	 * When invoked, creates empty bounds with no power
+	 */
+	lightBounds() : axis(0.0f, 0.0f, 1.0f), power(0.0f), cosThetaO(1.0f), cosThetaE(1.0f) {}
+
+	/*
+	 * LIGHT BOUNDS CONSTRUCTOR
+	 *
+	 * When invoked, creates bounds from a box, power, and cone
+	 */
+	lightBounds(const aabb& box, const vec3& coneAxis, float totalPower, float cosO, float cosE) :
+		bounds(box), axis(coneAxis), power(totalPower), cosThetaO(cosO), cosThetaE(cosE) {}
+
+	/*
+	 * IMPORTANCE FUNCTION
+	 *
+	 * Function returns a conservative estimate of the light
+	 * reaching point p, on a surface with normal n, from the
+	 * lights in the bounds. Zero only if no light can arrive
+	 * from above the surface. A zero normal skips the surface
+	 * term
+	 */
+	float importance(const point3& p, const vec3& n) const
+	{
+		// Bounding sphere of the box - its radius is half the box's diagonal
+		point3 centre = bounds.getCentroid();
+		float radiusSquared = (bounds.getMax() - centre).lengthSquared();
+
+		// Distance and direction from the lights to the point
+		vec3 toPoint = p - centre;
+		float distanceSquared = toPoint.lengthSquared();
+		toPoint = distanceSquared > 0.0f ? toPoint / sqrt(distanceSquared) : vec3(0.0f, 0.0f, 0.0f);
+
+		// Half angle of the cone of directions from p which meet the box - every direction from inside it
+		float cosThetaB = distanceSquared > radiusSquared ? safeSqrt(1.0f - radiusSquared / distanceSquared) : -1.0f;
+		float sinThetaB = safeSqrt(1.0f - cosThetaB * cosThetaB);
+
+		// Smallest angle between the direction to p and any emission direction, within the box's spread - no
+		// angle at all when the cone holds every direction
+		float cosThetaP = 1.0f;
+		if (cosThetaO > -1.0f)
+		{
+			// Angle between the direction to p and the cone axis
+			float cosThetaW = dot(axis, toPoint);
+			float sinThetaW = safeSqrt(1.0f - cosThetaW * cosThetaW);
+
+			// Take away the cone's half angle, then the box's spread
+			float sinThetaO = safeSqrt(1.0f - cosThetaO * cosThetaO);
+			float cosThetaX = cosSubtractClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+			float sinThetaX = sinSubtractClamped(sinThetaW, cosThetaW, sinThetaO, cosThetaO);
+			cosThetaP = cosSubtractClamped(sinThetaX, cosThetaX, sinThetaB, cosThetaB);
+		}
+
+		// Check if the point lies outside every emission direction
+		if (cosThetaP <= cosThetaE)
+		{
+			// No light reaches the point
+			return 0.0f;
+		}
+
+		// Power falling off with distance - clamped so points inside or near the box are not overweighted - and
+		// with angle from the cone
+		float estimate = power * cosThetaP / fmax(distanceSquared, sqrt(radiusSquared));
+
+		// Check if the surface is known
+		if (n.lengthSquared() > 0.0f)
+		{
+			// Smallest angle between the normal and any direction to the box - zero once the box is below the surface
+			float cosThetaI = dot(-toPoint, n);
+			float sinThetaI = safeSqrt(1.0f - cosThetaI * cosThetaI);
+			estimate *= fmax(0.0f, cosSubtractClamped(sinThetaI, cosThetaI, sinThetaB, cosThetaB));
+		}
+
+		// Return the estimate
+		return estimate;
+	}
+
+	/*
+	 * UNION FUNCTION
+	 *
+	 * Function returns bounds holding the lights of two bounds.
+	 * The cone is the smallest cone holding both cones
+	 */
+	static lightBounds unionOf(const lightBounds& a, const lightBounds& b)
+	{
+		// Check if either bounds is empty
+		if (a.power == 0.0f)
+		{
+			// Only b
+			return b;
+		}
+		if (b.power == 0.0f)
+		{
+			// Only a
+			return a;
+		}
+
+		// Merge the boxes
+		aabb box = a.bounds;
+		box.grow(b.bounds);
+
+		// Merge the cones
+		vec3 coneAxis;
+		float cosO;
+		mergeCones(a.axis, a.cosThetaO, b.axis, b.cosThetaO, coneAxis, cosO);
+
+		// Return the union
+		return lightBounds(box, coneAxis, a.power + b.power, cosO, fmin(a.cosThetaE, b.cosThetaE));
+	}
+
+	/*
+	 * ORIENTATION MEASURE FUNCTION
+	 *
+	 * Function returns the solid angle measure of the bounds'
+	 * emission directions, including the spread, used to weigh
+	 * splits while building the hierarchy
+	 */
+	float orientationMeasure() const
+	{
+		// Cone and spread angles
+		float thetaO = acos(clamp(cosThetaO, -1.0f, 1.0f));
+		float thetaE = acos(clamp(cosThetaE, -1.0f, 1.0f));
+		float thetaW = fmin(thetaO + thetaE, pi);
+		float sinThetaO = safeSqrt(1.0f - cosThetaO * cosThetaO);
+
+		// Solid angle of the cone, plus the cosine-weighted spread around it
+		return 2.0f * pi * (1.0f - cosThetaO)
+			+ pi / 2.0f * (2.0f * thetaW * sinThetaO - cos(thetaO - 2.0f * thetaW) - 2.0f * thetaO * sinThetaO + cosThetaO);
+	}
+
+	/*
+	 * SAFE SQUARE ROOT FUNCTION
+	 *
+	 * Function returns the square root, treating negative values
+	 * from rounding as 0
+	 */
+	static float safeSqrt(float x)
+	{
+		// Clamp and take the root
+		return sqrt(fmax(0.0f, x));
+	}
+
+	/*
+	 * COS SUBTRACT CLAMPED FUNCTION
+	 *
+	 * Function returns cos(max(0, a - b)) from the sines and
+	 * cosines of a and b
+	 */
+	static float cosSubtractClamped(float sinA, float cosA, float sinB, float cosB)
+	{
+		// Check if b is at least a
+		if (cosA > cosB)
+		{
+			// Angle clamps to 0
+			return 1.0f;
+		}
+
+		// Cosine of the difference
+		return cosA * cosB + sinA * sinB;
+	}
+
+	/*
+	 * SIN SUBTRACT CLAMPED FUNCTION
+	 *
+	 * Function returns sin(max(0, a - b)) from the sines and
+	 * cosines of a and b
+	 */
+	static float sinSubtractClamped(float sinA, float cosA, float sinB, float cosB)
+	{
+		// Check if b is at least a
+		if (cosA > cosB)
+		{
+			// Angle clamps to 0
+			return 0.0f;
+		}
+
+		// Sine of the difference
+		return sinA * cosB - cosA * sinB;
+	}
+
+	/*
+	 * MERGE CONES FUNCTION
+	 *
+	 * Function finds the smallest cone holding two cones, each
+	 * given by its axis and the cosine of its half angle
+	 */
+	static void mergeCones(const vec3& axisA, float cosA, const vec3& axisB, float cosB, vec3& axis, float& cosTheta)
+	{
+		// Half angles of the cones, and the angle between their axes
+		float thetaA = acos(clamp(cosA, -1.0f, 1.0f));
+		float thetaB = acos(clamp(cosB, -1.0f, 1.0f));
+		float thetaD = acos(clamp(dot(axisA, axisB), -1.0f, 1.0f));
+
+		// Check if one cone already holds the other
+		if (fmin(thetaD + thetaB, pi) <= thetaA)
+		{
+			// Cone a
+			axis = axisA;
+			cosTheta = cosA;
+			return;
+		}
+		if (fmin(thetaD + thetaA, pi) <= thetaB)
+		{
+			// Cone b
+			axis = axisB;
+			cosTheta = cosB;
+			return;
+		}
+
+		// Half angle of the merged cone
+		float thetaO = (thetaA + thetaD + thetaB) / 2.0f;
+
+		// Check if the merged cone covers every direction, or the axes are opposite
+		vec3 rotationAxis = cross(axisA, axisB);
+		if (thetaO >= pi || rotationAxis.lengthSquared() == 0.0f)
+		{
+			// Whole sphere of directions
+			axis = axisA;
+			cosTheta = -1.0f;
+			return;
+		}
+
+		// Rotate axis a towards axis b, so both cones fit (Rodrigues' formula)
+		float thetaR = thetaO - thetaA;
+		vec3 k = unitVector(rotationAxis);
+		axis = cos(thetaR) * axisA + sin(thetaR) * cross(k, axisA) + ((1.0f - cos(thetaR)) * dot(k, axisA)) * k;
+		cosTheta = cos(thetaO);
+	}
+};
+
+/* ==================================================================
+ * LIGHT BVH NODE STRUCT
+ *
+ * Struct for a node of the flattened light hierarchy. Interior
+ * nodes store the index of their left child, with the right child
+ * directly after it. Leaf nodes hold a single light, and store its
+ * position in the light order
+ * ==================================================================
+ */
+struct lightBvhNode
+{
+	// Bounds of the node's lights
+	lightBounds bounds;
+
+	// Left child index (interior) or light order position (leaf)
+	int leftFirst;
+
+	// Number of lights - 0 for interior nodes
+	int count;
+};
+
+/* ==================================================================
+ * LIGHT BVH CLASS
+ *
+ * Class for the light hierarchy. Built from the bounds of each
+ * light, it samples a light index for a shading point and returns
+ * the probability of any light being picked there
+ * ==================================================================
+ */
+class lightBvh
+{
+	// Public functions
+	public:
+		/*
+		 * BUILD FUNCTION
+		 *
+		 * Function builds the hierarchy over the bounds of every
+		 * light, replacing any previous hierarchy. Lights are
+		 * referred to by their index in the vector
+		 */
+		void build(const vector<lightBounds>& lights);
+
+		/*
+		 * SAMPLE FUNCTION
+		 *
+		 * Function picks a light for point p on a surface with
+		 * normal n, using one sample u, returning its index and
+		 * the probability it was picked. Returns false if no
+		 * light can reach the point
+		 */
+		bool sample(const point3& p, const vec3& n, float u, int& lightIndex, float& pmf) const;
+
+		/*
+		 * PMF FUNCTION
+		 *
+		 * Function returns the probability with which sample picks
+		 * the given light for point p on a surface with normal n
+		 */
+		float pmf(const point3& p, const vec3& n, int lightIndex) const;
+
+		/*
+		 * GET NODE COUNT FUNCTION
+		 *
+		 * Function returns the number of nodes in the hierarchy
+		 */
+		int getNodeCount() const
+		{
+			// Return the size of the node vector
+			return static_cast<int>(_nodes.size());
+		}
+
+	// Private
+	private:
+		// Flattened nodes, root at index 0
+		vector<lightBvhNode> _nodes;
+
+		// Bounds of each light, by light index
+		vector<lightBounds> _lightBounds;
+
+		// Light indices, reordered so each node covers a contiguous range while building
+		vector<int> _order;
+
+		// Path from the root to each light's leaf, by light index - bit d set if the right child is taken at depth d
+		vector<uint64_t> _trails;
+
+		// Number of bins used when evaluating splits
+		static const int _binCount = 12;
+
+		// Depth past which nodes are split at the median, so every trail fits in 64 bits
+		static const int _medianDepth = 40;
+
+		/*
+		 * SUBDIVIDE FUNCTION
+		 *
+		 * Function splits a node in two, then subdivides the
+		 * children. Trail is the path to the node from the root
+		 */
+		void subdivide(int nodeIndex, int depth, uint64_t trail);
+
+		/*
+		 * FIND BEST SPLIT FUNCTION
+		 *
+		 * Function bins the centroids of a node's lights and
+		 * returns the cheapest split axis and position under the
+		 * surface area orientation heuristic - power, times box
+		 * area, times solid angle of emission, on each side - along
+		 * with its cost
+		 */
+		float findBestSplit(const lightBvhNode& node, int first, int count, int& bestAxis, float& bestPosition) const;
+
+		/*
+		 * RANGE BOUNDS FUNCTION
+		 *
+		 * Function returns the union of the bounds of a range of
+		 * the light order
+		 */
+		lightBounds rangeBounds(int first, int count) const
+		{
+			// Merge the lights' bounds
+			lightBounds result;
+			for (int i = first; i < first + count; i++)
+			{
+				result = lightBounds::unionOf(result, _lightBounds[_order[i]]);
+			}
+
+			// Return the union
+			return result;
+		}
+};
+
+/*
+ * BUILD FUNCTION
+ *
+ * Function builds the hierarchy over the bounds of every
+ * light, replacing any previous hierarchy. Lights are
+ * referred to by their index in the vector
+ */
+void lightBvh::build(const vector<lightBounds>& lights)
+{
+	// Clear the previous hierarchy
+	_nodes.clear();
+	_lightBounds = lights;
+	_order.clear();
+	_trails.assign(lights.size(), 0);
+
+	// Add every light which emits
+	for (int i = 0; i < static_cast<int>(lights.size()); i++)
+	{
+		// Check if the light has any power
+		if (lights[i].power > 0.0f)
+		{
+			// Add light
+			_order.push_back(i);
+		}
+	}
+
+	// Check if there is anything to build
+	if (_order.empty())
+	{
+		// Empty hierarchy
+		return;
+	}
+
+	// Reserve the number of nodes in a binary tree with one light per leaf
+	_nodes.reserve(2 * _order.size() - 1);
+
+	// Create the root node, covering every light
+	lightBvhNode root;
+	root.leftFirst = 0;
+	root.count = static_cast<int>(_order.size());
+	root.bounds = rangeBounds(0, root.count);
+
+	// Add the root node
+	_nodes.push_back(root);
+
+	// Recursively subdivide from the root
+	subdivide(0, 0, 0);
+}
+
+/*
+ * FIND BEST SPLIT FUNCTION
+ *
+ * Function bins the centroids of a node's lights and
+ * returns the cheapest split axis and position under the
+ * surface area orientation heuristic, along with its cost
+ */
+float lightBvh::findBestSplit(const lightBvhNode& node, int first, int count, int& bestAxis, float& bestPosition) const
+{
+	// Best cost found so far
+	float bestCost = infinity;
+
+	// Determine the bounds of the centroids
+	aabb centroidBounds;
+	for (int i = first; i < first + count; i++)
+	{
+		// Grow by the light's centroid
+		centroidBounds.grow(_lightBounds[_order[i]].bounds.getCentroid());
+	}
+
+	// Longest side of the node, used to discourage splitting thin axes
+	vec3 extent = node.bounds.bounds.getMax() - node.bounds.bounds.getMin();
+	float maxExtent = fmax(extent.getX(), fmax(extent.getY(), extent.getZ()));
+
+	// Examine each axis
+	for (int axis = 0; axis < 3; axis++)
+	{
+		// Obtain the extent of the centroids along the axis
+		float boundsMin = centroidBounds.getMin()[axis];
+		float boundsMax = centroidBounds.getMax()[axis];
+
+		// Check if the centroids are all in one plane
+		if (boundsMin == boundsMax)
+		{
+			// Cannot split along this axis
+			continue;
+		}
+
+		// Bins along the axis
+		lightBounds bins[_binCount];
+
+		// Scale from position to bin index
+		float scale = _binCount / (boundsMax - boundsMin);
+
+		// Place each light in its bin
+		for (int i = first; i < first + count; i++)
+		{
+			// Determine the bin index
+			const lightBounds& light = _lightBounds[_order[i]];
+			int bin = min(_binCount - 1, static_cast<int>((light.bounds.getCentroid()[axis] - boundsMin) * scale));
+
+			// Add light to the bin
+			bins[bin] = lightBounds::unionOf(bins[bin], light);
+		}
+
+		// Regularise so splits across a thin axis cost more
+		float thinness = extent[axis] > 0.0f ? maxExtent / extent[axis] : 1.0f;
+
+		// Evaluate the cost of each plane between bins
+		for (int plane = 0; plane < _binCount - 1; plane++)
+		{
+			// Merge the bins on each side
+			lightBounds left, right;
+			for (int bin = 0; bin <= plane; bin++)
+			{
+				left = lightBounds::unionOf(left, bins[bin]);
+			}
+			for (int bin = plane + 1; bin < _binCount; bin++)
+			{
+				right = lightBounds::unionOf(right, bins[bin]);
+			}
+
+			// Check both sides have lights
+			if (left.power == 0.0f || right.power == 0.0f)
+			{
+				// Not a split
+				continue;
+			}
+
+			// Determine the cost
+			float planeCost = thinness * (left.power * left.orientationMeasure() * left.bounds.surfaceArea()
+				+ right.power * right.orientationMeasure() * right.bounds.surfaceArea());
+
+			// Check if this is the cheapest plane so far
+			if (planeCost < bestCost)
+			{
+				// Record the plane
+				bestCost = planeCost;
+				bestAxis = axis;
+				bestPosition = boundsMin + (plane + 1) / scale;
+			}
+		}
+	}
+
+	// Return the best cost
+	return bestCost;
+}
+
+/*
+ * SUBDIVIDE FUNCTION
+ *
+ * Function splits a node in two, then subdivides the
+ * children. Trail is the path to the node from the root
+ */
+void lightBvh::subdivide(int nodeIndex, int depth, uint64_t trail)
+{
+	// Copy of the node - the vector may grow below
+	lightBvhNode node = _nodes[nodeIndex];
+	const int first = node.leftFirst;
+	const int count = node.count;
+
+	// Check if the node holds a single light
+	if (count == 1)
+	{
+		// Leave node as a leaf, and record the light's path
+		_trails[_order[first]] = trail;
+		return;
+	}
+
+	// Find the best split, unless the node is deep enough to need the median
+	int axis = 0;
+	float splitPosition = 0.0f;
+	float splitCost = depth < _medianDepth ? findBestSplit(node, first, count, axis, splitPosition) : infinity;
+
+	// Number of lights in the left child
+	int leftCount = 0;
+
+	// Check if a split was found
+	if (splitCost < infinity)
+	{
+		// Partition the lights about the split position
+		auto middle = partition(_order.begin() + first, _order.begin() + first + count,
+			[&](int light) { return _lightBounds[light].bounds.getCentroid()[axis] < splitPosition; });
+		leftCount = static_cast<int>(middle - (_order.begin() + first));
+	}
+
+	// Check if the split left a side empty
+	if (leftCount == 0 || leftCount == count)
+	{
+		// Split at the median along the node's longest axis
+		vec3 extent = node.bounds.bounds.getMax() - node.bounds.bounds.getMin();
+		axis = extent.getX() > extent.getY() ? (extent.getX() > extent.getZ() ? 0 : 2) : (extent.getY() > extent.getZ() ? 1 : 2);
+		leftCount = count / 2;
+		nth_element(_order.begin() + first, _order.begin() + first + leftCount, _order.begin() + first + count,
+			[&](int a, int b) { return _lightBounds[a].bounds.getCentroid()[axis] < _lightBounds[b].bounds.getCentroid()[axis]; });
+	}
+
+	// Create the children, next to each other
+	int leftIndex = static_cast<int>(_nodes.size());
+	lightBvhNode left;
+	left.leftFirst = first;
+	left.count = leftCount;
+	left.bounds = rangeBounds(first, leftCount);
+	lightBvhNode right;
+	right.leftFirst = first + leftCount;
+	right.count = count - leftCount;
+	right.bounds = rangeBounds(first + leftCount, count - leftCount);
+	_nodes.push_back(left);
+	_nodes.push_back(right);
+
+	// Turn the node into an interior node
+	_nodes[nodeIndex].leftFirst = leftIndex;
+	_nodes[nodeIndex].count = 0;
+
+	// Subdivide the children
+	subdivide(leftIndex, depth + 1, trail);
+	subdivide(leftIndex + 1, depth + 1, trail | (uint64_t(1) << depth));
+}
+
+/*
+ * SAMPLE FUNCTION
+ *
+ * Function picks a light for point p on a surface with
+ * normal n, using one sample u, returning its index and
+ * the probability it was picked. Returns false if no
+ * light can reach the point
+ */
+bool lightBvh::sample(const point3& p, const vec3& n, float u, int& lightIndex, float& pmf) const
+{
+	// Check there is a light
+	if (_nodes.empty())
+	{
+		// Nothing to sample
+		return false;
+	}
+
+	// Start at the root
+	int nodeIndex = 0;
+	pmf = 1.0f;
+
+	// Walk down to a leaf
+	while (_nodes[nodeIndex].count == 0)
+	{
+		// Importance of each child
+		int leftIndex = _nodes[nodeIndex].leftFirst;
+		float leftImportance = _nodes[leftIndex].bounds.importance(p, n);
+		float rightImportance = _nodes[leftIndex + 1].bounds.importance(p, n);
+
+		// Check if any light below can reach the point
+		if (leftImportance == 0.0f && rightImportance == 0.0f)
+		{
+			// No light
+			return false;
+		}
+
+		// Choose a child in proportion to its importance, and reuse the sample
+		float leftProbability = leftImportance / (leftImportance + rightImportance);
+		if (u < leftProbability)
+		{
+			// Left child
+			u = fmin(u / leftProbability, oneMinusEpsilon);
+			pmf *= leftProbability;
+			nodeIndex = leftIndex;
+		}
+		else
+		{
+			// Right child
+			u = fmin((u - leftProbability) / (1.0f - leftProbability), oneMinusEpsilon);
+			pmf *= 1.0f - leftProbability;
+			nodeIndex = leftIndex + 1;
+		}
+	}
+
+	// Check the light can reach the point - only untested if the root is a leaf
+	if (_nodes[nodeIndex].bounds.importance(p, n) == 0.0f)
+	{
+		// No light
+		return false;
+	}
+
+	// Return the leaf's light
+	lightIndex = _order[_nodes[nodeIndex].leftFirst];
+	return true;
+}
+
+/*
+ * PMF FUNCTION
+ *
+ * Function returns the probability with which sample picks
+ * the given light for point p on a surface with normal n
+ */
+float lightBvh::pmf(const point3& p, const vec3& n, int lightIndex) const
+{
+	// Check there is a light
+	if (_nodes.empty() || _lightBounds[lightIndex].power == 0.0f)
+	{
+		// Never picked
+		return 0.0f;
+	}
+
+	// Follow the light's trail from the root
+	uint64_t trail = _trails[lightIndex];
+	int nodeIndex = 0;
+	float probability = 1.0f;
+	while (_nodes[nodeIndex].count == 0)
+	{
+		// Importance of each child
+		int leftIndex = _nodes[nodeIndex].leftFirst;
+		float leftImportance = _nodes[leftIndex].bounds.importance(p, n);
+		float rightImportance = _nodes[leftIndex + 1].bounds.importance(p, n);
+
+		// Check if any light below can reach the point
+		if (leftImportance == 0.0f && rightImportance == 0.0f)
+		{
+			// Never picked
+			return 0.0f;
+		}
+
+		// Take the child on the trail
+		bool right = (trail & 1) != 0;
+		probability *= (right ? rightImportance : leftImportance) / (leftImportance + rightImportance);
+		nodeIndex = leftIndex + (right ? 1 : 0);
+		trail >>= 1;
+	}
+
+	// Check the light can reach the point, as in sample
+	if (_nodes[nodeIndex].bounds.importance(p, n) == 0.0f)
+	{
+		// Never picked
+		return 0.0f;
+	}
+
+	// Return the probability
+	return probability;
+}
+
+// End ifndef directive for LIGHT_BVH_H
+#endif
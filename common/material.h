@@ -4,7 +4,7 @@
  * GRAEME B. WHITE - 40415739
  *
  * DATE OF CREATION: 13/10/2020
- * DATE LAST MODIFIED: 14/10/2020
+ * DATE LAST MODIFIED: 18/10/2026
  * ==================================================================
  * PATH-TRACING PROTOTYPE
  *
@@ -18,9 +18,19 @@
  * MATERIAL HEADER FILE
  *
  * Header file containing an abstract material class,
- * Lambertian diffuse class, and metal class.
+ * Lambertian diffuse class, metal class, dielectric class, and
+ * diffuse light class.
  * 
- * Each class has the necessary functions and variables
+ * Each class has the necessary functions and variables.
+ *
+ * Each material can also be described by a compact material data
+ * block (type tag plus parameters), and shaded through a switch on
+ * the tag rather than a virtual call, so the scatter code of each
+ * material inlines and materials can be shaded in batches by type.
+ *
+ * Materials which scatter over a range of directions also evaluate
+ * their BSDF and pdf for any direction, so light sampling and
+ * material sampling can be combined
  */
 
 #ifndef MATERIAL_H
@@ -28,9 +38,50 @@
 
 // Header file
 #include "common.h"
+#include "hittable.h"
+#include "sampler.h"
+
+/* ==================================================================
+ * MATERIAL TYPE ENUM
+ *
+ * Tag for each type of material, so work can be grouped by
+ * material type
+ * ==================================================================
+ */
+enum materialType
+{
+    LAMBERTIAN_MATERIAL,
+    METAL_MATERIAL,
+    DIELECTRIC_MATERIAL,
+    EMISSIVE_MATERIAL,
+    MATERIAL_TYPE_COUNT
+};
 
-// Forward Declaratioon of Hit Record struct
-struct hitRecord;
+/* ==================================================================
+ * MATERIAL DATA STRUCT
+ *
+ * Compact description of any material - a type tag followed by the
+ * parameters used by that type. Kept in a contiguous array by the
+ * material table
+ * ==================================================================
+ */
+struct materialData
+{
+    // Material type
+    materialType type;
+
+    // Albedo colour - lambertian and metal
+    colour albedo;
+
+    // Fuzz value - metal
+    float fuzz;
+
+    // Index of refraction - dielectric
+    float indexOfRefraction;
+
+    // Emitted radiance - emissive
+    colour emission;
+};
 
 /* ==================================================================
  * ABSTRACT MATERIAL CLASS
@@ -51,7 +102,48 @@ class material
          * Function to determine if a ray will produce a scatter ray upon 
          * collision with an object
          */
-        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered) const = 0;
+        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp) const = 0;
+
+        /*
+         * EVAL FUNCTION
+         *
+         * Function returns the BSDF times the cosine to the normal
+         * for light leaving along direction, for the scatter of
+         * rayIn. Zero for materials which only scatter in a single
+         * direction
+         */
+        virtual colour eval(const ray& rayIn, const hitRecord& rec, const vec3& direction) const = 0;
+
+        /*
+         * PDF FUNCTION
+         *
+         * Function returns the solid angle pdf with which scatter
+         * picks direction. Zero for materials which only scatter
+         * in a single direction
+         */
+        virtual float pdf(const ray& rayIn, const hitRecord& rec, const vec3& direction) const = 0;
+
+        /*
+         * IS SPECULAR FUNCTION
+         *
+         * Function returns true if the material only scatters in a
+         * single direction, so cannot be lit by sampled lights
+         */
+        virtual bool isSpecular() const = 0;
+
+        /*
+         * GET TYPE FUNCTION
+         * 
+         * Function returns the type of the material
+         */
+        virtual materialType getType() const = 0;
+
+        /*
+         * GET DATA FUNCTION
+         * 
+         * Function returns the compact description of the material
+         */
+        virtual materialData getData() const = 0;
 };
 
 /* ==================================================================
@@ -77,30 +169,127 @@ class lambertian : public material
          * SCATTER FUNCTION
          *
          * Function to determine if a ray will produce a scatter ray upon
-         * collision with an object. Contains 3 different approaches
-         * to rendering lambertian material. 2 methods commented out
+         * collision with an object
          */
-        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered) const override 
+        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp) const override 
         {
-            // Obtain scatter direction - simple Lambertian dissuse material
-            //vec3 scatter_direction = rec.normal + randomUnitVector();
-
-            // Obtain scatter direction - simple Lambertian dissuse material
-            //vec3 scatter_direction = rec.normal + randomInUnitSphere();
+            // Scatter with this material's albedo
+            return scatterWith(_albedo, rayIn, rec, attenuation, scattered, samp);
+        }
 
-            // Obtain scatter direction - simple Lambertian dissuse material
-            vec3 scatter_direction = rec.normal + randomInHemisphere(rec.normal);
+        /*
+         * SCATTER WITH FUNCTION
+         *
+         * Function to determine if a ray will produce a scatter ray upon
+         * collision with a Lambertian material of the given albedo. The
+         * direction is sampled in proportion to the cosine to the normal,
+         * so the attenuation is simply the albedo
+         */
+        static bool scatterWith(const colour& albedo, const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp)
+        {
+            // Obtain scatter direction - cosine-weighted about the normal, the exact Lambertian distribution
+            vec3 scatter_direction = sampleCosineHemisphere(rec.normal, samp.get2D());
 
             // Obtain the scattered ray
-            scattered = ray(rec.p, scatter_direction);
+            scattered = ray(rec.p, scatter_direction, rayIn.getTime());
 
             // Set the albedo colour
-            attenuation = _albedo;
+            attenuation = albedo;
 
             // Return true
             return true;
         }
 
+        /*
+         * EVAL FUNCTION
+         *
+         * Function returns the BSDF times the cosine to the normal
+         */
+        virtual colour eval(const ray& rayIn, const hitRecord& rec, const vec3& direction) const override
+        {
+            // Evaluate with this material's albedo
+            return evalWith(_albedo, rayIn, rec, direction);
+        }
+
+        /*
+         * EVAL WITH FUNCTION
+         *
+         * Function returns the BSDF times the cosine to the normal for
+         * a Lambertian material of the given albedo - albedo / pi times
+         * the cosine
+         */
+        static colour evalWith(const colour& albedo, const ray& rayIn, const hitRecord& rec, const vec3& direction)
+        {
+            // Scale the albedo by the cosine-weighted pdf
+            return pdfWith(rayIn, rec, direction) * albedo;
+        }
+
+        /*
+         * PDF FUNCTION
+         *
+         * Function returns the solid angle pdf of a scattered direction
+         */
+        virtual float pdf(const ray& rayIn, const hitRecord& rec, const vec3& direction) const override
+        {
+            // Pdf does not depend on the albedo
+            return pdfWith(rayIn, rec, direction);
+        }
+
+        /*
+         * PDF WITH FUNCTION
+         *
+         * Function returns the solid angle pdf of a scattered direction
+         * for a Lambertian material - the cosine over pi above the
+         * surface, zero below it
+         */
+        static float pdfWith(const ray& rayIn, const hitRecord& rec, const vec3& direction)
+        {
+            // Determine the cosine to the normal
+            float cosine = dot(unitVector(direction), rec.normal);
+
+            // Return the cosine-weighted pdf
+            return cosine > 0.0f ? cosine / pi : 0.0f;
+        }
+
+        /*
+         * IS SPECULAR FUNCTION
+         *
+         * Function returns false, as diffuse light leaves in every
+         * direction
+         */
+        virtual bool isSpecular() const override
+        {
+            // Not specular
+            return false;
+        }
+
+        /*
+         * GET TYPE FUNCTION
+         * 
+         * Function returns the type of the material
+         */
+        virtual materialType getType() const override
+        {
+            // Return the material type
+            return LAMBERTIAN_MATERIAL;
+        }
+
+        /*
+         * GET DATA FUNCTION
+         * 
+         * Function returns the compact description of the material
+         */
+        virtual materialData getData() const override
+        {
+            // Fill the data block
+            materialData data = materialData();
+            data.type = LAMBERTIAN_MATERIAL;
+            data.albedo = _albedo;
+
+            // Return the data block
+            return data;
+        }
+
     // Private variables
     private:
         // Albedo colour
@@ -133,21 +322,183 @@ class metal : public material
          * Function to determine if a ray will produce a scatter ray upon
          * collision with an object
          */
-        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered) const override
+        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp) const override
+        {
+            // Scatter with this material's albedo and fuzz
+            return scatterWith(_albedo, _fuzz, rayIn, rec, attenuation, scattered, samp);
+        }
+
+        /*
+         * SCATTER WITH FUNCTION
+         *
+         * Function to determine if a ray will produce a scatter ray upon
+         * collision with a metal material of the given albedo and fuzz.
+         * A fuzz of 0 is a perfect mirror, otherwise the direction is
+         * sampled from a Phong lobe about the mirror direction, which
+         * narrows as the fuzz falls
+         */
+        static bool scatterWith(const colour& albedo, float fuzz, const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp)
         {
             // Obtain the reflected vector
             vec3 reflected = reflect(unitVector(rayIn.getDirection()), rec.normal);
 
+            // Set the attenuation - the lobe is the pdf scaled by the albedo, so every sample carries the albedo
+            attenuation = albedo;
+
+            // Check if the metal is a perfect mirror
+            if (fuzz <= 0.0f)
+            {
+                // Reflect about the normal
+                scattered = ray(rec.p, reflected, rayIn.getTime());
+                return (dot(scattered.getDirection(), rec.normal) > 0);
+            }
+
+            // Obtain the direction sample
+            sample2D u = samp.get2D();
+
+            // Sample the angle to the mirror direction from the cosine power lobe
+            float exponent = phongExponent(fuzz);
+            float cosAlpha = pow(u.x, 1.0f / (exponent + 1.0f));
+            float sinAlpha = sqrt(fmax(0.0f, 1.0f - cosAlpha * cosAlpha));
+            float phi = 2.0f * pi * u.y;
+
+            // Build the direction around the mirror direction
+            vec3 tangent, bitangent;
+            orthonormalBasis(reflected, tangent, bitangent);
+            vec3 direction = (sinAlpha * cos(phi)) * tangent + (sinAlpha * sin(phi)) * bitangent + cosAlpha * reflected;
+
             // Obtain the scattered ray
-            scattered = ray(rec.p, reflected + _fuzz * randomInHemisphere(rec.normal));
-            
-            // Set the attenuation
-            attenuation = _albedo;
+            scattered = ray(rec.p, direction, rayIn.getTime());
 
             // Return true if the scattered ray is in the same hemisphere as the normal
             return (dot(scattered.getDirection(), rec.normal) > 0);
         }
 
+        /*
+         * EVAL FUNCTION
+         *
+         * Function returns the BSDF times the cosine to the normal
+         */
+        virtual colour eval(const ray& rayIn, const hitRecord& rec, const vec3& direction) const override
+        {
+            // Evaluate with this material's albedo and fuzz
+            return evalWith(_albedo, _fuzz, rayIn, rec, direction);
+        }
+
+        /*
+         * EVAL WITH FUNCTION
+         *
+         * Function returns the BSDF times the cosine to the normal for
+         * a metal material of the given albedo and fuzz - the lobe's
+         * pdf scaled by the albedo
+         */
+        static colour evalWith(const colour& albedo, float fuzz, const ray& rayIn, const hitRecord& rec, const vec3& direction)
+        {
+            // Scale the albedo by the lobe's pdf
+            return pdfWith(fuzz, rayIn, rec, direction) * albedo;
+        }
+
+        /*
+         * PDF FUNCTION
+         *
+         * Function returns the solid angle pdf of a scattered direction
+         */
+        virtual float pdf(const ray& rayIn, const hitRecord& rec, const vec3& direction) const override
+        {
+            // Pdf of this material's lobe
+            return pdfWith(_fuzz, rayIn, rec, direction);
+        }
+
+        /*
+         * PDF WITH FUNCTION
+         *
+         * Function returns the solid angle pdf of a scattered direction
+         * for a metal material of the given fuzz. Zero for a perfect
+         * mirror, and below the surface
+         */
+        static float pdfWith(float fuzz, const ray& rayIn, const hitRecord& rec, const vec3& direction)
+        {
+            // Check if the metal is a perfect mirror
+            if (fuzz <= 0.0f)
+            {
+                // Single direction
+                return 0.0f;
+            }
+
+            // Check the direction is above the surface
+            vec3 unitDirection = unitVector(direction);
+            if (dot(unitDirection, rec.normal) <= 0.0f)
+            {
+                // Absorbed
+                return 0.0f;
+            }
+
+            // Determine the cosine to the mirror direction
+            vec3 reflected = reflect(unitVector(rayIn.getDirection()), rec.normal);
+            float cosAlpha = dot(unitDirection, reflected);
+            if (cosAlpha <= 0.0f)
+            {
+                // Outside the lobe
+                return 0.0f;
+            }
+
+            // Normalised cosine power lobe
+            float exponent = phongExponent(fuzz);
+            return (exponent + 1.0f) / (2.0f * pi) * pow(cosAlpha, exponent);
+        }
+
+        /*
+         * IS SPECULAR FUNCTION
+         *
+         * Function returns true if the metal is a perfect mirror
+         */
+        virtual bool isSpecular() const override
+        {
+            // Specular without fuzz
+            return _fuzz <= 0.0f;
+        }
+
+        /*
+         * PHONG EXPONENT FUNCTION
+         *
+         * Function converts a fuzz value to the exponent of the Phong
+         * lobe, treating fuzz as a roughness - 2 / fuzz^2 - 2, which
+         * gives a uniform lobe at a fuzz of 1
+         */
+        static float phongExponent(float fuzz)
+        {
+            // Determine and return the exponent
+            return 2.0f / (fuzz * fuzz) - 2.0f;
+        }
+
+        /*
+         * GET TYPE FUNCTION
+         * 
+         * Function returns the type of the material
+         */
+        virtual materialType getType() const override
+        {
+            // Return the material type
+            return METAL_MATERIAL;
+        }
+
+        /*
+         * GET DATA FUNCTION
+         * 
+         * Function returns the compact description of the material
+         */
+        virtual materialData getData() const override
+        {
+            // Fill the data block
+            materialData data = materialData();
+            data.type = METAL_MATERIAL;
+            data.albedo = _albedo;
+            data.fuzz = _fuzz;
+
+            // Return the data block
+            return data;
+        }
+
     // Private varialbes
     public:
         // Albedo colour
@@ -182,10 +533,26 @@ class dielectric : public material
          * Function determines if a scatter ray is created when a ray 
          * collides with the object
          */
-        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered) const override
+        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp) const override
+        {
+            // Scatter with this material's index of refraction
+            return scatterWith(_indexOfRefraction, rayIn, rec, attenuation, scattered, samp);
+        }
+
+        /*
+         * SCATTER WITH FUNCTION
+         * 
+         * Function determines if a scatter ray is created when a ray 
+         * collides with a dielectric material of the given index of
+         * refraction. The ray is reflected with the Fresnel
+         * reflectance as its chance, or always past the critical
+         * angle, and refracted otherwise - only the chosen direction
+         * is built
+         */
+        static bool scatterWith(float indexOfRefraction, const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp)
         {
             // Set attenuation colour
-            attenuation = colour(1.0, 1.0, 1.0);
+            attenuation = colour(1.0f, 1.0f, 1.0f);
 
             // Determine the Refraction ratio
             float refractionRatio;
@@ -194,54 +561,106 @@ class dielectric : public material
             if (rec.frontFace == true)
             {
                 // Front face hit, determine the ratio between air and dielectric material
-                refractionRatio = 1.0 / _indexOfRefraction;
+                refractionRatio = 1.0f / indexOfRefraction;
             }
             else
             {
                 // Front face not hit, set refraction ratio to index of refraction (ray inside material)
-                refractionRatio = _indexOfRefraction;
+                refractionRatio = indexOfRefraction;
             }
 
             // Obtain the unit direction based on the ray
             vec3 unitDirection = unitVector(rayIn.getDirection());
 
             // Determine Cos Theta
-            double cosTheta = fmin(dot(-unitDirection, rec.normal), 1.0);
+            float cosTheta = fmin(dot(-unitDirection, rec.normal), 1.0f);
 
-            // Determine Sin of Theta
-            double sinTheta = sqrt(1.0 - cosTheta * cosTheta);
+            // Determine Sin squared of the refracted angle, from Snell's law
+            float sinThetaTSquared = refractionRatio * refractionRatio * (1.0f - cosTheta * cosTheta);
 
-            // Obtain the value of Cannot Refract
-            bool cannotRefract = refractionRatio * sinTheta > 1.0;
-            
-            // Empty direction vector
-            vec3 direction;
+            // Obtain the value of Cannot Refract - total internal reflection
+            bool cannotRefract = sinThetaTSquared > 1.0f;
 
-            // Check if ray cannot be refracted or if reflectances is greater than a random float between 0 and 1
-            if (cannotRefract || reflectance(cosTheta, refractionRatio) > randomFloat())
+            // Check if ray cannot be refracted or if reflectances is greater than a sample between 0 and 1
+            if (cannotRefract || reflectance(cosTheta, refractionRatio) > samp.get1D())
             {
                 // Cannot refract, obtain reflection
-                direction = reflect(unitDirection, rec.normal);
+                scattered = ray(rec.p, reflect(unitDirection, rec.normal), rayIn.getTime());
             }
             else
             {
-                // Can refract, obtain refraction
-                direction = refract(unitDirection, rec.normal, refractionRatio);
+                // Can refract, build the refraction from the angles already known
+                vec3 perpendicular = refractionRatio * (unitDirection + cosTheta * rec.normal);
+                vec3 parallel = -sqrt(1.0f - sinThetaTSquared) * rec.normal;
+                scattered = ray(rec.p, perpendicular + parallel, rayIn.getTime());
             }
 
-            // Obtain the scattered ray
-            scattered = ray(rec.p, direction);
+            // Return true
+            return true;
+        }
 
-            // Obtain the refracted ray
-            vec3 refracted = refract(unitDirection, rec.normal, refractionRatio);
+        /*
+         * EVAL FUNCTION
+         *
+         * Function returns zero, as glass only reflects or refracts
+         * in a single direction
+         */
+        virtual colour eval(const ray& rayIn, const hitRecord& rec, const vec3& direction) const override
+        {
+            // No light from sampled directions
+            return colour(0.0, 0.0, 0.0);
+        }
 
-            // Determine the scattered ray
-            scattered = ray(rec.p, refracted);
+        /*
+         * PDF FUNCTION
+         *
+         * Function returns zero, as glass only reflects or refracts
+         * in a single direction
+         */
+        virtual float pdf(const ray& rayIn, const hitRecord& rec, const vec3& direction) const override
+        {
+            // Single direction
+            return 0.0f;
+        }
 
-            // Return true
+        /*
+         * IS SPECULAR FUNCTION
+         *
+         * Function returns true, as glass is specular
+         */
+        virtual bool isSpecular() const override
+        {
+            // Specular
             return true;
         }
 
+        /*
+         * GET TYPE FUNCTION
+         * 
+         * Function returns the type of the material
+         */
+        virtual materialType getType() const override
+        {
+            // Return the material type
+            return DIELECTRIC_MATERIAL;
+        }
+
+        /*
+         * GET DATA FUNCTION
+         * 
+         * Function returns the compact description of the material
+         */
+        virtual materialData getData() const override
+        {
+            // Fill the data block
+            materialData data = materialData();
+            data.type = DIELECTRIC_MATERIAL;
+            data.indexOfRefraction = _indexOfRefraction;
+
+            // Return the data block
+            return data;
+        }
+
     // Private functions
     private:
 
@@ -256,15 +675,292 @@ class dielectric : public material
         static float reflectance(float cosine, float refractanceIndex)
         {
             // Determine value of r0
-            auto r0 = (1 - refractanceIndex) / (1 + refractanceIndex);
+            float r0 = (1.0f - refractanceIndex) / (1.0f + refractanceIndex);
 
             // Determine value of r0 squared
-            auto r0Squared = r0 * r0;
+            float r0Squared = r0 * r0;
+
+            // Determine (1 - cosine) to the fifth power by multiplication
+            float m = 1.0f - cosine;
+            float m2 = m * m;
 
             // Return 
-            return r0Squared + (1 - r0Squared) * pow((1 - cosine), 5);
+            return r0Squared + (1.0f - r0Squared) * (m2 * m2 * m);
+        }
+};
+
+/* ==================================================================
+ * DIFFUSE LIGHT CLASS
+ *
+ * Emissive material class, which emits the same radiance in every
+ * direction from the front face and scatters nothing. Spheres with
+ * this material are gathered as area lights
+ * ==================================================================
+ */
+class diffuseLight : public material
+{
+    // Public functions
+    public:
+        /*
+         * DIFFUSE LIGHT CONSTRUCTOR
+         * 
+         * When invoked, creates a diffuse light material and sets
+         * the emitted radiance
+         */
+        diffuseLight(const colour& e)
+                : _emission(e) {}
+
+        /*
+         * SCATTER FUNCTION
+         *
+         * Function returns false, as a light absorbs every ray
+         */
+        virtual bool scatter(const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp) const override
+        {
+            // No scattered ray
+            return false;
+        }
+
+        /*
+         * EVAL FUNCTION
+         *
+         * Function returns zero, as a light scatters nothing
+         */
+        virtual colour eval(const ray& rayIn, const hitRecord& rec, const vec3& direction) const override
+        {
+            // No scattered light
+            return colour(0.0, 0.0, 0.0);
+        }
+
+        /*
+         * PDF FUNCTION
+         *
+         * Function returns zero, as a light scatters nothing
+         */
+        virtual float pdf(const ray& rayIn, const hitRecord& rec, const vec3& direction) const override
+        {
+            // No scattered directions
+            return 0.0f;
+        }
+
+        /*
+         * IS SPECULAR FUNCTION
+         *
+         * Function returns true, so lights are never lit by other lights
+         */
+        virtual bool isSpecular() const override
+        {
+            // Not lit by sampled lights
+            return true;
+        }
+
+        /*
+         * GET TYPE FUNCTION
+         * 
+         * Function returns the type of the material
+         */
+        virtual materialType getType() const override
+        {
+            // Return the material type
+            return EMISSIVE_MATERIAL;
+        }
+
+        /*
+         * GET DATA FUNCTION
+         * 
+         * Function returns the compact description of the material
+         */
+        virtual materialData getData() const override
+        {
+            // Fill the data block
+            materialData data = materialData();
+            data.type = EMISSIVE_MATERIAL;
+            data.emission = _emission;
+
+            // Return the data block
+            return data;
         }
+
+    // Private variables
+    private:
+        // Emitted radiance
+        colour _emission;
 };
 
+/*
+ * SCATTER MATERIAL FUNCTION
+ *
+ * Function determines if a ray will produce a scatter ray upon
+ * collision with the material described by a data block. Dispatches
+ * on the type tag, so each material's code can be inlined
+ */
+inline bool scatterMaterial(const materialData& data, const ray& rayIn, const hitRecord& rec, colour& attenuation, ray& scattered, sampler& samp)
+{
+    // Check the material type
+    switch (data.type)
+    {
+        case LAMBERTIAN_MATERIAL:
+            // Lambertian diffuse
+            return lambertian::scatterWith(data.albedo, rayIn, rec, attenuation, scattered, samp);
+
+        case METAL_MATERIAL:
+            // Metal
+            return metal::scatterWith(data.albedo, data.fuzz, rayIn, rec, attenuation, scattered, samp);
+
+        case DIELECTRIC_MATERIAL:
+            // Dielectric
+            return dielectric::scatterWith(data.indexOfRefraction, rayIn, rec, attenuation, scattered, samp);
+
+        case EMISSIVE_MATERIAL:
+            // Light, absorbs the ray
+            return false;
+
+        default:
+            // Unknown material, absorb the ray
+            return false;
+    }
+}
+
+/*
+ * EVAL MATERIAL FUNCTION
+ *
+ * Function returns the BSDF times the cosine to the normal for the
+ * material described by a data block, for light leaving along
+ * direction
+ */
+inline colour evalMaterial(const materialData& data, const ray& rayIn, const hitRecord& rec, const vec3& direction)
+{
+    // Check the material type
+    switch (data.type)
+    {
+        case LAMBERTIAN_MATERIAL:
+            // Lambertian diffuse
+            return lambertian::evalWith(data.albedo, rayIn, rec, direction);
+
+        case METAL_MATERIAL:
+            // Metal
+            return metal::evalWith(data.albedo, data.fuzz, rayIn, rec, direction);
+
+        default:
+            // Dielectrics, lights, and unknown materials scatter no sampled light
+            return colour(0.0, 0.0, 0.0);
+    }
+}
+
+/*
+ * EVAL MATERIAL FUNCTION
+ *
+ * Function returns the BSDF times the cosine to the normal for a
+ * material, through the virtual eval function
+ */
+inline colour evalMaterial(const material& m, const ray& rayIn, const hitRecord& rec, const vec3& direction)
+{
+    // Virtual call
+    return m.eval(rayIn, rec, direction);
+}
+
+/*
+ * MATERIAL PDF FUNCTION
+ *
+ * Function returns the solid angle pdf with which the material
+ * described by a data block scatters along direction
+ */
+inline float materialPdf(const materialData& data, const ray& rayIn, const hitRecord& rec, const vec3& direction)
+{
+    // Check the material type
+    switch (data.type)
+    {
+        case LAMBERTIAN_MATERIAL:
+            // Lambertian diffuse
+            return lambertian::pdfWith(rayIn, rec, direction);
+
+        case METAL_MATERIAL:
+            // Metal
+            return metal::pdfWith(data.fuzz, rayIn, rec, direction);
+
+        default:
+            // Dielectrics, lights, and unknown materials have no pdf
+            return 0.0f;
+    }
+}
+
+/*
+ * MATERIAL PDF FUNCTION
+ *
+ * Function returns the solid angle pdf with which a material
+ * scatters along direction, through the virtual pdf function
+ */
+inline float materialPdf(const material& m, const ray& rayIn, const hitRecord& rec, const vec3& direction)
+{
+    // Virtual call
+    return m.pdf(rayIn, rec, direction);
+}
+
+/*
+ * IS SPECULAR MATERIAL FUNCTION
+ *
+ * Function returns true if the material described by a data block
+ * only scatters in a single direction
+ */
+inline bool isSpecularMaterial(const materialData& data)
+{
+    // Diffuse and fuzzy metal surfaces can be lit by sampled lights
+    return !(data.type == LAMBERTIAN_MATERIAL || (data.type == METAL_MATERIAL && data.fuzz > 0.0f));
+}
+
+/*
+ * IS SPECULAR MATERIAL FUNCTION
+ *
+ * Function returns true if a material only scatters in a single
+ * direction, through the virtual function
+ */
+inline bool isSpecularMaterial(const material& m)
+{
+    // Virtual call
+    return m.isSpecular();
+}
+
+/*
+ * MATERIAL ALBEDO FUNCTION
+ *
+ * Function returns the albedo of the material described by a data
+ * block, as seen by the denoiser - the fraction of light it
+ * reflects. Glass passes light through unchanged, so its albedo is
+ * white. A light's albedo is its emission, which sets it apart from
+ * the surfaces around it
+ */
+inline colour materialAlbedo(const materialData& data)
+{
+    // Check the material type
+    switch (data.type)
+    {
+        case LAMBERTIAN_MATERIAL:
+        case METAL_MATERIAL:
+            // Diffuse and metal surfaces tint the light
+            return data.albedo;
+
+        case EMISSIVE_MATERIAL:
+            // Lights
+            return data.emission;
+
+        default:
+            // Dielectrics and unknown materials
+            return colour(1.0, 1.0, 1.0);
+    }
+}
+
+/*
+ * MATERIAL ALBEDO FUNCTION
+ *
+ * Function returns the albedo of a material, from its data block.
+ * Only called once per camera ray, so the virtual call does not
+ * matter
+ */
+inline colour materialAlbedo(const material& m)
+{
+    // Albedo of the material's data block
+    return materialAlbedo(m.getData());
+}
+
 // End ifndef directive for MATERIAL_H
 #endif
\ No newline at end of file
@@ -0,0 +1,109 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * MATERIAL TABLE HEADER FILE
+ *
+ * Header file containing the material table class, which holds the
+ * compact data block of every material in a scene in one contiguous
+ * array. Objects refer to their material by index into the table
+ */
+
+// Declare ifndef directive for MATERIAL_TABLE_H
+#ifndef MATERIAL_TABLE_H
+
+// Define MATERIAL_TABLE_H
+#define MATERIAL_TABLE_H
+
+// Header files
+#include "material.h"
+#include <map>
+#include <memory>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * MATERIAL TABLE CLASS
+ *
+ * Class for the material table. Contains the data blocks and the
+ * functions for adding and looking up materials
+ * ==================================================================
+ */
+class materialTable
+{
+	// Public functions
+	public:
+		/*
+		 * ADD FUNCTION
+		 *
+		 * Function adds a material to the table, returning its
+		 * index. A material already in the table keeps its index
+		 */
+		int add(const shared_ptr<material>& m)
+		{
+			// Check if the material is already in the table
+			auto found = _indices.find(m.get());
+			if (found != _indices.end())
+			{
+				// Return the existing index
+				return found->second;
+			}
+
+			// Add the material's data block
+			int index = static_cast<int>(_materials.size());
+			_materials.push_back(m->getData());
+			_indices[m.get()] = index;
+
+			// Return the new index
+			return index;
+		}
+
+		/*
+		 * GET VALUE AT ELEMENT OPERATOR
+		 *
+		 * When invoked, operator returns the data block of the
+		 * material at index i
+		 */
+		const materialData& operator[](int i) const
+		{
+			// Return the data block
+			return _materials[i];
+		}
+
+		/*
+		 * SIZE FUNCTION
+		 *
+		 * Function returns the number of materials in the table
+		 */
+		int size() const
+		{
+			// Return the number of data blocks
+			return static_cast<int>(_materials.size());
+		}
+
+	// Private variables
+	private:
+		// Data block of each material
+		vector<materialData> _materials;
+
+		// Index of each material, only used while objects are bound
+		map<const material*, int> _indices;
+};
+
+// End ifndef directive for MATERIAL_TABLE_H
+#endif
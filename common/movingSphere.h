@@ -0,0 +1,249 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * HITTABLE MOVING SPHERE CLASS
+ *
+ * Header file containing the hittable moving sphere class - a
+ * sphere whose centre moves in a straight line while the shutter
+ * is open, hit where it is at the ray's time. Its bounding box
+ * covers the whole motion, so one hierarchy serves every time
+ */
+
+// Declare ifndef directive for MOVING_SPHERE_H
+#ifndef MOVING_SPHERE_H
+
+// Define MOVING_SPHERE_H
+#define MOVING_SPHERE_H
+
+// Header files
+#include "hittable.h"
+#include "materialTable.h"
+#include "vec3.h"
+
+/* ==================================================================
+ * MOVING SPHERE CLASS
+ *
+ * Class for moving sphere objects. Extension of the hittable
+ * abstract class.
+ *
+ * The sphere is at centre0 at time0 and centre1 at time1, and
+ * moves linearly between them. It rests at the nearer end for
+ * times outside the interval, so it never leaves its box
+ * ==================================================================
+ */
+class movingSphere : public hittable
+{
+	// Public
+	public:
+		/*
+		 * MOVING SPHERE CONSTRUCTOR
+		 *
+		 * Creates a sphere of radius r moving from centre c0 at
+		 * time t0 to centre c1 at time t1
+		 */
+		movingSphere(point3 c0, point3 c1, float t0, float t1, float r, shared_ptr<material> m) :
+			_centre0(c0), _centre1(c1), _time0(t0), _time1(t1), _radius(r), _sphereMaterial(m), _materialIndex(-1), _objectIndex(-1) {};
+
+		/*
+		 * HIT FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Used to determine if the sphere, where it is at the
+		 * ray's time, has been hit by a ray
+		 */
+		virtual bool hit(const ray& r, float tMin, float tMax, hitRecord& rec) const override
+		{
+			// Determine the components of the quadratic formula, about the centre at the ray's time
+			point3 centreAtTime = centre(r.getTime());
+			vec3 oc = r.getOrigin() - centreAtTime;
+			float a = r.getDirection().lengthSquared();
+			float halfB = dot(oc, r.getDirection());
+			float c = oc.lengthSquared() - _radius * _radius;
+			float discriminant = (halfB * halfB) - (a * c);
+
+			// Check if the ray misses the sphere
+			if (discriminant <= 0.0f)
+			{
+				// No hit
+				return false;
+			}
+
+			// Find the nearest root within tMin and tMax
+			float root = sqrt(discriminant);
+			float t = (-halfB - root) / a;
+			if (t >= tMax || t <= tMin)
+			{
+				// Try the far root
+				t = (-halfB + root) / a;
+				if (t >= tMax || t <= tMin)
+				{
+					// No hit
+					return false;
+				}
+			}
+
+			// Record the ray parameter and point of collision
+			rec.t = t;
+			rec.p = r.at(t);
+
+			// Determine the outward normal, the face, and record the normal
+			vec3 outwardNormal = (rec.p - centreAtTime) / _radius;
+			rec.setFaceNormal(r, outwardNormal);
+
+			// Set material - moving spheres are not gathered as lights
+			rec.materialPointer = _sphereMaterial;
+			rec.materialIndex = _materialIndex;
+			rec.lightIndex = -1;
+			rec.objectIndex = _objectIndex;
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * OCCLUDED FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Determines if either root lies between tMin and tMax,
+		 * without finding the point, normal or material
+		 */
+		virtual bool occluded(const ray& r, float tMin, float tMax) const override
+		{
+			// Determine the components of the quadratic formula, as for hit
+			vec3 oc = r.getOrigin() - centre(r.getTime());
+			float a = r.getDirection().lengthSquared();
+			float halfB = dot(oc, r.getDirection());
+			float c = oc.lengthSquared() - _radius * _radius;
+			float discriminant = (halfB * halfB) - (a * c);
+
+			// Check if the ray misses the sphere
+			if (discriminant <= 0.0f)
+			{
+				// Not blocked
+				return false;
+			}
+
+			// Check the near root, then the far root
+			float root = sqrt(discriminant);
+			float nearT = (-halfB - root) / a;
+			float farT = (-halfB + root) / a;
+			return (nearT < tMax && nearT > tMin) || (farT < tMax && farT > tMin);
+		}
+
+		/*
+		 * BOUNDING BOX FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Obtains the box which bounds the sphere over its
+		 * motion - the union of the boxes at both ends
+		 */
+		virtual bool boundingBox(aabb& outputBox) const override
+		{
+			// Obtain the absolute radius - hollow spheres use a negative radius
+			float absoluteRadius = fabs(_radius);
+			vec3 extent(absoluteRadius, absoluteRadius, absoluteRadius);
+
+			// Determine the box at each end of the motion, and surround both
+			aabb box0(_centre0 - extent, _centre0 + extent);
+			aabb box1(_centre1 - extent, _centre1 + extent);
+			outputBox = surroundingBox(box0, box1);
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * BIND MATERIALS FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Adds the sphere's material to the table
+		 */
+		virtual void bindMaterials(materialTable& table) override
+		{
+			// Record the material's index
+			_materialIndex = table.add(_sphereMaterial);
+		}
+
+		/*
+		 * SET OBJECT INDEX FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Records the sphere's index in the scene
+		 */
+		virtual void setObjectIndex(int index) override
+		{
+			// Record the object's index
+			_objectIndex = index;
+		}
+
+		/*
+		 * SET CENTRE FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Moves the sphere so it starts its motion at centre,
+		 * keeping the path it follows
+		 */
+		virtual bool setCentre(const point3& c) override
+		{
+			// Move both ends of the motion
+			_centre1 = c + (_centre1 - _centre0);
+			_centre0 = c;
+			return true;
+		}
+
+		/*
+		 * CENTRE FUNCTION
+		 *
+		 * Function returns the centre of the sphere at a time
+		 */
+		point3 centre(float time) const
+		{
+			// Check the sphere moves over an interval
+			if (_time1 == _time0)
+			{
+				// Sphere is at its first centre
+				return _centre0;
+			}
+
+			// Interpolate between the centres, holding the ends
+			float fraction = clamp((time - _time0) / (_time1 - _time0), 0.0f, 1.0f);
+			return _centre0 + fraction * (_centre1 - _centre0);
+		}
+
+	// Private
+	private:
+		// Sphere centres at the start and end of the motion
+		point3 _centre0, _centre1;
+
+		// Times of the start and end of the motion
+		float _time0, _time1;
+
+		// Sphere radius
+		float _radius;
+
+		// Material
+		shared_ptr<material> _sphereMaterial;
+
+		// Index of the material in the material table
+		int _materialIndex;
+
+		// Index of the sphere in the scene, or -1
+		int _objectIndex;
+};
+
+// End ifndef directive for MOVING_SPHERE_H
+#endif
@@ -0,0 +1,202 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * OBJ LOADER HEADER FILE
+ *
+ * Header file containing the Wavefront OBJ loader, which reads the
+ * geometry of an OBJ file into one triangle mesh:
+ *
+ *     v <x> <y> <z>                   vertex position
+ *     vn <x> <y> <z>                  vertex normal
+ *     f <v>[/<vt>][/<vn>] ...         face of three or more corners
+ *
+ * Indices start at 1, and negative indices count back from the
+ * last vertex read. Faces with more than three corners are split
+ * into a fan of triangles. Texture coordinates, groups, smoothing
+ * and materials are ignored, and the whole mesh takes one material
+ */
+
+// Declare ifndef directive for OBJ_LOADER_H
+#ifndef OBJ_LOADER_H
+
+// Define OBJ_LOADER_H
+#define OBJ_LOADER_H
+
+// Header files
+#include "triangleMesh.h"
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/*
+ * READ OBJ INDEX FUNCTION
+ *
+ * Function reads a 1-based or negative OBJ index from text,
+ * and returns it as a 0-based index into count elements, or
+ * -1 if the text is not an index of one
+ */
+inline int readObjIndex(const string& text, int count)
+{
+	// Read the whole text as an integer
+	istringstream stream(text);
+	int index;
+	if (!(stream >> index) || stream.peek() != EOF)
+	{
+		// Not an integer
+		return -1;
+	}
+
+	// Count back from the end for negative indices
+	index = index < 0 ? count + index : index - 1;
+	return index >= 0 && index < count ? index : -1;
+}
+
+/*
+ * LOAD OBJ FUNCTION
+ *
+ * Function reads an OBJ file into a triangle mesh with the
+ * given material, built with the given preset and threads.
+ * Vertex normals are used if every corner has one. Returns
+ * null, after printing the file and line, if the file cannot
+ * be read or holds no triangles
+ */
+inline shared_ptr<triangleMesh> loadObj(const string& fileName, shared_ptr<material> m, bvhPreset preset, int threadCount)
+{
+	// Open the file
+	ifstream file(fileName);
+	if (!file)
+	{
+		// File could not be opened
+		cerr << "Could not open OBJ file " << fileName << endl;
+		return nullptr;
+	}
+
+	// Positions and normals as read, and the position and normal index of each triangle corner
+	vector<point3> positions;
+	vector<vec3> normals;
+	vector<pair<int, int>> corners;
+	bool everyCornerHasNormal = true;
+
+	// Read each line
+	string line;
+	for (int lineNumber = 1; getline(file, line); lineNumber++)
+	{
+		// Read the keyword, skipping blank lines and comments
+		istringstream words(line);
+		string keyword;
+		if (!(words >> keyword) || keyword[0] == '#')
+		{
+			continue;
+		}
+
+		// Check the keyword
+		bool valid = true;
+		if (keyword == "v" || keyword == "vn")
+		{
+			// Read a position or normal
+			float x, y, z;
+			valid = static_cast<bool>(words >> x >> y >> z);
+			if (valid)
+			{
+				(keyword == "v" ? positions : normals).push_back(vec3(x, y, z));
+			}
+		}
+		else if (keyword == "f")
+		{
+			// Read each corner of the face, up to any comment - position, then optional texture coordinate and normal
+			vector<pair<int, int>> face;
+			string corner;
+			while (valid && words >> corner && corner[0] != '#')
+			{
+				size_t firstSlash = corner.find('/');
+				size_t secondSlash = firstSlash == string::npos ? string::npos : corner.find('/', firstSlash + 1);
+				int position = readObjIndex(corner.substr(0, firstSlash), static_cast<int>(positions.size()));
+				int normal = secondSlash == string::npos ? -1 : readObjIndex(corner.substr(secondSlash + 1), static_cast<int>(normals.size()));
+				valid = position >= 0 && (secondSlash == string::npos || normal >= 0);
+				everyCornerHasNormal = everyCornerHasNormal && normal >= 0;
+				face.push_back(make_pair(position, normal));
+			}
+			valid = valid && face.size() >= 3;
+
+			// Split the face into a fan of triangles around its first corner
+			for (size_t i = 2; valid && i < face.size(); i++)
+			{
+				corners.push_back(face[0]);
+				corners.push_back(face[i - 1]);
+				corners.push_back(face[i]);
+			}
+		}
+
+		// Check the line was understood
+		if (!valid)
+		{
+			// Not a position, normal or face
+			cerr << fileName << ":" << lineNumber << ": could not read \"" << line << "\"" << endl;
+			return nullptr;
+		}
+	}
+
+	// Check there is something to render
+	if (corners.empty())
+	{
+		// No faces
+		cerr << "OBJ file " << fileName << " has no faces" << endl;
+		return nullptr;
+	}
+
+	// Check if the mesh is smooth shaded
+	vector<point3> vertices;
+	vector<vec3> vertexNormals;
+	vector<int> indices(corners.size());
+	if (everyCornerHasNormal)
+	{
+		// Make a vertex for each pair of position and normal used, shared by every corner with the pair
+		map<pair<int, int>, int> vertexOfCorner;
+		for (size_t i = 0; i < corners.size(); i++)
+		{
+			auto inserted = vertexOfCorner.insert(make_pair(corners[i], static_cast<int>(vertices.size())));
+			if (inserted.second)
+			{
+				vertices.push_back(positions[corners[i].first]);
+				vertexNormals.push_back(unitVector(normals[corners[i].second]));
+			}
+			indices[i] = inserted.first->second;
+		}
+	}
+	else
+	{
+		// Flat shaded - the positions are the vertices
+		vertices.swap(positions);
+		for (size_t i = 0; i < corners.size(); i++)
+		{
+			indices[i] = corners[i].first;
+		}
+	}
+
+	// Create the mesh
+	return make_shared<triangleMesh>(move(vertices), move(indices), move(vertexNormals), m, preset, threadCount);
+}
+
+// End ifndef directive for OBJ_LOADER_H
+#endif
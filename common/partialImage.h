@@ -0,0 +1,325 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * PARTIAL IMAGE HEADER FILE
+ *
+ * Header file containing the partial image class - the raw float
+ * sums of a render and the number of samples behind each pixel,
+ * before tone mapping. Independent renders of the same scene, with
+ * different seeds, are merged by adding their partial images, so a
+ * render can be split across machines with no communication. Each
+ * file carries the fingerprint of its render, and only images of
+ * the same scene, scene seed and sampler, but different sampler
+ * seeds, are merged
+ */
+
+// Declare ifndef directive for PARTIAL_IMAGE_H
+#ifndef PARTIAL_IMAGE_H
+
+// Define PARTIAL_IMAGE_H
+#define PARTIAL_IMAGE_H
+
+// Header files
+#include "common.h"
+#include "colour.h"
+#include "sceneFingerprint.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+// Most renders a partial image file may sum, so a damaged count is caught before it is allocated
+const uint32_t maxSeedCount = 1u << 20;
+
+// Bytes starting every partial image file
+const char partialImageMagic[8] = { 'P', 'T', 'P', 'A', 'R', 'T', '3', '\n' };
+
+/* ==================================================================
+ * PARTIAL IMAGE CLASS
+ *
+ * Class for a partial image. Pixels are ordered from the top row
+ * down, like the frame buffer. The file holds the magic bytes, the
+ * width and height as 32-bit integers, the scene fingerprint, the
+ * number of renders summed and the sampler seed of each as 32-bit
+ * integers, then three 32-bit floats and a 32-bit sample count per
+ * pixel, all in the byte order of the machine
+ * ==================================================================
+ */
+class partialImage
+{
+	// Public functions
+	public:
+		/*
+		 * DEFAULT PARTIAL IMAGE CONSTRUCTOR
+		 *
+		 * When invoked, creates an empty image
+		 */
+		partialImage() : _width(0), _height(0), _fingerprint() {}
+
+		/*
+		 * PARTIAL IMAGE CONSTRUCTOR
+		 *
+		 * When invoked, creates an image from a frame buffer, whose
+		 * every pixel is the sum of samplesPerPixel samples of the
+		 * render with the given fingerprint
+		 */
+		partialImage(int width, int height, const sceneFingerprint& fingerprint, const vector<colour>& frameBuffer, int samplesPerPixel) :
+			_width(width), _height(height), _fingerprint(fingerprint), _samplerSeeds(1, fingerprint.samplerSeed), _sums(frameBuffer),
+			_sampleCounts(frameBuffer.size(), static_cast<uint32_t>(samplesPerPixel)) {}
+
+		/*
+		 * READ FUNCTION
+		 *
+		 * Function reads a partial image file. Returns false, after
+		 * printing the reason, if it cannot be read
+		 */
+		bool read(const string& fileName)
+		{
+			// Open the file
+			ifstream file(fileName, ios::binary);
+			if (!file)
+			{
+				// File could not be opened
+				cerr << "Could not open partial image " << fileName << endl;
+				return false;
+			}
+
+			// Read and check the header
+			char magic[sizeof(partialImageMagic)];
+			int32_t size[2];
+			file.read(magic, sizeof(magic));
+			file.read(reinterpret_cast<char*>(size), sizeof(size));
+			file.read(reinterpret_cast<char*>(&_fingerprint), sizeof(_fingerprint));
+			uint32_t seedCount = 0;
+			file.read(reinterpret_cast<char*>(&seedCount), sizeof(seedCount));
+			if (!file || memcmp(magic, partialImageMagic, sizeof(magic)) != 0 || size[0] <= 0 || size[1] <= 0 || seedCount == 0 || seedCount > maxSeedCount)
+			{
+				// Not a partial image, or one written before it carried a fingerprint and seeds
+				cerr << fileName << " is not a partial image" << endl;
+				return false;
+			}
+
+			// Read the sampler seed of each render summed
+			_samplerSeeds.resize(seedCount);
+			file.read(reinterpret_cast<char*>(_samplerSeeds.data()), seedCount * sizeof(uint32_t));
+
+			// Read the pixels
+			_width = size[0];
+			_height = size[1];
+			const size_t pixelCount = static_cast<size_t>(_width) * _height;
+			_sums.resize(pixelCount);
+			_sampleCounts.resize(pixelCount);
+			for (size_t i = 0; i < pixelCount; i++)
+			{
+				float sum[3];
+				file.read(reinterpret_cast<char*>(sum), sizeof(sum));
+				file.read(reinterpret_cast<char*>(&_sampleCounts[i]), sizeof(uint32_t));
+				_sums[i] = colour(sum[0], sum[1], sum[2]);
+			}
+
+			// Check every pixel was there
+			if (!file)
+			{
+				// File was cut short
+				cerr << "Partial image " << fileName << " is truncated" << endl;
+				return false;
+			}
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * WRITE FUNCTION
+		 *
+		 * Function writes the image to a partial image file. Returns
+		 * false, after printing the reason, if it cannot be written
+		 */
+		bool write(const string& fileName) const
+		{
+			// Open the file
+			ofstream file(fileName, ios::binary);
+			if (!file)
+			{
+				// File could not be opened
+				cerr << "Could not open partial image " << fileName << endl;
+				return false;
+			}
+
+			// Write the header
+			int32_t size[2] = { _width, _height };
+			file.write(partialImageMagic, sizeof(partialImageMagic));
+			file.write(reinterpret_cast<const char*>(size), sizeof(size));
+			file.write(reinterpret_cast<const char*>(&_fingerprint), sizeof(_fingerprint));
+			uint32_t seedCount = static_cast<uint32_t>(_samplerSeeds.size());
+			file.write(reinterpret_cast<const char*>(&seedCount), sizeof(seedCount));
+			file.write(reinterpret_cast<const char*>(_samplerSeeds.data()), seedCount * sizeof(uint32_t));
+
+			// Write the pixels
+			for (size_t i = 0; i < _sums.size(); i++)
+			{
+				float sum[3] = { _sums[i].getX(), _sums[i].getY(), _sums[i].getZ() };
+				file.write(reinterpret_cast<const char*>(sum), sizeof(sum));
+				file.write(reinterpret_cast<const char*>(&_sampleCounts[i]), sizeof(uint32_t));
+			}
+
+			// Check the file was written
+			if (!file)
+			{
+				// Write failed
+				cerr << "Could not write partial image " << fileName << endl;
+				return false;
+			}
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * MERGE FUNCTION
+		 *
+		 * Function adds another partial image of the same size and
+		 * scene to this one - an empty image takes on the other's
+		 * size and fingerprint. Returns false, after printing the
+		 * reason, if the sizes or scenes differ, or if both images
+		 * hold a render with the same sampler seed
+		 */
+		bool merge(const partialImage& other)
+		{
+			// Check if this image is empty
+			if (_sums.empty())
+			{
+				// Copy the other image
+				*this = other;
+				return true;
+			}
+
+			// Check the sizes match
+			if (other._width != _width || other._height != _height)
+			{
+				// Different renders
+				cerr << "Cannot merge a " << other._width << "x" << other._height << " partial image into a " << _width << "x" << _height << " one" << endl;
+				return false;
+			}
+
+			// Check the scenes match - the samples per pixel may differ
+			if (!sameScene(other._fingerprint, _fingerprint))
+			{
+				// Different scenes, whose samples would not add up
+				cerr << "Cannot merge a partial image of " << describeFingerprint(other._fingerprint) << " into one of " << describeFingerprint(_fingerprint) << endl;
+				return false;
+			}
+
+			// Check the sampler seeds differ - renders with the same seed draw the same samples, so merging them would double the sample count without reducing the noise
+			for (uint32_t seed : other._samplerSeeds)
+			{
+				if (find(_samplerSeeds.begin(), _samplerSeeds.end(), seed) != _samplerSeeds.end())
+				{
+					// Same samples twice
+					cerr << "Cannot merge two renders with sampler seed " << seed << " - they hold the same samples, so render each part with a different --seed" << endl;
+					return false;
+				}
+			}
+			_samplerSeeds.insert(_samplerSeeds.end(), other._samplerSeeds.begin(), other._samplerSeeds.end());
+
+			// Add the sums and the sample counts - each pixel is then weighted by its samples
+			for (size_t i = 0; i < _sums.size(); i++)
+			{
+				_sums[i] += other._sums[i];
+				_sampleCounts[i] += other._sampleCounts[i];
+			}
+
+			// Return true
+			return true;
+		}
+
+		/*
+		 * TONE MAP FUNCTION
+		 *
+		 * Function writes the mean of each pixel, gamma corrected, to
+		 * the JPG vector. A pixel with no samples is black
+		 */
+		void toneMap(vector<uint8_t>& jpgVector) const
+		{
+			// Write each pixel, from the top of the image
+			for (size_t i = 0; i < _sums.size(); i++)
+			{
+				// Invoke the write colour function with the pixel's own sample count
+				writeColour(_sampleCounts[i] > 0 ? _sums[i] : colour(0.0f, 0.0f, 0.0f), jpgVector, max(1, static_cast<int>(_sampleCounts[i])));
+			}
+		}
+
+		/*
+		 * GET WIDTH FUNCTION
+		 *
+		 * Function returns the width of the image
+		 */
+		int getWidth() const
+		{
+			// Return width
+			return _width;
+		}
+
+		/*
+		 * GET HEIGHT FUNCTION
+		 *
+		 * Function returns the height of the image
+		 */
+		int getHeight() const
+		{
+			// Return height
+			return _height;
+		}
+
+		/*
+		 * GET SAMPLE COUNT FUNCTION
+		 *
+		 * Function returns the number of samples behind a pixel
+		 */
+		uint32_t getSampleCount(int pixel) const
+		{
+			// Return sample count
+			return _sampleCounts[pixel];
+		}
+
+	// Private
+	private:
+		// Size of the image
+		int _width;
+		int _height;
+
+		// Fingerprint of the render, or of the first render merged
+		sceneFingerprint _fingerprint;
+
+		// Sampler seed of every render summed into the image
+		vector<uint32_t> _samplerSeeds;
+
+		// Sum of the samples of each pixel
+		vector<colour> _sums;
+
+		// Number of samples behind each pixel
+		vector<uint32_t> _sampleCounts;
+};
+
+// End ifndef directive for PARTIAL_IMAGE_H
+#endif
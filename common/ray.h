@@ -4,7 +4,7 @@
  * GRAEME B. WHITE - 40415739
  *
  * DATE OF CREATION: 10/10/2020
- * DATE LAST MODIFIED: 11/10/2020
+ * DATE LAST MODIFIED: 18/10/2026
  * ==================================================================
  * PATH-TRACING PROTOTYPE
  *
@@ -52,11 +52,12 @@ class ray
 		 * RAY CONSTRUCTOR
 		 * 
 		 * Function takes in an origin and direction vectors,
-		 * then sets the origin and direction variables of the
-		 * ray
+		 * and the time the ray is cast within the shutter
+		 * interval, then sets the origin, direction and time
+		 * variables of the ray
 		 */
-		ray(const point3& origin, const vec3& direction) 
-			: _orig(origin), _dir(direction) {}
+		ray(const point3& origin, const vec3& direction, float time = 0.0f) 
+			: _orig(origin), _dir(direction), _time(time) {}
 
 		/*
 		 * GET ORIGIN FUNCTION
@@ -80,6 +81,17 @@ class ray
 			return _dir;
 		}
 
+		/*
+		 * GET TIME FUNCTION
+		 *
+		 * Function returns the time the ray is cast
+		 */
+		float getTime() const
+		{
+			// Return the time of the ray
+			return _time;
+		}
+
 		/*
 		 * AT FUNCTION
 		 *
@@ -100,6 +112,9 @@ class ray
 
 		// Ray direction
 		vec3 _dir;
+
+		// Time the ray is cast - moving objects are hit where they are at this time
+		float _time = 0.0f;
 };
 
 // End ifndef directive for RAY_H
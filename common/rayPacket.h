@@ -0,0 +1,141 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * RAY PACKET HEADER FILE
+ *
+ * Header file containing the ray packet struct. A packet holds a
+ * small group of coherent rays (camera rays for neighbouring
+ * pixels) in structure-of-arrays form, so each intersection test
+ * can be carried out for every lane with one vectorised loop
+ */
+
+// Declare ifndef directive for RAY_PACKET_H
+#ifndef RAY_PACKET_H
+
+// Define RAY_PACKET_H
+#define RAY_PACKET_H
+
+// Header files
+#include "common.h"
+#include "simd.h"
+
+// Packet width - 4 (SSE) or 8 (AVX) lanes, set by the build
+#ifndef PACKET_WIDTH
+#define PACKET_WIDTH 8
+#endif
+
+// Number of rays in a packet
+const int packetWidth = PACKET_WIDTH;
+
+// Packets are processed as whole SIMD vectors
+static_assert(packetWidth % simdWidth == 0, "PACKET_WIDTH must be a multiple of 4");
+
+/* ==================================================================
+ * RAY PACKET STRUCT
+ *
+ * Struct containing the origins, directions, inverse directions,
+ * times and active mask of each ray in the packet
+ * ==================================================================
+ */
+struct rayPacket
+{
+	// Ray origins
+	alignas(16) float originX[packetWidth];
+	alignas(16) float originY[packetWidth];
+	alignas(16) float originZ[packetWidth];
+
+	// Ray directions
+	alignas(16) float directionX[packetWidth];
+	alignas(16) float directionY[packetWidth];
+	alignas(16) float directionZ[packetWidth];
+
+	// Inverse ray directions, for box tests
+	alignas(16) float invDirectionX[packetWidth];
+	alignas(16) float invDirectionY[packetWidth];
+	alignas(16) float invDirectionZ[packetWidth];
+
+	// Ray times, for moving objects
+	alignas(16) float time[packetWidth];
+
+	// Active lanes - lanes past the edge of the image are inactive. Stored
+	// as 32-bit integers, matching the float lanes, so masks vectorise
+	int active[packetWidth];
+
+	/*
+	 * SET RAY FUNCTION
+	 *
+	 * Function stores a ray in a lane of the packet and
+	 * marks the lane as active
+	 */
+	inline void setRay(int lane, const ray& r)
+	{
+		// Obtain the ray origin and direction
+		point3 origin = r.getOrigin();
+		vec3 direction = r.getDirection();
+
+		// Store the origin
+		originX[lane] = origin.getX();
+		originY[lane] = origin.getY();
+		originZ[lane] = origin.getZ();
+
+		// Store the direction
+		directionX[lane] = direction.getX();
+		directionY[lane] = direction.getY();
+		directionZ[lane] = direction.getZ();
+
+		// Store the inverse direction
+		invDirectionX[lane] = 1.0f / direction.getX();
+		invDirectionY[lane] = 1.0f / direction.getY();
+		invDirectionZ[lane] = 1.0f / direction.getZ();
+
+		// Store the time
+		time[lane] = r.getTime();
+
+		// Mark lane as active
+		active[lane] = 1;
+	}
+
+	/*
+	 * GET RAY FUNCTION
+	 *
+	 * Function returns the ray stored in a lane
+	 */
+	inline ray getRay(int lane) const
+	{
+		// Rebuild the ray from the lane
+		return ray(point3(originX[lane], originY[lane], originZ[lane]), vec3(directionX[lane], directionY[lane], directionZ[lane]), time[lane]);
+	}
+
+	/*
+	 * CLEAR FUNCTION
+	 *
+	 * Function marks every lane as inactive
+	 */
+	inline void clear()
+	{
+		// Iterate over each lane
+		for (int lane = 0; lane < packetWidth; lane++)
+		{
+			// Deactivate lane, with a harmless ray so vector loops stay well defined
+			setRay(lane, ray(point3(0.0f, 0.0f, 0.0f), vec3(1.0f, 1.0f, 1.0f)));
+			active[lane] = 0;
+		}
+	}
+};
+
+// End ifndef directive for RAY_PACKET_H
+#endif
@@ -0,0 +1,469 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * RENDER KERNEL HEADER FILE
+ *
+ * Header file containing the render kernels, which are templates
+ * specialised at compile time on the camera type (pinhole or thin
+ * lens), the acceleration structure (flat list or BVH), the maximum
+ * depth, and whether camera rays are traced in packets.
+ *
+ * The kernel is selected once, before rendering, so the inner loops
+ * carry no checks of these settings, world hits are direct calls
+ * rather than virtual calls, and the bounce loop has a fixed trip
+ * count
+ */
+
+// Declare ifndef directive for RENDER_KERNEL_H
+#ifndef RENDER_KERNEL_H
+
+// Define RENDER_KERNEL_H
+#define RENDER_KERNEL_H
+
+// Header files
+#include "common.h"
+#include "aov.h"
+#include "camera.h"
+#include "bvh.h"
+#include "hittableList.h"
+#include "light.h"
+#include "material.h"
+#include "materialTable.h"
+#include "rayPacket.h"
+#include "sampler.h"
+#include "sky.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+// Width and height, in pixels, of the tile of neighbouring pixels covered by a packet
+const int packetTileWidth = packetWidth / 2;
+const int packetTileHeight = 2;
+
+/*
+ * CAMERA RAY FUNCTION
+ *
+ * Function returns a camera ray for pixel (i, j), through the lens
+ * or from the pinhole depending on the template parameter, using
+ * the sampler's current pixel sample for the offset, lens position
+ * and time
+ */
+template <bool ThinLens>
+inline ray cameraRay(const camera& cam, int i, int j, int imageWidth, int imageHeight, sampler& samp)
+{
+	// Obtain the pixel offset and, for a thin lens, the lens position
+	sample2D pixelSample = samp.get2D();
+	sample2D lensSample = ThinLens ? samp.get2D() : sample2D();
+
+	// Determine u and v coordinates of pixel
+	auto u = (i + pixelSample.x) / (imageWidth - 1);
+	auto v = (j + pixelSample.y) / (imageHeight - 1);
+
+	// Obtain the time within the shutter interval
+	float time = cam.sampleTime(samp);
+
+	// Select the camera type at compile time
+	return ThinLens ? cam.getThinLensRay(u, v, lensSample, time) : cam.getPinholeRay(u, v, time);
+}
+
+/*
+ * FILL CAMERA PACKET FUNCTION
+ *
+ * Function fills a packet with one camera ray for each pixel
+ * of the tile whose lower left pixel is (tileX, tileY), for one
+ * sample index. Lanes outside the image are left inactive
+ */
+template <bool ThinLens>
+void fillCameraPacket(const camera& cam, int tileX, int tileY, int sampleIndex, int imageWidth, int imageHeight, sampler& samp, rayPacket& packet)
+{
+	// Deactivate every lane
+	packet.clear();
+
+	// Iterate over each lane
+	for (int lane = 0; lane < packetWidth; lane++)
+	{
+		// Determine the pixel covered by the lane
+		int i = tileX + lane % packetTileWidth;
+		int j = tileY + lane / packetTileWidth;
+
+		// Check if the pixel is inside the image
+		if (i < imageWidth && j < imageHeight)
+		{
+			// Start the lane's pixel sample
+			samp.startPixelSample(i, j, sampleIndex);
+
+			// Cast ray from the pixel into the lane
+			packet.setRay(lane, cameraRay<ThinLens>(cam, i, j, imageWidth, imageHeight, samp));
+		}
+	}
+}
+
+/*
+ * CONTINUE PATH FUNCTION
+ *
+ * Function follows a path whose first hit, if any, is already
+ * known, and returns its colour. A MaxDepth of 0 means the depth
+ * is only known at run time and is taken from maxDepth. Each
+ * bounce takes its samples from its own block of dimensions.
+ * Non-specular hits sample the lights directly (next-event
+ * estimation), weighted against lights found by scattering
+ */
+template <typename World, int MaxDepth>
+inline colour continuePath(ray r, hitRecord& rec, bool hitAnything, const World& world, const materialTable& materials, const sceneLights& lights, sampler& samp, int maxDepth)
+{
+	// Determine the bounce limit - a constant for specialised kernels
+	const int depthLimit = MaxDepth > 0 ? MaxDepth : maxDepth;
+
+	// Product of the attenuations along the path, and the light gathered so far
+	colour throughput(1.0f, 1.0f, 1.0f);
+	colour radiance(0.0f, 0.0f, 0.0f);
+
+	// Pdf of the scatter which produced the ray - 0 for the camera ray and specular scatters - and the normal it left
+	float scatterPdf = 0.0f;
+	vec3 scatterNormal(0.0f, 0.0f, 0.0f);
+
+	// Follow the path until it escapes, is absorbed, or reaches the limit
+	for (int depth = 0; depth < depthLimit; depth++)
+	{
+		// Check if an object in the world has been hit (0.001 as tMin to fix shadow acne) - direct, non-virtual call
+		if (depth > 0)
+		{
+			hitAnything = world.World::hit(r, 0.001f, infinity, rec);
+		}
+
+		// Check if the ray escaped
+		if (hitAnything == false)
+		{
+			// Add the sky colour, weighted by the path and against sampling the sky
+			return radiance + throughput * escapedRadiance(lights, r, scatterPdf);
+		}
+
+		// Obtain the material hit
+		const materialData& data = materials[rec.materialIndex];
+
+		// Check if a light was hit
+		if (data.type == EMISSIVE_MATERIAL)
+		{
+			// Add the light's front face emission, weighted against light sampling
+			if (rec.frontFace)
+			{
+				radiance += (emissionWeight(lights, r, rec, scatterPdf, scatterNormal) * throughput) * data.emission;
+			}
+
+			// Lights absorb the ray
+			return radiance;
+		}
+
+		// Add the light arriving directly from the lights
+		radiance += throughput * sampleDirectLight(world, lights, r, rec, data, samp, depth);
+
+		// Empty scattered ray and attenuation colour
+		ray scattered;
+		colour attenuation;
+
+		// Move the sampler to this bounce's dimensions
+		samp.setDimension(bounceDimension(depth));
+
+		// Check if a scattered ray is created upon collision
+		if (scatterMaterial(data, r, rec, attenuation, scattered, samp) == false)
+		{
+			// Ray absorbed
+			return radiance;
+		}
+
+		// Continue along the scattered ray
+		scatterPdf = materialPdf(data, r, rec, scattered.getDirection());
+		scatterNormal = rec.normal;
+		throughput = throughput * attenuation;
+		r = scattered;
+	}
+
+	// Ray bounce limit, no more light gathered
+	return radiance;
+}
+
+/*
+ * ADD FIRST HIT FUNCTION
+ *
+ * Function adds the first hit of camera ray r, or its miss, to
+ * the AOV buffers, if any are being filled
+ */
+inline void addFirstHit(aovBuffers* aovs, int pixel, const ray& r, bool hitAnything, const hitRecord& rec, const materialTable& materials)
+{
+	// Check if AOVs are being filled
+	if (aovs != nullptr)
+	{
+		// Add the hit or the miss
+		if (hitAnything)
+		{
+			aovs->addHit(pixel, r, rec, materialAlbedo(materials[rec.materialIndex]));
+		}
+		else
+		{
+			aovs->addMiss(pixel);
+		}
+	}
+}
+
+/*
+ * TRACE PATH FUNCTION
+ *
+ * Function follows a path from a ray and returns its colour,
+ * adding its first hit to the AOV buffers if any are given
+ */
+template <typename World, int MaxDepth>
+inline colour tracePath(const ray& r, const World& world, const materialTable& materials, const sceneLights& lights, sampler& samp, int maxDepth, aovBuffers* aovs, int pixel)
+{
+	// Hit record
+	hitRecord rec;
+
+	// Find the first hit, if the path is allowed any bounces
+	bool hitAnything = (MaxDepth > 0 || maxDepth > 0) && world.World::hit(r, 0.001f, infinity, rec);
+
+	// Add the first hit to the AOVs
+	addFirstHit(aovs, pixel, r, hitAnything, rec, materials);
+
+	// Follow the rest of the path
+	return continuePath<World, MaxDepth>(r, rec, hitAnything, world, materials, lights, samp, maxDepth);
+}
+
+/*
+ * RENDER KERNEL FUNCTION
+ *
+ * Function renders the image, adding the colour of every sample
+ * to the frame buffer, ordered from the top row down, and the
+ * first hits to the AOV buffers if any are given. Every setting in
+ * the template parameters is fixed at compile time
+ */
+template <bool ThinLens, typename World, int MaxDepth, bool Packets>
+void renderKernel(const camera& cam, const World& world, const materialTable& materials, const sceneLights& lights, sampler& samp, int imageWidth, int imageHeight, int samplesPerPixel, int maxDepth, vector<colour>& frameBuffer, aovBuffers* aovs)
+{
+	// Check if camera rays are traced in packets
+	if (Packets)
+	{
+		// Packet, hit records, and results for each lane
+		rayPacket packet;
+		hitRecord rec[packetWidth];
+		bool hits[packetWidth];
+		alignas(16) float tMax[packetWidth];
+
+		// Iterate over each row of tiles, starting from the top of the image
+		for (int tileY = ((imageHeight - 1) / packetTileHeight) * packetTileHeight; tileY >= 0; tileY -= packetTileHeight)
+		{
+			// Display progress to the console window
+			cout << "\rScanlines remaining: " << tileY << ' ' << flush;
+
+			// Iterate over each tile in the row
+			for (int tileX = 0; tileX < imageWidth; tileX += packetTileWidth)
+			{
+				// Iterate over samples per pixel
+				for (int s = 0; s < samplesPerPixel; s++)
+				{
+					// Fill the packet with camera rays
+					fillCameraPacket<ThinLens>(cam, tileX, tileY, s, imageWidth, imageHeight, samp, packet);
+
+					// Reset the results of each lane
+					for (int lane = 0; lane < packetWidth; lane++)
+					{
+						// No hit yet
+						hits[lane] = false;
+						tMax[lane] = infinity;
+					}
+
+					// Find the first hit of every lane
+					world.World::hitPacket(packet, 0.001f, tMax, rec, hits);
+
+					// Follow each active lane's path on its own
+					for (int lane = 0; lane < packetWidth; lane++)
+					{
+						// Check if lane is active
+						if (packet.active[lane] == 0)
+						{
+							// Skip the lane
+							continue;
+						}
+
+						// Determine the pixel covered by the lane
+						int i = tileX + lane % packetTileWidth;
+						int j = tileY + lane / packetTileWidth;
+						int pixel = (imageHeight - 1 - j) * imageWidth + i;
+
+						// Add the lane's first hit to the AOVs
+						addFirstHit(aovs, pixel, packet.getRay(lane), hits[lane], rec[lane], materials);
+
+						// Resume the lane's pixel sample at the first bounce
+						samp.startPixelSample(i, j, s, firstBounceDimension);
+
+						// Add the colour of the path to the frame buffer
+						frameBuffer[pixel] += continuePath<World, MaxDepth>(packet.getRay(lane), rec[lane], hits[lane], world, materials, lights, samp, maxDepth);
+					}
+				}
+			}
+		}
+	}
+	else
+	{
+		// Iterate all pixels over image height, starting from the top of the image
+		for (int j = imageHeight - 1; j >= 0; j--)
+		{
+			// Display progress to the console window
+			cout << "\rScanlines remaining: " << j << ' ' << flush;
+
+			// Iterate all pixels over the image width
+			for (int i = 0; i < imageWidth; i++)
+			{
+				// Initialise pixel colour
+				colour pixelColour(0.0f, 0.0f, 0.0f);
+
+				// Iterate pixel over samples per pixel
+				for (int s = 0; s < samplesPerPixel; s++)
+				{
+					// Start the pixel sample
+					samp.startPixelSample(i, j, s);
+
+					// Determine the pixel colour based on the camera ray
+					pixelColour += tracePath<World, MaxDepth>(cameraRay<ThinLens>(cam, i, j, imageWidth, imageHeight, samp), world, materials, lights, samp, maxDepth, aovs, (imageHeight - 1 - j) * imageWidth + i);
+				}
+
+				// Store the pixel colour in the frame buffer
+				frameBuffer[(imageHeight - 1 - j) * imageWidth + i] = pixelColour;
+			}
+		}
+	}
+}
+
+/*
+ * SELECT DEPTH FUNCTION
+ *
+ * Function selects a kernel specialised on the maximum depth, for
+ * the depths in common use, or the run time depth kernel otherwise
+ */
+template <bool ThinLens, typename World, bool Packets>
+void selectDepth(const camera& cam, const World& world, const materialTable& materials, const sceneLights& lights, sampler& samp, int imageWidth, int imageHeight, int samplesPerPixel, int maxDepth, vector<colour>& frameBuffer, aovBuffers* aovs, string& description)
+{
+	// Check the maximum depth
+	switch (maxDepth)
+	{
+		case 8:
+			// Depth of 8
+			description += ", depth 8";
+			renderKernel<ThinLens, World, 8, Packets>(cam, world, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, frameBuffer, aovs);
+			break;
+
+		case 16:
+			// Depth of 16
+			description += ", depth 16";
+			renderKernel<ThinLens, World, 16, Packets>(cam, world, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, frameBuffer, aovs);
+			break;
+
+		case 50:
+			// Depth of 50
+			description += ", depth 50";
+			renderKernel<ThinLens, World, 50, Packets>(cam, world, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, frameBuffer, aovs);
+			break;
+
+		default:
+			// Any other depth, read at run time
+			description += ", run time depth";
+			renderKernel<ThinLens, World, 0, Packets>(cam, world, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, frameBuffer, aovs);
+			break;
+	}
+}
+
+/*
+ * SELECT PACKETS FUNCTION
+ *
+ * Function selects a kernel with or without camera ray packets
+ */
+template <bool ThinLens, typename World>
+void selectPackets(const camera& cam, const World& world, const materialTable& materials, const sceneLights& lights, sampler& samp, int imageWidth, int imageHeight, int samplesPerPixel, int maxDepth, bool usePackets, vector<colour>& frameBuffer, aovBuffers* aovs, string& description)
+{
+	// Check if camera rays are traced in packets
+	if (usePackets)
+	{
+		// Packets of camera rays
+		description += ", packets";
+		selectDepth<ThinLens, World, true>(cam, world, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, frameBuffer, aovs, description);
+	}
+	else
+	{
+		// Single camera rays
+		description += ", single rays";
+		selectDepth<ThinLens, World, false>(cam, world, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, frameBuffer, aovs, description);
+	}
+}
+
+/*
+ * SELECT WORLD FUNCTION
+ *
+ * Function selects a kernel for the BVH, if one is given, or for
+ * the flat list
+ */
+template <bool ThinLens>
+void selectWorld(const camera& cam, const hittableList& list, const bvh* hierarchy, const materialTable& materials, const sceneLights& lights, sampler& samp, int imageWidth, int imageHeight, int samplesPerPixel, int maxDepth, bool usePackets, vector<colour>& frameBuffer, aovBuffers* aovs, string& description)
+{
+	// Check if a hierarchy was given
+	if (hierarchy != nullptr)
+	{
+		// Hierarchy
+		description += ", BVH";
+		selectPackets<ThinLens, bvh>(cam, *hierarchy, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, usePackets, frameBuffer, aovs, description);
+	}
+	else
+	{
+		// Flat list
+		description += ", flat list";
+		selectPackets<ThinLens, hittableList>(cam, list, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, usePackets, frameBuffer, aovs, description);
+	}
+}
+
+/*
+ * RENDER SPECIALISED FUNCTION
+ *
+ * Function selects, once, the kernel matching the camera, world,
+ * maximum depth and packet settings, then renders with it. First
+ * hits are added to the AOV buffers, if any are given. Returns a
+ * description of the kernel used
+ */
+inline string renderSpecialised(const camera& cam, const hittableList& list, const bvh* hierarchy, const materialTable& materials, const sceneLights& lights, sampler& samp, int imageWidth, int imageHeight, int samplesPerPixel, int maxDepth, bool usePackets, vector<colour>& frameBuffer, aovBuffers* aovs = nullptr)
+{
+	// Description of the kernel
+	string description;
+
+	// Check if the camera has a lens
+	if (cam.hasLens())
+	{
+		// Thin lens camera
+		description = "thin lens";
+		selectWorld<true>(cam, list, hierarchy, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, usePackets, frameBuffer, aovs, description);
+	}
+	else
+	{
+		// Pinhole camera
+		description = "pinhole";
+		selectWorld<false>(cam, list, hierarchy, materials, lights, samp, imageWidth, imageHeight, samplesPerPixel, maxDepth, usePackets, frameBuffer, aovs, description);
+	}
+
+	// Return the description
+	return description;
+}
+
+// End ifndef directive for RENDER_KERNEL_H
+#endif
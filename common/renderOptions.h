@@ -0,0 +1,455 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * RENDER OPTIONS HEADER FILE
+ *
+ * Header file containing the render options struct and the function
+ * which fills it from the command line
+ */
+
+// Declare ifndef directive for RENDER_OPTIONS_H
+#ifndef RENDER_OPTIONS_H
+
+// Define RENDER_OPTIONS_H
+#define RENDER_OPTIONS_H
+
+// Header files
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * RENDER OPTIONS STRUCT
+ *
+ * Struct containing the settings for a render. Defaults match the
+ * settings the prototype has always used
+ * ==================================================================
+ */
+struct renderOptions
+{
+	// Aspect ratio
+	float aspectRatio = 16.0f / 9.0f;
+
+	// Image width
+	int imageWidth = 960;
+
+	// Samples per pixel
+	int samplesPerPixel = 100;
+
+	// Maximum depth
+	int maxDepth = 50;
+
+	// Output file name, without extension
+	string fileName = "protoRTOW_Final01";
+
+	// Scene - "basic", "random", "motion", "instances", "mesh", "lights" or "manylights"
+	string scene = "random";
+
+	// OBJ file placed in the mesh scene, or empty for a generated torus
+	string meshFile = "";
+
+	// Seed the random and motion scenes are generated from, so every process builds the same spheres
+	unsigned int sceneSeed = 0;
+
+	// Acceleration structure - "bvh" or "list"
+	string accelerator = "bvh";
+
+	// BVH build preset - "quality" (binned SAH) or "fast" (Morton codes)
+	string bvhPreset = "quality";
+
+	// Threads used to build the BVH, or 0 for one per core
+	int buildThreads = 0;
+
+	// Material dispatch - "table" or "virtual"
+	string materialDispatch = "table";
+
+	// Trace camera rays in packets
+	bool usePackets = true;
+
+	// Integrator - "kernel", "recursive" or "wavefront"
+	string integrator = "kernel";
+
+	// Number of paths in flight for the wavefront integrator
+	int poolSize = 1 << 16;
+
+	// Reorder secondary rays for coherence in the wavefront integrator
+	bool sortRays = false;
+
+	// Sampler - "sobol", "halton", "cmj", "bluenoise" or "independent"
+	string sampler = "sobol";
+
+	// Seed for the sampler
+	unsigned int seed = 0;
+
+	// Light selection for next-event estimation - "bvh" or "uniform"
+	string lightSampler = "bvh";
+
+	// High dynamic range environment map used as the sky, or empty for the gradient
+	string environmentMap = "";
+
+	// Denoise the image, guided by the albedo and normal AOVs, before writing it
+	bool denoise = false;
+
+	// Write the depth, normal, albedo, material and object AOVs to PFM files alongside the image
+	bool writeAovs = false;
+
+	// Write the raw float sums and sample counts to a partial image, for merging with other renders
+	bool writePartial = false;
+
+	// Number of local worker processes to render across, or 0 to render in this process
+	int workers = 0;
+
+	// Port the coordinator listens on for remote workers, or 0 for a free port open to local workers only
+	int port = 0;
+
+	// Samples per pixel in each distributed job, or 0 for about four jobs per worker
+	int jobSamples = 0;
+
+	// Address of the coordinator, as host:port, to render jobs for - empty unless this process is a worker
+	string workerAddress = "";
+
+	// Keyframe file of an animation to render as an image sequence, or empty for one image
+	string animationFile = "";
+
+	// Number of animation frames, or 0 for every frame up to the last key
+	int frameCount = 0;
+
+	// Time the shutter stays open, from time 0 - moving objects are blurred over it
+	float shutter = 0.0f;
+
+	// Growth in SAH cost, over the cost when built, at which a refitted BVH is rebuilt
+	float rebuildThreshold = 1.5f;
+
+	// Run the packet benchmark instead of rendering
+	bool benchmarkPackets = false;
+
+	// Run the sampler convergence benchmark instead of rendering
+	bool benchmarkConvergence = false;
+
+	// Run the light sampling benchmark instead of rendering
+	bool benchmarkLights = false;
+
+	// Run the BVH refit benchmark instead of rendering
+	bool benchmarkRefit = false;
+
+	// Run the BVH build benchmark instead of rendering
+	bool benchmarkBuild = false;
+
+	/*
+	 * GET IMAGE HEIGHT FUNCTION
+	 *
+	 * Function determines the image height, based on the
+	 * image width and aspect ratio
+	 */
+	int getImageHeight() const
+	{
+		// Determine and return the image height
+		return static_cast<int>(imageWidth / aspectRatio);
+	}
+};
+
+/*
+ * PRINT USAGE FUNCTION
+ *
+ * Function writes the command line options to the console
+ */
+inline void printUsage(const char* programName)
+{
+	// Output usage
+	cerr << "Usage: " << programName << " [options]" << endl
+		<< "  --width <pixels>          Image width (default 960)" << endl
+		<< "  --spp <samples>           Samples per pixel (default 100)" << endl
+		<< "  --depth <bounces>         Maximum ray depth (default 50)" << endl
+		<< "  --output <name>           Output file name, without extension" << endl
+		<< "  --scene <name>            basic, random, motion, instances, mesh, lights or manylights (default random)" << endl
+		<< "  --mesh <file>             OBJ file placed in the mesh scene (default a generated torus)" << endl
+		<< "  --scene-seed <number>     Seed the random and motion scenes are generated from (default 0)" << endl
+		<< "  --accel <bvh|list>        Acceleration structure (default bvh)" << endl
+		<< "  --bvh-preset <name>       quality (binned SAH) or fast (Morton codes) BVH build (default quality)" << endl
+		<< "  --build-threads <count>   Threads used to build the BVH (default one per core)" << endl
+		<< "  --materials <name>        table or virtual, for recursive and wavefront (default table)" << endl
+		<< "  --no-packets              Trace camera rays one at a time" << endl
+		<< "  --integrator <name>       kernel, recursive or wavefront (default kernel)" << endl
+		<< "  --pool <paths>            Paths in flight for wavefront (default 65536)" << endl
+		<< "  --sort-rays               Reorder wavefront secondary rays by direction and origin" << endl
+		<< "  --sampler <name>          sobol, halton, cmj, bluenoise or independent (default sobol)" << endl
+		<< "  --seed <number>           Seed for the sampler, the frame number for bluenoise (default 0)" << endl
+		<< "  --light-sampler <name>    bvh or uniform light selection (default bvh)" << endl
+		<< "  --envmap <file>           HDR environment map used as the sky (default gradient)" << endl
+		<< "  --denoise                 Filter the image, guided by albedo and normals, before writing it" << endl
+		<< "  --aovs                    Also write depth, normal, albedo, material and object PFM files" << endl
+		<< "  --partial                 Also write the raw sums and sample counts, for the merge tool" << endl
+		<< "  --workers <count>         Render across this many local worker processes" << endl
+		<< "  --port <number>           Also accept remote workers on this port (default local only)" << endl
+		<< "  --job-samples <samples>   Samples per pixel in each distributed job (default about 4 jobs per worker)" << endl
+		<< "  --worker <host:port>      Render jobs for the coordinator at this address" << endl
+		<< "  --animation <file>        Render the keyframed camera and object moves as numbered JPG frames" << endl
+		<< "  --frames <count>          Number of animation frames (default up to the last key)" << endl
+		<< "  --shutter <duration>      Keep the shutter open from time 0 to this, blurring moving objects (default 0)" << endl
+		<< "  --rebuild-threshold <x>   Rebuild a refitted BVH once its SAH cost grows this many times (default 1.5)" << endl
+		<< "  --bench-packets           Time single rays against packets and exit" << endl
+		<< "  --bench-convergence       Write sampler RMSE against spp to a CSV file and exit" << endl
+		<< "  --bench-lights            Compare light selection RMSE at equal time, write a CSV file and exit" << endl
+		<< "  --bench-refit             Compare BVH rebuilds and refits over 100k moving spheres, write a CSV file and exit" << endl
+		<< "  --bench-build             Time BVH builds over 1M spheres with each preset and exit" << endl;
+}
+
+/*
+ * PARSE OPTIONS FUNCTION
+ *
+ * Function fills the render options from the command line.
+ * Returns false, after printing the usage, if an option is
+ * not recognised or is missing its value
+ */
+inline bool parseOptions(int argc, char* argv[], renderOptions& options)
+{
+	// Iterate over each argument
+	for (int i = 1; i < argc; i++)
+	{
+		// Obtain the argument
+		string argument = argv[i];
+
+		// Check if the option has a value following it
+		bool hasValue = i + 1 < argc;
+
+		// Check each option
+		if (argument == "--width" && hasValue)
+		{
+			// Image width
+			options.imageWidth = atoi(argv[++i]);
+		}
+		else if (argument == "--spp" && hasValue)
+		{
+			// Samples per pixel
+			options.samplesPerPixel = atoi(argv[++i]);
+		}
+		else if (argument == "--depth" && hasValue)
+		{
+			// Maximum depth
+			options.maxDepth = atoi(argv[++i]);
+		}
+		else if (argument == "--output" && hasValue)
+		{
+			// Output file name
+			options.fileName = argv[++i];
+		}
+		else if (argument == "--scene" && hasValue)
+		{
+			// Scene
+			options.scene = argv[++i];
+		}
+		else if (argument == "--mesh" && hasValue)
+		{
+			// Mesh file
+			options.meshFile = argv[++i];
+		}
+		else if (argument == "--scene-seed" && hasValue)
+		{
+			// Scene seed
+			options.sceneSeed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+		}
+		else if (argument == "--accel" && hasValue)
+		{
+			// Acceleration structure
+			options.accelerator = argv[++i];
+		}
+		else if (argument == "--bvh-preset" && hasValue)
+		{
+			// BVH build preset
+			options.bvhPreset = argv[++i];
+		}
+		else if (argument == "--build-threads" && hasValue)
+		{
+			// BVH build threads
+			options.buildThreads = atoi(argv[++i]);
+		}
+		else if (argument == "--materials" && hasValue)
+		{
+			// Material dispatch
+			options.materialDispatch = argv[++i];
+		}
+		else if (argument == "--no-packets")
+		{
+			// Single camera rays
+			options.usePackets = false;
+		}
+		else if (argument == "--integrator" && hasValue)
+		{
+			// Integrator
+			options.integrator = argv[++i];
+		}
+		else if (argument == "--pool" && hasValue)
+		{
+			// Wavefront pool size
+			options.poolSize = atoi(argv[++i]);
+		}
+		else if (argument == "--sort-rays")
+		{
+			// Ray reordering
+			options.sortRays = true;
+		}
+		else if (argument == "--sampler" && hasValue)
+		{
+			// Sampler
+			options.sampler = argv[++i];
+		}
+		else if (argument == "--seed" && hasValue)
+		{
+			// Sampler seed
+			options.seed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+		}
+		else if (argument == "--light-sampler" && hasValue)
+		{
+			// Light selection
+			options.lightSampler = argv[++i];
+		}
+		else if (argument == "--envmap" && hasValue)
+		{
+			// Environment map
+			options.environmentMap = argv[++i];
+		}
+		else if (argument == "--denoise")
+		{
+			// Denoiser
+			options.denoise = true;
+		}
+		else if (argument == "--aovs")
+		{
+			// AOV files
+			options.writeAovs = true;
+		}
+		else if (argument == "--partial")
+		{
+			// Partial image
+			options.writePartial = true;
+		}
+		else if (argument == "--workers" && hasValue)
+		{
+			// Local workers
+			options.workers = atoi(argv[++i]);
+		}
+		else if (argument == "--port" && hasValue)
+		{
+			// Coordinator port
+			options.port = atoi(argv[++i]);
+		}
+		else if (argument == "--job-samples" && hasValue)
+		{
+			// Samples per job
+			options.jobSamples = atoi(argv[++i]);
+		}
+		else if (argument == "--worker" && hasValue)
+		{
+			// Coordinator to work for
+			options.workerAddress = argv[++i];
+		}
+		else if (argument == "--animation" && hasValue)
+		{
+			// Keyframe file
+			options.animationFile = argv[++i];
+		}
+		else if (argument == "--frames" && hasValue)
+		{
+			// Animation frames
+			options.frameCount = atoi(argv[++i]);
+		}
+		else if (argument == "--shutter" && hasValue)
+		{
+			// Shutter interval
+			options.shutter = static_cast<float>(atof(argv[++i]));
+		}
+		else if (argument == "--rebuild-threshold" && hasValue)
+		{
+			// Refitted BVH rebuild threshold
+			options.rebuildThreshold = static_cast<float>(atof(argv[++i]));
+		}
+		else if (argument == "--bench-packets")
+		{
+			// Packet benchmark
+			options.benchmarkPackets = true;
+		}
+		else if (argument == "--bench-convergence")
+		{
+			// Convergence benchmark
+			options.benchmarkConvergence = true;
+		}
+		else if (argument == "--bench-lights")
+		{
+			// Light sampling benchmark
+			options.benchmarkLights = true;
+		}
+		else if (argument == "--bench-refit")
+		{
+			// BVH refit benchmark
+			options.benchmarkRefit = true;
+		}
+		else if (argument == "--bench-build")
+		{
+			// BVH build benchmark
+			options.benchmarkBuild = true;
+		}
+		else
+		{
+			// Unrecognised option
+			cerr << "Unrecognised option: " << argument << endl;
+			printUsage(argv[0]);
+			return false;
+		}
+	}
+
+	// Check the values are usable
+	if (options.imageWidth < 2 || options.samplesPerPixel < 1 || options.maxDepth < 0 || options.poolSize < 1 || options.buildThreads < 0)
+	{
+		// Invalid value
+		cerr << "Width must be at least 2, samples per pixel and pool size at least 1, and depth and build threads not negative" << endl;
+		return false;
+	}
+
+	// Check the shutter interval and rebuild threshold are usable
+	if (options.shutter < 0.0f || options.rebuildThreshold < 1.0f)
+	{
+		// Invalid value
+		cerr << "Shutter must not be negative, and the rebuild threshold must be at least 1" << endl;
+		return false;
+	}
+
+	// Check the distributed settings are usable
+	if (options.workers < 0 || options.port < 0 || options.port > 65535 || options.jobSamples < 0)
+	{
+		// Invalid value
+		cerr << "Workers and samples per job must not be negative, and the port must be from 0 to 65535" << endl;
+		return false;
+	}
+
+	// Check the animation settings are usable - frames are written as JPG files only
+	if (options.frameCount < 0 || (options.animationFile.empty() == false
+		&& (options.writeAovs || options.writePartial || options.workers > 0 || options.port > 0 || options.workerAddress.empty() == false)))
+	{
+		// Invalid combination
+		cerr << "Frames must not be negative, and an animation cannot write AOVs or partial images or be distributed" << endl;
+		return false;
+	}
+
+	// Return true
+	return true;
+}
+
+// End ifndef directive for RENDER_OPTIONS_H
+#endif
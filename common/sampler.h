@@ -0,0 +1,1371 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * SAMPLER HEADER FILE
+ *
+ * Header file containing the abstract sampler class and the
+ * independent, Halton, Sobol, correlated multi-jittered and blue
+ * noise samplers.
+ *
+ * A sampler hands out the random numbers of one pixel sample, one
+ * dimension at a time. Every pixel sample uses the same layout of
+ * dimensions (pixel offset, lens, then a fixed block per bounce),
+ * so low-discrepancy samplers stratify each decision of the path
+ * across the samples of a pixel
+ */
+
+// Declare ifndef directive for SAMPLER_H
+#ifndef SAMPLER_H
+
+// Define SAMPLER_H
+#define SAMPLER_H
+
+// Header files
+#include "common.h"
+#include "blueNoise.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+// **** SAMPLE DIMENSIONS **** //
+
+// Pixel offset - 2 dimensions
+const int pixelDimension = 0;
+
+// Lens position - 2 dimensions
+const int lensDimension = 2;
+
+// Time within the shutter interval - 1 dimension
+const int timeDimension = 4;
+
+// First dimension used by the bounces
+const int firstBounceDimension = 5;
+
+// Dimensions used by each bounce - a 2D direction sample and a 1D choice
+// for the material, then a 1D light choice and a 2D point on the light
+const int dimensionsPerBounce = 6;
+
+// Offset of the light sample within a bounce's dimensions
+const int lightDimensionOffset = 3;
+
+/*
+ * BOUNCE DIMENSION FUNCTION
+ *
+ * Function returns the first dimension used by a bounce
+ */
+inline int bounceDimension(int bounce)
+{
+	// Determine and return the dimension
+	return firstBounceDimension + bounce * dimensionsPerBounce;
+}
+
+// Largest float below 1
+const float oneMinusEpsilon = 0.99999994f;
+
+/* ==================================================================
+ * SAMPLE 2D STRUCT
+ *
+ * Struct containing a 2D sample, with each component in [0, 1)
+ * ==================================================================
+ */
+struct sample2D
+{
+	// First component
+	float x;
+
+	// Second component
+	float y;
+};
+
+// **** HASHING AND BIT FUNCTIONS **** //
+
+/*
+ * HASH FUNCTION
+ *
+ * Function mixes the bits of a 32-bit integer (lowbias32 by
+ * C. Wellons)
+ */
+inline uint32_t hashBits(uint32_t x)
+{
+	// Mix the bits
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+
+	// Return mixed bits
+	return x;
+}
+
+/*
+ * HASH COMBINE FUNCTION
+ *
+ * Function combines a value into a hash
+ */
+inline uint32_t hashCombine(uint32_t seed, uint32_t value)
+{
+	// Combine and mix
+	return hashBits(seed ^ (value + 0x9e3779b9u + (seed << 6) + (seed >> 2)));
+}
+
+/*
+ * REVERSE BITS FUNCTION
+ *
+ * Function reverses the order of the bits of a 32-bit integer
+ */
+inline uint32_t reverseBits(uint32_t x)
+{
+	// Swap halves, then quarters, and so on
+	x = (x << 16) | (x >> 16);
+	x = ((x & 0x00ff00ffu) << 8) | ((x & 0xff00ff00u) >> 8);
+	x = ((x & 0x0f0f0f0fu) << 4) | ((x & 0xf0f0f0f0u) >> 4);
+	x = ((x & 0x33333333u) << 2) | ((x & 0xccccccccu) >> 2);
+	x = ((x & 0x55555555u) << 1) | ((x & 0xaaaaaaaau) >> 1);
+
+	// Return the reversed bits
+	return x;
+}
+
+/*
+ * NESTED UNIFORM SCRAMBLE FUNCTION
+ *
+ * Function applies a hash-based Owen scramble to a 32-bit fixed
+ * point value (B. Burley, "Practical Hash-based Owen Scrambling",
+ * 2020). Each bit is flipped depending only on the bits above it
+ */
+inline uint32_t nestedUniformScramble(uint32_t x, uint32_t seed)
+{
+	// Reverse, so the higher bits become the lower bits
+	x = reverseBits(x);
+
+	// Laine-Karras permutation - each bit only affects the bits above it
+	x += seed;
+	x ^= x * 0x6c50b47cu;
+	x ^= x * 0xb82f1e52u;
+	x ^= x * 0xc7afe638u;
+	x ^= x * 0x8d22f6e6u;
+
+	// Reverse back
+	return reverseBits(x);
+}
+
+/*
+ * TO UNIT FLOAT FUNCTION
+ *
+ * Function converts a 32-bit fixed point value to a float in [0, 1)
+ */
+inline float toUnitFloat(uint32_t x)
+{
+	// Scale by 2^-32, keeping the result below 1
+	float f = x * 2.3283064365386963e-10f;
+	return f < oneMinusEpsilon ? f : oneMinusEpsilon;
+}
+
+/*
+ * PERMUTE ELEMENT FUNCTION
+ *
+ * Function returns element i of a pseudo-random permutation of
+ * length l, chosen by p, without storing the permutation
+ * (A. Kensler, "Correlated Multi-Jittered Sampling", 2013)
+ */
+inline uint32_t permuteElement(uint32_t i, uint32_t l, uint32_t p)
+{
+	// Mask covering the length
+	uint32_t w = l - 1;
+	w |= w >> 1; w |= w >> 2; w |= w >> 4; w |= w >> 8; w |= w >> 16;
+
+	// Cycle walk until the value lands inside the length
+	do
+	{
+		i ^= p; i *= 0xe170893du; i ^= p >> 16; i ^= (i & w) >> 4;
+		i ^= p >> 8; i *= 0x0929eb3fu; i ^= p >> 23; i ^= (i & w) >> 1;
+		i *= 1 | p >> 27; i *= 0x6935fa69u; i ^= (i & w) >> 11; i *= 0x74dcb303u;
+		i ^= (i & w) >> 2; i *= 0x9e501cc3u; i ^= (i & w) >> 2; i *= 0xc860a3dfu;
+		i &= w; i ^= i >> 5;
+	} while (i >= l);
+
+	// Return the permuted element
+	return (i + p) % l;
+}
+
+/* ==================================================================
+ * PCG32 CLASS
+ *
+ * Small, fast pseudo-random number generator (M. O'Neill, PCG32),
+ * which can jump ahead so a stream can be resumed at any position
+ * ==================================================================
+ */
+class pcg32
+{
+	// Public functions
+	public:
+		/*
+		 * DEFAULT PCG32 CONSTRUCTOR
+		 *
+		 * When invoked, creates a generator with a fixed seed
+		 */
+		pcg32()
+		{
+			// Seed with the default values
+			seed(0x853c49e6748fea9bull, 0xda3e39cb94b95bdbull);
+		}
+
+		/*
+		 * SEED FUNCTION
+		 *
+		 * Function seeds the generator with a starting state and
+		 * a stream
+		 */
+		void seed(uint64_t initialState, uint64_t stream)
+		{
+			// Set up the state and increment
+			_state = 0u;
+			_increment = (stream << 1u) | 1u;
+			nextUint();
+			_state += initialState;
+			nextUint();
+		}
+
+		/*
+		 * NEXT UINT FUNCTION
+		 *
+		 * Function returns the next 32-bit value
+		 */
+		uint32_t nextUint()
+		{
+			// Advance the state
+			uint64_t oldState = _state;
+			_state = oldState * 6364136223846793005ull + _increment;
+
+			// Output function - xorshift then random rotation
+			uint32_t xorShifted = static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+			uint32_t rotation = static_cast<uint32_t>(oldState >> 59u);
+			return (xorShifted >> rotation) | (xorShifted << ((~rotation + 1u) & 31u));
+		}
+
+		/*
+		 * NEXT FLOAT FUNCTION
+		 *
+		 * Function returns the next float in [0, 1)
+		 */
+		float nextFloat()
+		{
+			// Convert the next value
+			return toUnitFloat(nextUint());
+		}
+
+		/*
+		 * ADVANCE FUNCTION
+		 *
+		 * Function jumps the generator ahead by delta steps in
+		 * logarithmic time
+		 */
+		void advance(uint64_t delta)
+		{
+			// Accumulated multiplier and increment
+			uint64_t multiplier = 6364136223846793005ull;
+			uint64_t increment = _increment;
+			uint64_t accumulatedMultiplier = 1u;
+			uint64_t accumulatedIncrement = 0u;
+
+			// Square and multiply
+			while (delta > 0)
+			{
+				if (delta & 1u)
+				{
+					accumulatedMultiplier *= multiplier;
+					accumulatedIncrement = accumulatedIncrement * multiplier + increment;
+				}
+				increment = (multiplier + 1u) * increment;
+				multiplier *= multiplier;
+				delta >>= 1u;
+			}
+
+			// Apply the jump
+			_state = accumulatedMultiplier * _state + accumulatedIncrement;
+		}
+
+	// Private variables
+	private:
+		// Generator state
+		uint64_t _state;
+
+		// Stream increment - always odd
+		uint64_t _increment;
+};
+
+/* ==================================================================
+ * ABSTRACT SAMPLER CLASS
+ *
+ * Abstract of the sampler class. A pixel sample is started, then
+ * random numbers are taken one or two dimensions at a time
+ * ==================================================================
+ */
+class sampler
+{
+	// Public functions
+	public:
+		/*
+		 * SAMPLER DESTRUCTOR
+		 *
+		 * Virtual destructor, as samplers are used through pointers
+		 */
+		virtual ~sampler() {}
+
+		/*
+		 * START PIXEL SAMPLE FUNCTION
+		 *
+		 * Function starts sample sampleIndex of pixel (x, y), at
+		 * the given dimension
+		 */
+		virtual void startPixelSample(int x, int y, int sampleIndex, int dimension = 0) = 0;
+
+		/*
+		 * SET DIMENSION FUNCTION
+		 *
+		 * Function moves to a dimension of the current pixel sample,
+		 * so each bounce starts at the same dimension in every sample
+		 */
+		virtual void setDimension(int dimension) = 0;
+
+		/*
+		 * GET 1D FUNCTION
+		 *
+		 * Function returns the next dimension of the sample
+		 */
+		virtual float get1D() = 0;
+
+		/*
+		 * GET 2D FUNCTION
+		 *
+		 * Function returns the next two dimensions of the sample
+		 */
+		virtual sample2D get2D() = 0;
+
+		/*
+		 * GET NAME FUNCTION
+		 *
+		 * Function returns the name of the sampler
+		 */
+		virtual string getName() const = 0;
+};
+
+/* ==================================================================
+ * INDEPENDENT SAMPLER CLASS
+ *
+ * Sampler where every dimension is an independent uniform random
+ * number, from a PCG32 stream per pixel sample
+ * ==================================================================
+ */
+class independentSampler : public sampler
+{
+	// Public functions
+	public:
+		/*
+		 * INDEPENDENT SAMPLER CONSTRUCTOR
+		 *
+		 * When invoked, creates a sampler with a seed
+		 */
+		independentSampler(uint32_t seed) : _seed(seed) {}
+
+		/*
+		 * START PIXEL SAMPLE FUNCTION
+		 *
+		 * Function seeds the stream from the pixel and sample,
+		 * then jumps to the dimension
+		 */
+		virtual void startPixelSample(int x, int y, int sampleIndex, int dimension = 0) override
+		{
+			// Seed the stream from the pixel, and select the stream by the sample
+			_pixelHash = hashCombine(hashCombine(_seed, static_cast<uint32_t>(x)), static_cast<uint32_t>(y));
+			_sampleIndex = sampleIndex;
+			_rng.seed(_pixelHash, static_cast<uint64_t>(sampleIndex));
+			_rng.advance(static_cast<uint64_t>(dimension));
+			_dimension = dimension;
+		}
+
+		/*
+		 * SET DIMENSION FUNCTION
+		 *
+		 * Function moves the stream to a dimension, restarting the
+		 * stream to move backwards
+		 */
+		virtual void setDimension(int dimension) override
+		{
+			// Check if the dimension is behind the stream
+			if (dimension < _dimension)
+			{
+				// Restart the stream
+				_rng.seed(_pixelHash, static_cast<uint64_t>(_sampleIndex));
+				_dimension = 0;
+			}
+
+			// Jump ahead to the dimension
+			_rng.advance(static_cast<uint64_t>(dimension - _dimension));
+			_dimension = dimension;
+		}
+
+		/*
+		 * GET 1D FUNCTION
+		 *
+		 * Function returns the next random number
+		 */
+		virtual float get1D() override
+		{
+			// Next number from the stream
+			_dimension++;
+			return _rng.nextFloat();
+		}
+
+		/*
+		 * GET 2D FUNCTION
+		 *
+		 * Function returns the next two random numbers
+		 */
+		virtual sample2D get2D() override
+		{
+			// Next two numbers from the stream
+			sample2D s;
+			s.x = get1D();
+			s.y = get1D();
+			return s;
+		}
+
+		/*
+		 * GET NAME FUNCTION
+		 *
+		 * Function returns the name of the sampler
+		 */
+		virtual string getName() const override
+		{
+			// Return name
+			return "independent";
+		}
+
+	// Private variables
+	private:
+		// Seed
+		uint32_t _seed;
+
+		// Hash of the current pixel
+		uint32_t _pixelHash;
+
+		// Current sample index
+		int _sampleIndex;
+
+		// Current dimension
+		int _dimension;
+
+		// Random number stream
+		pcg32 _rng;
+};
+
+/* ==================================================================
+ * HALTON SAMPLER CLASS
+ *
+ * Sampler using the Halton sequence - dimension d is the radical
+ * inverse of the sample index in the d-th prime base. Each pixel
+ * and dimension gets its own Owen scramble of the digits, so pixels
+ * are decorrelated while each keeps the sequence's stratification.
+ * Dimensions past the prime table fall back to hashed random numbers
+ * ==================================================================
+ */
+class haltonSampler : public sampler
+{
+	// Public functions
+	public:
+		/*
+		 * HALTON SAMPLER CONSTRUCTOR
+		 *
+		 * When invoked, creates a sampler with a seed and builds
+		 * the table of prime bases
+		 */
+		haltonSampler(uint32_t seed) : _seed(seed)
+		{
+			// Find the primes by trial division
+			for (int candidate = 2; static_cast<int>(_primes.size()) < _maxDimensions; candidate++)
+			{
+				// Check if the candidate is divisible by a smaller prime
+				bool isPrime = true;
+				for (int p : _primes)
+				{
+					if (p * p > candidate) break;
+					if (candidate % p == 0) { isPrime = false; break; }
+				}
+
+				// Add the prime
+				if (isPrime)
+				{
+					_primes.push_back(candidate);
+				}
+			}
+		}
+
+		/*
+		 * START PIXEL SAMPLE FUNCTION
+		 *
+		 * Function starts sample sampleIndex of pixel (x, y)
+		 */
+		virtual void startPixelSample(int x, int y, int sampleIndex, int dimension = 0) override
+		{
+			// Record the pixel hash, sample and dimension
+			_pixelHash = hashCombine(hashCombine(_seed, static_cast<uint32_t>(x)), static_cast<uint32_t>(y));
+			_sampleIndex = static_cast<uint32_t>(sampleIndex);
+			_dimension = dimension;
+		}
+
+		/*
+		 * SET DIMENSION FUNCTION
+		 *
+		 * Function moves to a dimension
+		 */
+		virtual void setDimension(int dimension) override
+		{
+			// Set the dimension
+			_dimension = dimension;
+		}
+
+		/*
+		 * GET 1D FUNCTION
+		 *
+		 * Function returns the next dimension of the sample
+		 */
+		virtual float get1D() override
+		{
+			// Obtain the dimension, then move on
+			int dimension = _dimension++;
+
+			// Scramble seed for this pixel and dimension
+			uint32_t scrambleSeed = hashCombine(_pixelHash, static_cast<uint32_t>(dimension));
+
+			// Check if the dimension has a prime base
+			if (dimension < _maxDimensions)
+			{
+				// Scrambled radical inverse
+				return owenScrambledRadicalInverse(_primes[dimension], _sampleIndex, scrambleSeed);
+			}
+
+			// Fall back to a hashed random number
+			return toUnitFloat(hashCombine(scrambleSeed, _sampleIndex));
+		}
+
+		/*
+		 * GET 2D FUNCTION
+		 *
+		 * Function returns the next two dimensions of the sample
+		 */
+		virtual sample2D get2D() override
+		{
+			// Two consecutive dimensions
+			sample2D s;
+			s.x = get1D();
+			s.y = get1D();
+			return s;
+		}
+
+		/*
+		 * GET NAME FUNCTION
+		 *
+		 * Function returns the name of the sampler
+		 */
+		virtual string getName() const override
+		{
+			// Return name
+			return "halton";
+		}
+
+	// Private
+	private:
+		// Number of dimensions with a prime base
+		static const int _maxDimensions = 256;
+
+		// Prime bases
+		vector<int> _primes;
+
+		// Seed
+		uint32_t _seed;
+
+		// Hash of the current pixel
+		uint32_t _pixelHash;
+
+		// Current sample index
+		uint32_t _sampleIndex;
+
+		// Current dimension
+		int _dimension;
+
+		/*
+		 * OWEN SCRAMBLED RADICAL INVERSE FUNCTION
+		 *
+		 * Function mirrors the digits of index in a base about the
+		 * radix point, permuting each digit by a hash of the digits
+		 * before it
+		 */
+		static float owenScrambledRadicalInverse(int base, uint32_t index, uint32_t seed)
+		{
+			// Reciprocal of the base, and of the current digit's weight
+			const float inverseBase = 1.0f / base;
+			float inverseBaseM = 1.0f;
+
+			// Digits so far, reversed
+			uint64_t reversedDigits = 0;
+
+			// Continue until the digits no longer change the float
+			while (1.0f - (base - 1) * inverseBaseM < 1.0f)
+			{
+				// Obtain the next digit
+				uint32_t next = index / base;
+				uint32_t digit = index - next * base;
+
+				// Permute the digit by a hash of the digits before it
+				uint32_t digitHash = hashCombine(seed, static_cast<uint32_t>(reversedDigits));
+				digit = permuteElement(digit, static_cast<uint32_t>(base), digitHash);
+
+				// Append the digit
+				reversedDigits = reversedDigits * base + digit;
+				inverseBaseM *= inverseBase;
+				index = next;
+			}
+
+			// Return the mirrored value, kept below 1
+			float value = static_cast<float>(inverseBaseM * reversedDigits);
+			return value < oneMinusEpsilon ? value : oneMinusEpsilon;
+		}
+};
+
+/* ==================================================================
+ * SOBOL SAMPLER CLASS
+ *
+ * Sampler using the first two dimensions of the Sobol sequence,
+ * with hash-based Owen scrambling. Each pair of dimensions shuffles
+ * the sample index with its own seed (padding), and each component
+ * is Owen scrambled with its own seed
+ * ==================================================================
+ */
+class sobolSampler : public sampler
+{
+	// Public functions
+	public:
+		/*
+		 * SOBOL SAMPLER CONSTRUCTOR
+		 *
+		 * When invoked, creates a sampler with a seed
+		 */
+		sobolSampler(uint32_t seed) : _seed(seed) {}
+
+		/*
+		 * START PIXEL SAMPLE FUNCTION
+		 *
+		 * Function starts sample sampleIndex of pixel (x, y)
+		 */
+		virtual void startPixelSample(int x, int y, int sampleIndex, int dimension = 0) override
+		{
+			// Record the pixel hash, sample and dimension
+			_pixelHash = hashCombine(hashCombine(_seed, static_cast<uint32_t>(x)), static_cast<uint32_t>(y));
+			_sampleIndex = static_cast<uint32_t>(sampleIndex);
+			_dimension = dimension;
+		}
+
+		/*
+		 * SET DIMENSION FUNCTION
+		 *
+		 * Function moves to a dimension
+		 */
+		virtual void setDimension(int dimension) override
+		{
+			// Set the dimension
+			_dimension = dimension;
+		}
+
+		/*
+		 * GET 1D FUNCTION
+		 *
+		 * Function returns the next dimension of the sample
+		 */
+		virtual float get1D() override
+		{
+			// Seed for this pixel and dimension
+			uint32_t dimensionSeed = hashCombine(_pixelHash, static_cast<uint32_t>(_dimension++));
+
+			// Shuffle the index, then scramble the first Sobol dimension
+			uint32_t index = nestedUniformScramble(_sampleIndex, dimensionSeed);
+			return toUnitFloat(nestedUniformScramble(sobolFirst(index), hashBits(dimensionSeed)));
+		}
+
+		/*
+		 * GET 2D FUNCTION
+		 *
+		 * Function returns the next two dimensions of the sample
+		 */
+		virtual sample2D get2D() override
+		{
+			// Seed for this pixel and pair of dimensions
+			uint32_t dimensionSeed = hashCombine(_pixelHash, static_cast<uint32_t>(_dimension));
+			_dimension += 2;
+
+			// Shuffle the index, shared by both components
+			uint32_t index = nestedUniformScramble(_sampleIndex, dimensionSeed);
+
+			// Scramble each of the first two Sobol dimensions with its own seed
+			sample2D s;
+			s.x = toUnitFloat(nestedUniformScramble(sobolFirst(index), hashCombine(dimensionSeed, 1u)));
+			s.y = toUnitFloat(nestedUniformScramble(sobolSecond(index), hashCombine(dimensionSeed, 2u)));
+			return s;
+		}
+
+		/*
+		 * GET NAME FUNCTION
+		 *
+		 * Function returns the name of the sampler
+		 */
+		virtual string getName() const override
+		{
+			// Return name
+			return "sobol";
+		}
+
+	// Private
+	private:
+		// Seed
+		uint32_t _seed;
+
+		// Hash of the current pixel
+		uint32_t _pixelHash;
+
+		// Current sample index
+		uint32_t _sampleIndex;
+
+		// Current dimension
+		int _dimension;
+
+		/*
+		 * SOBOL FIRST FUNCTION
+		 *
+		 * Function returns the first Sobol dimension of an index,
+		 * as 32-bit fixed point - the van der Corput sequence
+		 */
+		static uint32_t sobolFirst(uint32_t index)
+		{
+			// Mirror the bits about the radix point
+			return reverseBits(index);
+		}
+
+		/*
+		 * SOBOL SECOND FUNCTION
+		 *
+		 * Function returns the second Sobol dimension of an index,
+		 * as 32-bit fixed point
+		 */
+		static uint32_t sobolSecond(uint32_t index)
+		{
+			// Accumulated value, and the direction number of the current bit
+			uint32_t x = 0;
+			uint32_t direction = 1u << 31;
+
+			// Exclusive-or in the direction number of each set bit
+			for (; index != 0; index >>= 1, direction ^= direction >> 1)
+			{
+				if (index & 1u)
+				{
+					x ^= direction;
+				}
+			}
+
+			// Return the value
+			return x;
+		}
+};
+
+/* ==================================================================
+ * CORRELATED MULTI-JITTERED SAMPLER CLASS
+ *
+ * Sampler which places the samples of a pixel in correlated
+ * multi-jittered patterns (A. Kensler, 2013) for the pixel offset
+ * and lens dimensions - each sample falls in its own cell of an
+ * m x n grid, and in its own row and column of an N x N grid. The
+ * pattern is built on the fly from the sample index, so it needs
+ * the number of samples per pixel up front. Bounce dimensions use
+ * independent random numbers
+ * ==================================================================
+ */
+class cmjSampler : public sampler
+{
+	// Public functions
+	public:
+		/*
+		 * CMJ SAMPLER CONSTRUCTOR
+		 *
+		 * When invoked, creates a sampler with a seed, for
+		 * samplesPerPixel samples in each pixel
+		 */
+		cmjSampler(uint32_t seed, int samplesPerPixel) : _seed(seed), _bounceSampler(seed)
+		{
+			// Determine the grid - as square as possible, with at least one cell per sample
+			_sampleCount = samplesPerPixel > 1 ? samplesPerPixel : 1;
+			_columns = static_cast<int>(sqrt(static_cast<float>(_sampleCount)));
+			_rows = (_sampleCount + _columns - 1) / _columns;
+		}
+
+		/*
+		 * START PIXEL SAMPLE FUNCTION
+		 *
+		 * Function starts sample sampleIndex of pixel (x, y). Sample
+		 * indices past the sample count wrap around to the start of
+		 * the pattern
+		 */
+		virtual void startPixelSample(int x, int y, int sampleIndex, int dimension = 0) override
+		{
+			// Record the pixel hash, sample and dimension
+			_pixelHash = hashCombine(hashCombine(_seed, static_cast<uint32_t>(x)), static_cast<uint32_t>(y));
+			_sampleIndex = static_cast<uint32_t>(sampleIndex % _sampleCount);
+			_dimension = dimension;
+
+			// Start the bounce stream
+			_bounceSampler.startPixelSample(x, y, sampleIndex, dimension);
+		}
+
+		/*
+		 * SET DIMENSION FUNCTION
+		 *
+		 * Function moves to a dimension
+		 */
+		virtual void setDimension(int dimension) override
+		{
+			// Set the dimension
+			_dimension = dimension;
+		}
+
+		/*
+		 * GET 1D FUNCTION
+		 *
+		 * Function returns the next dimension of the sample - a
+		 * jittered stratum for the camera dimensions, independent
+		 * otherwise
+		 */
+		virtual float get1D() override
+		{
+			// Check if the dimension is a bounce dimension
+			if (_dimension >= firstBounceDimension)
+			{
+				// Independent random number
+				_bounceSampler.setDimension(_dimension++);
+				return _bounceSampler.get1D();
+			}
+
+			// Pattern for this pixel and dimension
+			uint32_t pattern = hashCombine(_pixelHash, static_cast<uint32_t>(_dimension++));
+
+			// Jitter inside a shuffled stratum
+			uint32_t stratum = permuteElement(_sampleIndex, _sampleCount, pattern * 0x68bc21ebu);
+			float value = (stratum + toUnitFloat(hashCombine(pattern ^ 0x967a889bu, _sampleIndex))) / _sampleCount;
+			return value < oneMinusEpsilon ? value : oneMinusEpsilon;
+		}
+
+		/*
+		 * GET 2D FUNCTION
+		 *
+		 * Function returns the next two dimensions of the sample -
+		 * a correlated multi-jittered point for the camera
+		 * dimensions, independent otherwise
+		 */
+		virtual sample2D get2D() override
+		{
+			// Check if the dimensions are bounce dimensions
+			if (_dimension >= firstBounceDimension)
+			{
+				// Independent random numbers
+				_bounceSampler.setDimension(_dimension);
+				_dimension += 2;
+				return _bounceSampler.get2D();
+			}
+
+			// Pattern for this pixel and pair of dimensions
+			uint32_t pattern = hashCombine(_pixelHash, static_cast<uint32_t>(_dimension));
+			_dimension += 2;
+
+			// Shuffle the sample, then its column and row within the grid
+			uint32_t shuffled = permuteElement(_sampleIndex, _sampleCount, pattern * 0x51633e2du);
+			uint32_t column = permuteElement(shuffled % _columns, _columns, pattern * 0x68bc21ebu);
+			uint32_t row = permuteElement(shuffled / _columns, _rows, pattern * 0x02e5be93u);
+
+			// Jitter within the cell
+			float jitterX = toUnitFloat(hashCombine(pattern ^ 0x967a889bu, shuffled));
+			float jitterY = toUnitFloat(hashCombine(pattern ^ 0x368cc8b7u, shuffled));
+
+			// Place the point - x by cell then sub-column, y by the N x N row
+			sample2D s;
+			s.x = (column + (row + jitterX) / _rows) / _columns;
+			s.y = (shuffled + jitterY) / _sampleCount;
+			s.x = s.x < oneMinusEpsilon ? s.x : oneMinusEpsilon;
+			s.y = s.y < oneMinusEpsilon ? s.y : oneMinusEpsilon;
+			return s;
+		}
+
+		/*
+		 * GET NAME FUNCTION
+		 *
+		 * Function returns the name of the sampler
+		 */
+		virtual string getName() const override
+		{
+			// Return name
+			return "cmj";
+		}
+
+	// Private variables
+	private:
+		// Seed
+		uint32_t _seed;
+
+		// Number of samples in each pixel, and the grid they fill
+		uint32_t _sampleCount;
+		uint32_t _columns;
+		uint32_t _rows;
+
+		// Hash of the current pixel
+		uint32_t _pixelHash;
+
+		// Current sample index
+		uint32_t _sampleIndex;
+
+		// Current dimension
+		int _dimension;
+
+		// Random numbers for the bounce dimensions
+		independentSampler _bounceSampler;
+};
+
+/* ==================================================================
+ * BLUE NOISE SAMPLER CLASS
+ *
+ * Sampler for low sample count previews. Each dimension reads a
+ * tileable blue noise mask at its own offset, so the error of
+ * neighbouring pixels is negatively correlated and looks like fine
+ * grain rather than blotches. Successive samples rotate the mask
+ * value along a rank-1 lattice (Cranley-Patterson rotation by
+ * multiples of the golden ratio, or the R2 sequence for pairs), and
+ * the seed picks new offsets, so each frame gets a fresh pattern.
+ * Each dimension, or pair, walks the lattice in its own order - the
+ * sample index is Owen scrambled with a hash of the dimension - so
+ * the dimensions are not correlated with each other, while the
+ * first 2^k samples of any one still cover 2^k lattice points
+ * ==================================================================
+ */
+class blueNoiseSampler : public sampler
+{
+	// Public functions
+	public:
+		/*
+		 * BLUE NOISE SAMPLER CONSTRUCTOR
+		 *
+		 * When invoked, creates a sampler with a seed, which acts
+		 * as the frame number
+		 */
+		blueNoiseSampler(uint32_t seed) : _seed(seed), _mask(getMask()) {}
+
+		/*
+		 * START PIXEL SAMPLE FUNCTION
+		 *
+		 * Function starts sample sampleIndex of pixel (x, y)
+		 */
+		virtual void startPixelSample(int x, int y, int sampleIndex, int dimension = 0) override
+		{
+			// Record the pixel, sample and dimension
+			_x = x;
+			_y = y;
+			_sampleIndex = sampleIndex;
+			_dimension = dimension;
+		}
+
+		/*
+		 * SET DIMENSION FUNCTION
+		 *
+		 * Function moves to a dimension
+		 */
+		virtual void setDimension(int dimension) override
+		{
+			// Set the dimension
+			_dimension = dimension;
+		}
+
+		/*
+		 * GET 1D FUNCTION
+		 *
+		 * Function returns the next dimension of the sample, the mask
+		 * value rotated by a multiple of the golden ratio
+		 */
+		virtual float get1D() override
+		{
+			// Rotate the mask value along the lattice, in the dimension's order
+			uint32_t index = latticeIndex(_dimension);
+			return rotate(maskValue(_dimension++), index * 0x9e3779b9u);
+		}
+
+		/*
+		 * GET 2D FUNCTION
+		 *
+		 * Function returns the next two dimensions of the sample, the
+		 * mask values rotated along the R2 sequence
+		 */
+		virtual sample2D get2D() override
+		{
+			// Rotate each mask value along the lattice, in the pair's order, keeping the R2 structure of the pair
+			uint32_t index = latticeIndex(_dimension);
+			sample2D s;
+			s.x = rotate(maskValue(_dimension++), index * 0xc13fa9a9u);
+			s.y = rotate(maskValue(_dimension++), index * 0x91e10da6u);
+			return s;
+		}
+
+		/*
+		 * GET NAME FUNCTION
+		 *
+		 * Function returns the name of the sampler
+		 */
+		virtual string getName() const override
+		{
+			// Return name
+			return "bluenoise";
+		}
+
+	// Private
+	private:
+		// Seed - the frame number
+		uint32_t _seed;
+
+		// Blue noise mask, shared by every blue noise sampler
+		const blueNoiseMask& _mask;
+
+		// Current pixel
+		int _x;
+		int _y;
+
+		// Current sample index
+		int _sampleIndex;
+
+		// Current dimension
+		int _dimension;
+
+		/*
+		 * GET MASK FUNCTION
+		 *
+		 * Function returns the mask, generating it on first use
+		 */
+		static const blueNoiseMask& getMask()
+		{
+			// Generated once
+			static const blueNoiseMask mask(64);
+			return mask;
+		}
+
+		/*
+		 * MASK VALUE FUNCTION
+		 *
+		 * Function returns the mask value of the current pixel for a
+		 * dimension, offset by a hash of the frame and dimension
+		 */
+		float maskValue(int dimension) const
+		{
+			// Offset for this frame and dimension
+			uint32_t offset = hashCombine(_seed, static_cast<uint32_t>(dimension));
+			int size = _mask.getSize();
+
+			// Read the mask, keeping the coordinates positive
+			return _mask.getValue((_x % size + size) + static_cast<int>(offset % size), (_y % size + size) + static_cast<int>((offset >> 16) % size));
+		}
+
+		/*
+		 * LATTICE INDEX FUNCTION
+		 *
+		 * Function returns the lattice point of the current sample for
+		 * a dimension - the sample index Owen scrambled by a hash of
+		 * the frame and dimension. Each aligned block of 2^k indices
+		 * maps onto an aligned block of 2^k lattice points
+		 */
+		uint32_t latticeIndex(int dimension) const
+		{
+			// Scramble the index, leaving the block it lands in to its upper bits
+			return nestedUniformScramble(static_cast<uint32_t>(_sampleIndex), hashCombine(_seed ^ 0x68bc21ebu, static_cast<uint32_t>(dimension)));
+		}
+
+		/*
+		 * ROTATE FUNCTION
+		 *
+		 * Function adds a shift, as a 32-bit fixed point fraction, to a
+		 * value, wrapping to [0, 1). The shift is a multiple of a
+		 * lattice generator, wrapped exactly by the integer multiply
+		 */
+		static float rotate(float value, uint32_t shift)
+		{
+			// Wrap the sum
+			float rotated = value + toUnitFloat(shift);
+			rotated -= floor(rotated);
+			return rotated < oneMinusEpsilon ? rotated : oneMinusEpsilon;
+		}
+};
+
+/* ==================================================================
+ * SAMPLE RANGE SAMPLER CLASS
+ *
+ * Sampler which renders a range of another sampler's samples - the
+ * sample indices given to it are moved along by the first sample of
+ * the range. Renders of consecutive ranges then add up to exactly
+ * the samples of one render over the whole count
+ * ==================================================================
+ */
+class sampleRangeSampler : public sampler
+{
+	// Public functions
+	public:
+		/*
+		 * SAMPLE RANGE SAMPLER CONSTRUCTOR
+		 *
+		 * When invoked, creates a sampler drawing from base,
+		 * starting at sample firstSample
+		 */
+		sampleRangeSampler(sampler& base, int firstSample) : _base(base), _firstSample(firstSample) {}
+
+		/*
+		 * START PIXEL SAMPLE FUNCTION
+		 *
+		 * Function starts sample sampleIndex of the range
+		 */
+		virtual void startPixelSample(int x, int y, int sampleIndex, int dimension = 0) override
+		{
+			// Start the matching sample of the base sampler
+			_base.startPixelSample(x, y, _firstSample + sampleIndex, dimension);
+		}
+
+		/*
+		 * SET DIMENSION FUNCTION
+		 *
+		 * Function moves to a dimension
+		 */
+		virtual void setDimension(int dimension) override
+		{
+			// Forward to the base sampler
+			_base.setDimension(dimension);
+		}
+
+		/*
+		 * GET 1D FUNCTION
+		 *
+		 * Function returns the next dimension of the sample
+		 */
+		virtual float get1D() override
+		{
+			// Forward to the base sampler
+			return _base.get1D();
+		}
+
+		/*
+		 * GET 2D FUNCTION
+		 *
+		 * Function returns the next two dimensions of the sample
+		 */
+		virtual sample2D get2D() override
+		{
+			// Forward to the base sampler
+			return _base.get2D();
+		}
+
+		/*
+		 * GET NAME FUNCTION
+		 *
+		 * Function returns the name of the base sampler
+		 */
+		virtual string getName() const override
+		{
+			// Return name
+			return _base.getName();
+		}
+
+	// Private
+	private:
+		// Sampler the samples are drawn from
+		sampler& _base;
+
+		// Index of the first sample of the range
+		int _firstSample;
+};
+
+/*
+ * CREATE SAMPLER FUNCTION
+ *
+ * Function creates a sampler by name, returning null if the
+ * name is not recognised. Samplers which build a pattern over
+ * the samples of a pixel use samplesPerPixel
+ */
+inline shared_ptr<sampler> createSampler(const string& name, uint32_t seed, int samplesPerPixel)
+{
+	// Check the name
+	if (name == "independent")
+	{
+		// Independent random numbers
+		return make_shared<independentSampler>(seed);
+	}
+	else if (name == "halton")
+	{
+		// Scrambled Halton
+		return make_shared<haltonSampler>(seed);
+	}
+	else if (name == "sobol")
+	{
+		// Owen-scrambled Sobol
+		return make_shared<sobolSampler>(seed);
+	}
+	else if (name == "cmj")
+	{
+		// Correlated multi-jittered camera dimensions
+		return make_shared<cmjSampler>(seed, samplesPerPixel);
+	}
+	else if (name == "bluenoise")
+	{
+		// Blue noise mask with rank-1 rotation
+		return make_shared<blueNoiseSampler>(seed);
+	}
+
+	// Unknown sampler
+	return nullptr;
+}
+
+// **** SAMPLE WARPING FUNCTIONS **** //
+
+// Each function maps a fixed number of uniform samples to its
+// distribution in closed form - no rejection loops, so every bounce
+// uses the same number of random numbers, and the only branches are
+// selects
+
+/*
+ * SAMPLE UNIT DISK FUNCTION
+ *
+ * Function maps a 2D sample to a uniformly distributed point in the
+ * unit disk, with Shirley and Chiu's concentric mapping, which keeps
+ * the sample's stratification with little distortion
+ */
+inline vec3 sampleUnitDisk(const sample2D& u)
+{
+	// Map the sample to [-1, 1] squared
+	float a = 2.0f * u.x - 1.0f;
+	float b = 2.0f * u.y - 1.0f;
+
+	// Choose the wedge - the larger coordinate gives the radius
+	bool useA = fabs(a) > fabs(b);
+	float r = useA ? a : b;
+	float theta = useA ? (pi / 4.0f) * (b / a) : (pi / 2.0f) - (pi / 4.0f) * (a / b);
+
+	// Centre of the square maps to the centre of the disk
+	theta = r != 0.0f ? theta : 0.0f;
+
+	// Return the point
+	return vec3(r * cos(theta), r * sin(theta), 0.0f);
+}
+
+/*
+ * SAMPLE UNIT SPHERE FUNCTION
+ *
+ * Function maps a 2D sample to a uniformly distributed direction
+ * on the unit sphere
+ */
+inline vec3 sampleUnitSphere(const sample2D& u)
+{
+	// Determine the height and the radius of that slice
+	float z = 1.0f - 2.0f * u.x;
+	float r = sqrt(fmax(0.0f, 1.0f - z * z));
+
+	// Determine the angle around the slice
+	float phi = 2.0f * pi * u.y;
+
+	// Return the direction
+	return vec3(r * cos(phi), r * sin(phi), z);
+}
+
+/*
+ * SAMPLE UNIT BALL FUNCTION
+ *
+ * Function maps a 2D sample and a 1D sample to a uniformly
+ * distributed point in the unit ball - the same distribution as
+ * the rejection loop of randomInUnitSphere
+ */
+inline vec3 sampleUnitBall(const sample2D& u, float w)
+{
+	// Uniform direction, scaled so the volume is filled evenly
+	return cbrt(w) * sampleUnitSphere(u);
+}
+
+/*
+ * SAMPLE IN HEMISPHERE FUNCTION
+ *
+ * Function maps a 2D sample and a 1D sample to a point in the unit
+ * ball on the same side as the normal - the same distribution as
+ * randomInHemisphere
+ */
+inline vec3 sampleInHemisphere(const vec3& normal, const sample2D& u, float w)
+{
+	// Obtain point in the unit ball
+	vec3 inUnitSphere = sampleUnitBall(u, w);
+
+	// Flip the point into the normal's hemisphere
+	return (dot(inUnitSphere, normal) > 0.0f ? 1.0f : -1.0f) * inUnitSphere;
+}
+
+/*
+ * ORTHONORMAL BASIS FUNCTION
+ *
+ * Function builds two unit tangents perpendicular to a unit normal,
+ * without branches (T. Duff et al., "Building an Orthonormal Basis,
+ * Revisited", 2017)
+ */
+inline void orthonormalBasis(const vec3& normal, vec3& tangent, vec3& bitangent)
+{
+	// Sign of the normal's z, treating 0 as positive
+	float sign = copysign(1.0f, normal.getZ());
+	float a = -1.0f / (sign + normal.getZ());
+	float b = normal.getX() * normal.getY() * a;
+
+	// Determine the tangents
+	tangent = vec3(1.0f + sign * normal.getX() * normal.getX() * a, sign * b, -sign * normal.getX());
+	bitangent = vec3(b, sign + normal.getY() * normal.getY() * a, -normal.getY());
+}
+
+/*
+ * SAMPLE COSINE HEMISPHERE FUNCTION
+ *
+ * Function maps a 2D sample to a unit direction in the hemisphere
+ * around a unit normal, with density proportional to the cosine to
+ * the normal - lifting a concentric disk sample onto the hemisphere
+ */
+inline vec3 sampleCosineHemisphere(const vec3& normal, const sample2D& u)
+{
+	// Point in the disk, and its height above the disk
+	vec3 d = sampleUnitDisk(u);
+	float z = sqrt(fmax(0.0f, 1.0f - d.getX() * d.getX() - d.getY() * d.getY()));
+
+	// Tangents around the normal
+	vec3 tangent, bitangent;
+	orthonormalBasis(normal, tangent, bitangent);
+
+	// Return the direction
+	return d.getX() * tangent + d.getY() * bitangent + z * normal;
+}
+
+// End ifndef directive for SAMPLER_H
+#endif
@@ -0,0 +1,137 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * SCENE FINGERPRINT HEADER FILE
+ *
+ * Header file containing the scene fingerprint - the options which
+ * decide what a render's samples are of. Renders adding their
+ * samples together, whether workers of one distributed render or
+ * partial images merged afterwards, compare fingerprints first, so
+ * samples of a different scene are never mixed into the image
+ */
+
+// Declare ifndef directive for SCENE_FINGERPRINT_H
+#ifndef SCENE_FINGERPRINT_H
+
+// Define SCENE_FINGERPRINT_H
+#define SCENE_FINGERPRINT_H
+
+// Header files
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * SCENE FINGERPRINT STRUCT
+ *
+ * Struct of fixed size, sent and written as raw bytes. Names are
+ * zero padded, and cut short if too long
+ * ==================================================================
+ */
+struct sceneFingerprint
+{
+	// Scene name, followed by the OBJ file for the mesh scene
+	char scene[32];
+
+	// Sampler name
+	char sampler[16];
+
+	// Seed the scene was generated from
+	uint32_t sceneSeed;
+
+	// Seed of the sampler
+	uint32_t samplerSeed;
+
+	// Samples per pixel the sampler was set up for
+	uint32_t samplesPerPixel;
+};
+
+/*
+ * MAKE FINGERPRINT FUNCTION
+ *
+ * Function returns the fingerprint of a render
+ */
+inline sceneFingerprint makeFingerprint(const string& scene, unsigned int sceneSeed, const string& sampler, unsigned int samplerSeed, int samplesPerPixel)
+{
+	// Fill the fingerprint, leaving a zero at the end of each name
+	sceneFingerprint fingerprint = {};
+	strncpy(fingerprint.scene, scene.c_str(), sizeof(fingerprint.scene) - 1);
+	strncpy(fingerprint.sampler, sampler.c_str(), sizeof(fingerprint.sampler) - 1);
+	fingerprint.sceneSeed = sceneSeed;
+	fingerprint.samplerSeed = samplerSeed;
+	fingerprint.samplesPerPixel = static_cast<uint32_t>(samplesPerPixel);
+	return fingerprint;
+}
+
+/*
+ * SAME SCENE FUNCTION
+ *
+ * Function determines if two fingerprints are of the same scene,
+ * drawn with the same sampler - the sampler's seed and samples
+ * per pixel may differ
+ */
+inline bool sameScene(const sceneFingerprint& a, const sceneFingerprint& b)
+{
+	// Compare the names and the scene seed
+	return strncmp(a.scene, b.scene, sizeof(a.scene)) == 0 && strncmp(a.sampler, b.sampler, sizeof(a.sampler)) == 0 && a.sceneSeed == b.sceneSeed;
+}
+
+/*
+ * SAME RENDER FUNCTION
+ *
+ * Function determines if two fingerprints are of the same scene
+ * drawn with the same sequence of samples
+ */
+inline bool sameRender(const sceneFingerprint& a, const sceneFingerprint& b)
+{
+	// Compare the scene, then the sampler's set up
+	return sameScene(a, b) && a.samplerSeed == b.samplerSeed && a.samplesPerPixel == b.samplesPerPixel;
+}
+
+/*
+ * FINGERPRINT NAME FUNCTION
+ *
+ * Function returns a zero padded name as a string - a name read
+ * from a file or socket may fill its array with no zero
+ */
+inline string fingerprintName(const char* name, size_t size)
+{
+	// Stop at the first zero, if any
+	string text(name, size);
+	return text.substr(0, text.find('\0'));
+}
+
+/*
+ * DESCRIBE FINGERPRINT FUNCTION
+ *
+ * Function returns a fingerprint as text, for error messages
+ */
+inline string describeFingerprint(const sceneFingerprint& fingerprint)
+{
+	// Output each field
+	ostringstream text;
+	text << "scene " << fingerprintName(fingerprint.scene, sizeof(fingerprint.scene)) << " (seed " << fingerprint.sceneSeed << "), sampler "
+		<< fingerprintName(fingerprint.sampler, sizeof(fingerprint.sampler)) << " (seed " << fingerprint.samplerSeed << ", " << fingerprint.samplesPerPixel << " spp)";
+	return text.str();
+}
+
+// End ifndef directive for SCENE_FINGERPRINT_H
+#endif
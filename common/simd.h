@@ -0,0 +1,242 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * SIMD HEADER FILE
+ *
+ * Header file containing a 4-wide float vector, used for the packet
+ * intersection tests. Uses SSE where the compiler provides it, and
+ * a plain array of 4 floats everywhere else
+ */
+
+// Declare ifndef directive for SIMD_H
+#ifndef SIMD_H
+
+// Define SIMD_H
+#define SIMD_H
+
+// Check if SSE2 is available (always the case on x86-64)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE 1
+#include <emmintrin.h>
+#else
+#define SIMD_SSE 0
+#include <cmath>
+#endif
+
+// Number of floats in a SIMD vector
+const int simdWidth = 4;
+
+/* ==================================================================
+ * FLOAT4 STRUCT
+ *
+ * Struct for a vector of 4 floats. Comparisons return masks, which
+ * are float4s with every bit of a lane set (true) or clear (false)
+ * ==================================================================
+ */
+struct float4
+{
+#if SIMD_SSE
+	// SSE register
+	__m128 v;
+
+	/*
+	 * DEFAULT FLOAT4 CONSTRUCTOR
+	 *
+	 * When invoked, creates an uninitialised vector
+	 */
+	float4() {}
+
+	/*
+	 * FLOAT4 CONSTRUCTOR
+	 *
+	 * When invoked, creates a vector with every lane set to s
+	 */
+	float4(float s) : v(_mm_set1_ps(s)) {}
+
+	/*
+	 * FLOAT4 CONSTRUCTOR
+	 *
+	 * When invoked, wraps an SSE register
+	 */
+	explicit float4(__m128 r) : v(r) {}
+
+	/*
+	 * LOAD FUNCTION
+	 *
+	 * Function loads 4 floats from 16-byte aligned memory
+	 */
+	static float4 load(const float* p)
+	{
+		// Aligned load
+		return float4(_mm_load_ps(p));
+	}
+
+	/*
+	 * LOAD MASK FUNCTION
+	 *
+	 * Function loads 4 integer flags, returning a mask which is
+	 * true for every non-zero flag
+	 */
+	static float4 loadMask(const int* p)
+	{
+		// Compare the flags against zero, then invert
+		__m128i zero = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_setzero_si128());
+		return float4(_mm_andnot_ps(_mm_castsi128_ps(zero), _mm_castsi128_ps(_mm_set1_epi32(-1))));
+	}
+
+	/*
+	 * STORE FUNCTION
+	 *
+	 * Function stores 4 floats to 16-byte aligned memory
+	 */
+	void store(float* p) const
+	{
+		// Aligned store
+		_mm_store_ps(p, v);
+	}
+#else
+	// Lanes
+	float v[4];
+
+	/*
+	 * DEFAULT FLOAT4 CONSTRUCTOR
+	 *
+	 * When invoked, creates an uninitialised vector
+	 */
+	float4() {}
+
+	/*
+	 * FLOAT4 CONSTRUCTOR
+	 *
+	 * When invoked, creates a vector with every lane set to s
+	 */
+	float4(float s)
+	{
+		// Set each lane
+		for (int i = 0; i < 4; i++) v[i] = s;
+	}
+
+	/*
+	 * LOAD FUNCTION
+	 *
+	 * Function loads 4 floats from memory
+	 */
+	static float4 load(const float* p)
+	{
+		// Copy each lane
+		float4 r;
+		for (int i = 0; i < 4; i++) r.v[i] = p[i];
+		return r;
+	}
+
+	/*
+	 * LOAD MASK FUNCTION
+	 *
+	 * Function loads 4 integer flags, returning a mask which is
+	 * true for every non-zero flag
+	 */
+	static float4 loadMask(const int* p)
+	{
+		// Mask each lane
+		float4 r;
+		for (int i = 0; i < 4; i++) r.v[i] = p[i] != 0 ? 1.0f : 0.0f;
+		return r;
+	}
+
+	/*
+	 * STORE FUNCTION
+	 *
+	 * Function stores 4 floats to memory
+	 */
+	void store(float* p) const
+	{
+		// Copy each lane
+		for (int i = 0; i < 4; i++) p[i] = v[i];
+	}
+#endif
+};
+
+#if SIMD_SSE
+
+// Arithmetic
+inline float4 operator+(const float4& a, const float4& b) { return float4(_mm_add_ps(a.v, b.v)); }
+inline float4 operator-(const float4& a, const float4& b) { return float4(_mm_sub_ps(a.v, b.v)); }
+inline float4 operator*(const float4& a, const float4& b) { return float4(_mm_mul_ps(a.v, b.v)); }
+inline float4 operator/(const float4& a, const float4& b) { return float4(_mm_div_ps(a.v, b.v)); }
+inline float4 minimum(const float4& a, const float4& b) { return float4(_mm_min_ps(a.v, b.v)); }
+inline float4 maximum(const float4& a, const float4& b) { return float4(_mm_max_ps(a.v, b.v)); }
+inline float4 squareRoot(const float4& a) { return float4(_mm_sqrt_ps(a.v)); }
+
+// Comparisons, returning masks
+inline float4 operator<(const float4& a, const float4& b) { return float4(_mm_cmplt_ps(a.v, b.v)); }
+inline float4 operator>(const float4& a, const float4& b) { return float4(_mm_cmpgt_ps(a.v, b.v)); }
+inline float4 operator<=(const float4& a, const float4& b) { return float4(_mm_cmple_ps(a.v, b.v)); }
+
+// Mask operations
+inline float4 operator&(const float4& a, const float4& b) { return float4(_mm_and_ps(a.v, b.v)); }
+inline float4 operator|(const float4& a, const float4& b) { return float4(_mm_or_ps(a.v, b.v)); }
+inline bool anyTrue(const float4& mask) { return _mm_movemask_ps(mask.v) != 0; }
+
+/*
+ * SELECT FUNCTION
+ *
+ * Function returns a where the mask is true, and b elsewhere
+ */
+inline float4 select(const float4& mask, const float4& a, const float4& b)
+{
+	// Blend with and, and-not, or
+	return float4(_mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)));
+}
+
+#else
+
+// Arithmetic
+inline float4 operator+(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] + b.v[i]; return r; }
+inline float4 operator-(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] - b.v[i]; return r; }
+inline float4 operator*(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] * b.v[i]; return r; }
+inline float4 operator/(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] / b.v[i]; return r; }
+inline float4 minimum(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] < b.v[i] ? a.v[i] : b.v[i]; return r; }
+inline float4 maximum(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] > b.v[i] ? a.v[i] : b.v[i]; return r; }
+inline float4 squareRoot(const float4& a) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = std::sqrt(a.v[i]); return r; }
+
+// Comparisons, returning masks of 1 (true) and 0 (false)
+inline float4 operator<(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] < b.v[i] ? 1.0f : 0.0f; return r; }
+inline float4 operator>(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] > b.v[i] ? 1.0f : 0.0f; return r; }
+inline float4 operator<=(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = a.v[i] <= b.v[i] ? 1.0f : 0.0f; return r; }
+
+// Mask operations
+inline float4 operator&(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = (a.v[i] != 0.0f && b.v[i] != 0.0f) ? 1.0f : 0.0f; return r; }
+inline float4 operator|(const float4& a, const float4& b) { float4 r; for (int i = 0; i < 4; i++) r.v[i] = (a.v[i] != 0.0f || b.v[i] != 0.0f) ? 1.0f : 0.0f; return r; }
+inline bool anyTrue(const float4& mask) { return mask.v[0] != 0.0f || mask.v[1] != 0.0f || mask.v[2] != 0.0f || mask.v[3] != 0.0f; }
+
+/*
+ * SELECT FUNCTION
+ *
+ * Function returns a where the mask is true, and b elsewhere
+ */
+inline float4 select(const float4& mask, const float4& a, const float4& b)
+{
+	// Choose each lane
+	float4 r;
+	for (int i = 0; i < 4; i++) r.v[i] = mask.v[i] != 0.0f ? a.v[i] : b.v[i];
+	return r;
+}
+
+#endif
+
+// End ifndef directive for SIMD_H
+#endif
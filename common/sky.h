@@ -0,0 +1,52 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * SKY HEADER FILE
+ *
+ * Header file containing the colour of rays which escape the scene,
+ * shared by every integrator
+ */
+
+// Declare ifndef directive for SKY_H
+#ifndef SKY_H
+
+// Define SKY_H
+#define SKY_H
+
+// Header files
+#include "common.h"
+
+/*
+ * SKY COLOUR FUNCTION
+ *
+ * Function is used to determine and return the
+ * colour of a ray which escapes the scene
+ */
+inline colour skyColour(const ray& r)
+{
+	// Determine the unit direction of the ray
+	vec3 unitDirection = unitVector(r.getDirection());
+
+	// Obtain ray parameter, t
+	auto  t = 0.5 * (unitDirection.getY() + 1.0);
+
+	// Determine and return the sky colour
+	return (1.0 - t) * colour(1.0, 1.0, 1.0) + t * colour(0.5, 0.7, 1.0);
+}
+
+// End ifndef directive for SKY_H
+#endif
@@ -4,7 +4,7 @@
  * GRAEME B. WHITE - 40415739
  *
  * DATE OF CREATION: 11/10/2020
- * DATE LAST MODIFIED: 14/10/2020
+ * DATE LAST MODIFIED: 18/10/2026
  * ==================================================================
  * PATH-TRACING PROTOTYPE
  *
@@ -29,6 +29,7 @@
 
 // Header files
 #include "hittable.h"
+#include "materialTable.h"
 #include "vec3.h"
 
 /* ==================================================================
@@ -57,7 +58,7 @@ class sphere : public hittable
 		 * Creates a sphere with centre c and radius r
 		 */
 		sphere(point3 c, float r, shared_ptr<material> m) :
-			_centre(c), _radius(r), _sphereMaterial(m) {};
+			_centre(c), _radius(r), _sphereMaterial(m), _materialIndex(-1), _lightIndex(-1), _objectIndex(-1) {};
 
 		/*
 		 * HIT FUNCTION
@@ -68,6 +69,44 @@ class sphere : public hittable
 		 */
 		virtual bool hit(const ray& r, float tMin, float tMax, hitRecord& rec) const override;
 
+		/*
+		 * OCCLUDED FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Determines if either root lies between tMin and tMax,
+		 * without finding the point, normal or material
+		 */
+		virtual bool occluded(const ray& r, float tMin, float tMax) const override;
+
+		/*
+		 * BOUNDING BOX FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Obtains the box which bounds the sphere
+		 */
+		virtual bool boundingBox(aabb& outputBox) const override;
+
+		/*
+		 * BIND MATERIALS FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Adds the sphere's material to the table
+		 */
+		virtual void bindMaterials(materialTable& table) override
+		{
+			// Record the material's index
+			_materialIndex = table.add(_sphereMaterial);
+		}
+
+		/*
+		 * HIT PACKET FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Tests every lane of a ray packet against the sphere
+		 * in one vectorised loop
+		 */
+		virtual void hitPacket(const rayPacket& packet, float tMin, float tMax[], hitRecord rec[], bool hits[]) const override;
+
 		/*
 		 * GET CENTRE FUNCTION
 		 * 
@@ -83,6 +122,46 @@ class sphere : public hittable
 		 */
 		float getRadius() const;
 
+		/*
+		 * GET MATERIAL FUNCTION
+		 *
+		 * Function returns the material of the sphere
+		 */
+		shared_ptr<material> getMaterial() const;
+
+		/*
+		 * SET LIGHT INDEX FUNCTION
+		 *
+		 * Function records the sphere's index in the scene lights,
+		 * so hits on it can find the light
+		 */
+		void setLightIndex(int index);
+
+		/*
+		 * SET OBJECT INDEX FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Records the sphere's index in the scene
+		 */
+		virtual void setObjectIndex(int index) override
+		{
+			// Record the object's index
+			_objectIndex = index;
+		}
+
+		/*
+		 * SET CENTRE FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Moves the sphere's centre
+		 */
+		virtual bool setCentre(const point3& centre) override
+		{
+			// Move the centre
+			_centre = centre;
+			return true;
+		}
+
 	// Private
 	private:
 		// Sphere centre
@@ -93,6 +172,15 @@ class sphere : public hittable
 
 		// Material
 		shared_ptr<material> _sphereMaterial;
+
+		// Index of the material in the material table
+		int _materialIndex;
+
+		// Index of the light in the scene lights, or -1
+		int _lightIndex;
+
+		// Index of the sphere in the scene, or -1
+		int _objectIndex;
 };
 
 /*
@@ -115,6 +203,27 @@ float sphere::getRadius() const
 	return _radius;
 }
 
+/*
+ * GET MATERIAL FUNCTION
+ *
+ * Function returns the material of the sphere
+ */
+shared_ptr<material> sphere::getMaterial() const
+{
+	return _sphereMaterial;
+}
+
+/*
+ * SET LIGHT INDEX FUNCTION
+ *
+ * Function records the sphere's index in the scene lights,
+ * so hits on it can find the light
+ */
+void sphere::setLightIndex(int index)
+{
+	_lightIndex = index;
+}
+
 /*
  * HIT FUNCTION
  *
@@ -168,6 +277,9 @@ bool sphere::hit(const ray& r, float tMin, float tMax, hitRecord& rec) const
 
 			// Set material
 			rec.materialPointer = _sphereMaterial;
+			rec.materialIndex = _materialIndex;
+			rec.lightIndex = _lightIndex;
+			rec.objectIndex = _objectIndex;
 
 			// Set hitableSphere to true
 			hitSphere = true;
@@ -196,6 +308,9 @@ bool sphere::hit(const ray& r, float tMin, float tMax, hitRecord& rec) const
 
 			// Set material
 			rec.materialPointer = _sphereMaterial;
+			rec.materialIndex = _materialIndex;
+			rec.lightIndex = _lightIndex;
+			rec.objectIndex = _objectIndex;
 
 			// Set hitableSphere to true
 			hitSphere = true;
@@ -209,5 +324,141 @@ bool sphere::hit(const ray& r, float tMin, float tMax, hitRecord& rec) const
 	return hitSphere;
 }
 
+/*
+ * OCCLUDED FUNCTION
+ *
+ * Overridden function from abstract hittable class.
+ * Determines if either root lies between tMin and tMax,
+ * without finding the point, normal or material
+ */
+bool sphere::occluded(const ray& r, float tMin, float tMax) const
+{
+	// Determine the components of the quadratic formula, as for hit
+	vec3 oc = r.getOrigin() - _centre;
+	float a = r.getDirection().lengthSquared();
+	float halfB = dot(oc, r.getDirection());
+	float c = oc.lengthSquared() - _radius * _radius;
+	float discriminant = (halfB * halfB) - (a * c);
+
+	// Check if the ray misses the sphere
+	if (discriminant <= 0.0f)
+	{
+		// Not blocked
+		return false;
+	}
+
+	// Check the near root, then the far root
+	float root = sqrt(discriminant);
+	float nearT = (-halfB - root) / a;
+	float farT = (-halfB + root) / a;
+	return (nearT < tMax && nearT > tMin) || (farT < tMax && farT > tMin);
+}
+
+/*
+ * BOUNDING BOX FUNCTION
+ *
+ * Overridden function from abstract hittable class.
+ * Obtains the box which bounds the sphere
+ */
+bool sphere::boundingBox(aabb& outputBox) const
+{
+	// Obtain the absolute radius - hollow spheres use a negative radius
+	float absoluteRadius = fabs(_radius);
+
+	// Determine the box from the centre and radius
+	outputBox = aabb(_centre - vec3(absoluteRadius, absoluteRadius, absoluteRadius), _centre + vec3(absoluteRadius, absoluteRadius, absoluteRadius));
+
+	// Return true
+	return true;
+}
+
+/*
+ * HIT PACKET FUNCTION
+ *
+ * Overridden function from abstract hittable class.
+ * Tests every lane of a ray packet against the sphere
+ * in one vectorised loop
+ */
+void sphere::hitPacket(const rayPacket& packet, float tMin, float tMax[], hitRecord rec[], bool hits[]) const
+{
+	// Ray parameter of each lane's hit, or infinity for a miss
+	alignas(16) float laneT[packetWidth];
+
+	// Obtain the centre, radius squared, and interval start as vectors
+	const float4 centreX(_centre.getX());
+	const float4 centreY(_centre.getY());
+	const float4 centreZ(_centre.getZ());
+	const float4 radiusSquared(_radius * _radius);
+	const float4 intervalStart(tMin);
+	const float4 zero(0.0f);
+	const float4 miss(infinity);
+
+	// Branch-free quadratic, 4 lanes at a time
+	for (int lane = 0; lane < packetWidth; lane += simdWidth)
+	{
+		// Load the lanes' rays and closest hits
+		float4 directionX = float4::load(packet.directionX + lane);
+		float4 directionY = float4::load(packet.directionY + lane);
+		float4 directionZ = float4::load(packet.directionZ + lane);
+		float4 closest = float4::load(tMax + lane);
+
+		// Determine the vector from the ray origin to the sphere centre
+		float4 ocX = float4::load(packet.originX + lane) - centreX;
+		float4 ocY = float4::load(packet.originY + lane) - centreY;
+		float4 ocZ = float4::load(packet.originZ + lane) - centreZ;
+
+		// Determine 'a', 'half b' and 'c' components of the quadratic formula
+		float4 a = directionX * directionX + directionY * directionY + directionZ * directionZ;
+		float4 halfB = ocX * directionX + ocY * directionY + ocZ * directionZ;
+		float4 c = ocX * ocX + ocY * ocY + ocZ * ocZ - radiusSquared;
+
+		// Determine the discriminant, and its root clamped to keep misses well defined
+		float4 discriminant = halfB * halfB - a * c;
+		float4 root = squareRoot(maximum(discriminant, zero));
+
+		// Determine the near and far roots
+		float4 nearT = (zero - halfB - root) / a;
+		float4 farT = (zero - halfB + root) / a;
+
+		// Select the nearest root within the lane's interval
+		float4 nearValid = (nearT < closest) & (nearT > intervalStart);
+		float4 farValid = (farT < closest) & (farT > intervalStart);
+		float4 t = select(nearValid, nearT, select(farValid, farT, miss));
+
+		// Misses and inactive lanes become infinity
+		float4 valid = (discriminant > zero) & float4::loadMask(packet.active + lane);
+		select(valid, t, miss).store(laneT + lane);
+	}
+
+	// Fill the hit records of the lanes which hit
+	for (int lane = 0; lane < packetWidth; lane++)
+	{
+		// Check if lane hit the sphere
+		if (laneT[lane] < tMax[lane])
+		{
+			// Obtain the ray of the lane
+			ray r = packet.getRay(lane);
+
+			// Set recorded ray parameter and point of collision
+			rec[lane].t = laneT[lane];
+			rec[lane].p = r.at(laneT[lane]);
+
+			// Determine the outward normal, the face, and record the normal
+			vec3 outwardNormal = (rec[lane].p - _centre) / _radius;
+			rec[lane].setFaceNormal(r, outwardNormal);
+
+			// Set material
+			rec[lane].materialPointer = _sphereMaterial;
+			rec[lane].materialIndex = _materialIndex;
+			rec[lane].lightIndex = _lightIndex;
+			rec[lane].objectIndex = _objectIndex;
+
+			// Shrink the lane's interval and record the hit
+			tMax[lane] = laneT[lane];
+			hits[lane] = true;
+		}
+	}
+}
+
 // End ifndef directive for HITTABLE_SPHERE_H
 #endif
\ No newline at end of file
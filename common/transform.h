@@ -0,0 +1,245 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * TRANSFORM HEADER FILE
+ *
+ * Header file containing the affine transform class - a 3x3 linear
+ * part (rotation, scale and shear) followed by a translation, used
+ * to place instances of shared geometry in the scene
+ */
+
+// Declare ifndef directive for TRANSFORM_H
+#ifndef TRANSFORM_H
+
+// Define TRANSFORM_H
+#define TRANSFORM_H
+
+// Header files
+#include "common.h"
+#include "aabb.h"
+
+/* ==================================================================
+ * AFFINE TRANSFORM CLASS
+ *
+ * Class for an affine transform, p' = L p + t. Transforms are
+ * combined with the * operator - (a * b) applies b first, then a
+ * ==================================================================
+ */
+class affineTransform
+{
+	// Public functions
+	public:
+		/*
+		 * DEFAULT AFFINE TRANSFORM CONSTRUCTOR
+		 *
+		 * When invoked, creates the identity transform
+		 */
+		affineTransform() : _translation(0.0f, 0.0f, 0.0f)
+		{
+			// Set the linear part to the identity
+			for (int row = 0; row < 3; row++)
+			{
+				for (int column = 0; column < 3; column++)
+				{
+					_linear[row][column] = row == column ? 1.0f : 0.0f;
+				}
+			}
+		}
+
+		/*
+		 * TRANSLATION FUNCTION
+		 *
+		 * Function returns a transform which moves points by offset
+		 */
+		static affineTransform translation(const vec3& offset)
+		{
+			// Identity with a translation
+			affineTransform result;
+			result._translation = offset;
+			return result;
+		}
+
+		/*
+		 * SCALING FUNCTION
+		 *
+		 * Function returns a transform which scales each axis about
+		 * the origin
+		 */
+		static affineTransform scaling(const vec3& scale)
+		{
+			// Scale on the diagonal
+			affineTransform result;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				result._linear[axis][axis] = scale[axis];
+			}
+			return result;
+		}
+
+		/*
+		 * ROTATION FUNCTION
+		 *
+		 * Function returns a transform which rotates by an angle,
+		 * in degrees, about an axis through the origin (Rodrigues'
+		 * rotation formula)
+		 */
+		static affineTransform rotation(const vec3& axis, float degrees)
+		{
+			// Obtain the unit axis and the sine and cosine of the angle
+			vec3 k = unitVector(axis);
+			float angle = degreesToRadians(degrees);
+			float c = cos(angle);
+			float s = sin(angle);
+
+			// R = cI + s[k]x + (1 - c)kk^T
+			affineTransform result;
+			for (int row = 0; row < 3; row++)
+			{
+				for (int column = 0; column < 3; column++)
+				{
+					result._linear[row][column] = (row == column ? c : 0.0f) + (1.0f - c) * k[row] * k[column];
+				}
+			}
+			result._linear[0][1] -= s * k[2]; result._linear[0][2] += s * k[1];
+			result._linear[1][0] += s * k[2]; result._linear[1][2] -= s * k[0];
+			result._linear[2][0] -= s * k[1]; result._linear[2][1] += s * k[0];
+			return result;
+		}
+
+		/*
+		 * COMBINE OPERATOR
+		 *
+		 * When invoked, returns the transform which applies other,
+		 * then this transform
+		 */
+		affineTransform operator*(const affineTransform& other) const
+		{
+			// Combine the linear parts, and carry other's translation through this transform
+			affineTransform result;
+			for (int row = 0; row < 3; row++)
+			{
+				for (int column = 0; column < 3; column++)
+				{
+					result._linear[row][column] = _linear[row][0] * other._linear[0][column] + _linear[row][1] * other._linear[1][column] + _linear[row][2] * other._linear[2][column];
+				}
+			}
+			result._translation = transformPoint(other._translation);
+			return result;
+		}
+
+		/*
+		 * INVERSE FUNCTION
+		 *
+		 * Function returns the transform which undoes this one. The
+		 * linear part must not be singular
+		 */
+		affineTransform inverse() const
+		{
+			// Invert the linear part from its cofactors
+			affineTransform result;
+			const float (&m)[3][3] = _linear;
+			float determinant = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+				- m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+				+ m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+			float inverseDeterminant = 1.0f / determinant;
+			result._linear[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) * inverseDeterminant;
+			result._linear[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inverseDeterminant;
+			result._linear[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inverseDeterminant;
+			result._linear[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * inverseDeterminant;
+			result._linear[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inverseDeterminant;
+			result._linear[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inverseDeterminant;
+			result._linear[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) * inverseDeterminant;
+			result._linear[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inverseDeterminant;
+			result._linear[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inverseDeterminant;
+
+			// Undo the translation after the inverse linear part
+			result._translation = -result.transformVector(_translation);
+			return result;
+		}
+
+		/*
+		 * TRANSFORM POINT FUNCTION
+		 *
+		 * Function returns a point moved by the transform
+		 */
+		point3 transformPoint(const point3& p) const
+		{
+			// Linear part, then translation
+			return transformVector(p) + _translation;
+		}
+
+		/*
+		 * TRANSFORM VECTOR FUNCTION
+		 *
+		 * Function returns a direction moved by the transform -
+		 * the linear part only
+		 */
+		vec3 transformVector(const vec3& v) const
+		{
+			// Multiply by the linear part
+			return vec3(_linear[0][0] * v[0] + _linear[0][1] * v[1] + _linear[0][2] * v[2],
+				_linear[1][0] * v[0] + _linear[1][1] * v[1] + _linear[1][2] * v[2],
+				_linear[2][0] * v[0] + _linear[2][1] * v[1] + _linear[2][2] * v[2]);
+		}
+
+		/*
+		 * TRANSFORM NORMAL FUNCTION
+		 *
+		 * Function returns a normal moved by the transform whose
+		 * inverse this is - multiplied by the transpose of the
+		 * linear part, so normals stay perpendicular to surfaces
+		 * under non-uniform scale. Not normalised
+		 */
+		vec3 transformNormalByInverse(const vec3& n) const
+		{
+			// Multiply by the transpose of the linear part
+			return vec3(_linear[0][0] * n[0] + _linear[1][0] * n[1] + _linear[2][0] * n[2],
+				_linear[0][1] * n[0] + _linear[1][1] * n[1] + _linear[2][1] * n[2],
+				_linear[0][2] * n[0] + _linear[1][2] * n[1] + _linear[2][2] * n[2]);
+		}
+
+		/*
+		 * TRANSFORM BOX FUNCTION
+		 *
+		 * Function returns the box which bounds a box moved by the
+		 * transform - the bounds of its eight moved corners
+		 */
+		aabb transformBox(const aabb& box) const
+		{
+			// Grow around each corner
+			aabb result;
+			for (int corner = 0; corner < 8; corner++)
+			{
+				point3 p((corner & 1) ? box.getMax().getX() : box.getMin().getX(),
+					(corner & 2) ? box.getMax().getY() : box.getMin().getY(),
+					(corner & 4) ? box.getMax().getZ() : box.getMin().getZ());
+				result.grow(transformPoint(p));
+			}
+			return result;
+		}
+
+	// Private variables
+	private:
+		// Linear part, by row then column
+		float _linear[3][3];
+
+		// Translation
+		vec3 _translation;
+};
+
+// End ifndef directive for TRANSFORM_H
+#endif
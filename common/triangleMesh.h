@@ -0,0 +1,476 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * HITTABLE TRIANGLE MESH CLASS
+ *
+ * Header file containing the hittable triangle mesh class - a
+ * shared vertex buffer and an index buffer of three vertices per
+ * triangle, under a hierarchy of its own. Triangles are not objects
+ * of their own, so a mesh costs a few bytes per triangle and one
+ * virtual call per ray, however many triangles it has
+ */
+
+// Declare ifndef directive for TRIANGLE_MESH_H
+#ifndef TRIANGLE_MESH_H
+
+// Define TRIANGLE_MESH_H
+#define TRIANGLE_MESH_H
+
+// Header files
+#include "bvh.h"
+#include "hittable.h"
+#include "materialTable.h"
+#include "simd.h"
+#include "vec3.h"
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * TRIANGLE MESH CLASS
+ *
+ * Class for triangle mesh objects. Extension of the hittable
+ * abstract class.
+ *
+ * Triangles face the side their vertices wind anticlockwise
+ * around. Normals, if given, are one per vertex and interpolated
+ * across each triangle for shading. Rays are tested against the
+ * triangles of a leaf 4 at a time, with the watertight test of
+ * Woop, Benthin and Wald - rays cannot slip between triangles
+ * which share an edge
+ * ==================================================================
+ */
+class triangleMesh : public hittable
+{
+	// Public
+	public:
+		/*
+		 * TRIANGLE MESH CONSTRUCTOR
+		 *
+		 * Creates a mesh of the triangles in indices, three
+		 * indices into vertices each, and builds its hierarchy.
+		 * Normals are one per vertex, or empty for flat shading.
+		 * Every index must be a vertex
+		 */
+		triangleMesh(vector<point3> vertices, vector<int> indices, vector<vec3> normals, shared_ptr<material> m, bvhPreset preset = BVH_QUALITY, int threadCount = 1);
+
+		/*
+		 * HIT FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Finds the closest triangle hit by a ray
+		 */
+		virtual bool hit(const ray& r, float tMin, float tMax, hitRecord& rec) const override;
+
+		/*
+		 * OCCLUDED FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Determines if any triangle blocks a ray, stopping at
+		 * the first one found
+		 */
+		virtual bool occluded(const ray& r, float tMin, float tMax) const override;
+
+		/*
+		 * BOUNDING BOX FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Obtains the box which bounds every triangle
+		 */
+		virtual bool boundingBox(aabb& outputBox) const override
+		{
+			// Return the bounds of the hierarchy
+			return _hierarchy.boundingBox(outputBox);
+		}
+
+		/*
+		 * BIND MATERIALS FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Adds the mesh's material to the table
+		 */
+		virtual void bindMaterials(materialTable& table) override
+		{
+			// Record the material's index
+			_materialIndex = table.add(_meshMaterial);
+		}
+
+		/*
+		 * SET OBJECT INDEX FUNCTION
+		 *
+		 * Overridden function from abstract hittable class.
+		 * Records the mesh's index in the scene
+		 */
+		virtual void setObjectIndex(int index) override
+		{
+			// Record the object's index
+			_objectIndex = index;
+		}
+
+		/*
+		 * GET TRIANGLE COUNT FUNCTION
+		 *
+		 * Function returns the number of triangles
+		 */
+		int getTriangleCount() const
+		{
+			// Three indices per triangle
+			return static_cast<int>(_indices.size() / 3);
+		}
+
+		/*
+		 * GET VERTEX COUNT FUNCTION
+		 *
+		 * Function returns the number of vertices
+		 */
+		int getVertexCount() const
+		{
+			// Return the size of the vertex buffer
+			return static_cast<int>(_vertices.size());
+		}
+
+		/*
+		 * GET HIERARCHY FUNCTION
+		 *
+		 * Function returns the hierarchy over the triangles
+		 */
+		const bvh& getHierarchy() const
+		{
+			// Return hierarchy
+			return _hierarchy;
+		}
+
+		/*
+		 * GET MEMORY SIZE FUNCTION
+		 *
+		 * Function returns the bytes held by the vertex, normal
+		 * and index buffers and the hierarchy's nodes
+		 */
+		size_t getMemorySize() const
+		{
+			// Sum the buffers
+			return _vertices.size() * sizeof(point3) + _normals.size() * sizeof(vec3) + _indices.size() * sizeof(int)
+				+ _hierarchy.getNodeCount() * sizeof(bvhNode);
+		}
+
+	// Private
+	private:
+		// Vertex positions
+		vector<point3> _vertices;
+
+		// Vertex normals, or empty for flat shading
+		vector<vec3> _normals;
+
+		// Three vertex indices per triangle, ordered so each leaf covers a contiguous range of triangles
+		vector<int> _indices;
+
+		// Hierarchy over the triangles
+		bvh _hierarchy;
+
+		// Material
+		shared_ptr<material> _meshMaterial;
+
+		// Index of the material in the material table
+		int _materialIndex;
+
+		// Index of the mesh in the scene, or -1
+		int _objectIndex;
+
+		/* ==============================================================
+		 * SHEARED RAY STRUCT
+		 *
+		 * Struct for a ray set up for the watertight test - the
+		 * axes are permuted so z is the direction's largest, and
+		 * the shear maps the direction onto the z axis
+		 * ==============================================================
+		 */
+		struct shearedRay
+		{
+			// Ray origin
+			point3 origin;
+
+			// Axes which become x, y and z
+			int kx, ky, kz;
+
+			// Shear constants
+			float sx, sy, sz;
+		};
+
+		/*
+		 * SHEAR RAY FUNCTION
+		 *
+		 * Function returns a ray set up for the watertight test
+		 */
+		static shearedRay shearRay(const ray& r);
+
+		/*
+		 * INTERSECT LEAF FUNCTION
+		 *
+		 * Function tests a ray against count triangles from first,
+		 * 4 at a time, and returns the closest hit before closest,
+		 * or -1. Lowers closest to the hit and records its
+		 * barycentric coordinates
+		 */
+		int intersectLeaf(const shearedRay& r, int first, int count, float tMin, float& closest, float& hitU, float& hitV) const;
+};
+
+/*
+ * TRIANGLE MESH CONSTRUCTOR
+ *
+ * Creates a mesh of the triangles in indices, three
+ * indices into vertices each, and builds its hierarchy.
+ * Normals are one per vertex, or empty for flat shading.
+ * Every index must be a vertex
+ */
+triangleMesh::triangleMesh(vector<point3> vertices, vector<int> indices, vector<vec3> normals, shared_ptr<material> m, bvhPreset preset, int threadCount) :
+	_vertices(move(vertices)), _normals(move(normals)), _indices(move(indices)), _meshMaterial(m), _materialIndex(-1), _objectIndex(-1)
+{
+	// Drop any incomplete triangle, and normals which do not match the vertices
+	const int triangleCount = static_cast<int>(_indices.size() / 3);
+	_indices.resize(3 * triangleCount);
+	if (_normals.size() != _vertices.size())
+	{
+		_normals.clear();
+	}
+
+	// Bound each triangle
+	vector<aabb> bounds(triangleCount);
+	for (int i = 0; i < triangleCount; i++)
+	{
+		bounds[i].grow(_vertices[_indices[3 * i]]);
+		bounds[i].grow(_vertices[_indices[3 * i + 1]]);
+		bounds[i].grow(_vertices[_indices[3 * i + 2]]);
+	}
+
+	// Build the hierarchy over the bounds
+	vector<int> order;
+	_hierarchy.setBuildSettings(preset, threadCount);
+	_hierarchy.buildFromBounds(bounds, order);
+
+	// Reorder the triangles to follow the leaves
+	vector<int> indicesInOrder(_indices.size());
+	for (int i = 0; i < triangleCount; i++)
+	{
+		for (int corner = 0; corner < 3; corner++)
+		{
+			indicesInOrder[3 * i + corner] = _indices[3 * order[i] + corner];
+		}
+	}
+	_indices.swap(indicesInOrder);
+}
+
+/*
+ * HIT FUNCTION
+ *
+ * Overridden function from abstract hittable class.
+ * Finds the closest triangle hit by a ray
+ */
+bool triangleMesh::hit(const ray& r, float tMin, float tMax, hitRecord& rec) const
+{
+	// Closest triangle so far, and where it was hit
+	float closest = tMax;
+	int triangle = -1;
+	float u = 0.0f, v = 0.0f;
+
+	// Set the ray up for the triangle tests once
+	const shearedRay sheared = shearRay(r);
+
+	// Walk the hierarchy, testing the triangles of each leaf reached
+	bool hitAnything = _hierarchy.traverse(r, tMin, closest, false, [&](int first, int count, float& closestSoFar)
+	{
+		// Test the leaf, keeping the closest triangle
+		int leafTriangle = intersectLeaf(sheared, first, count, tMin, closestSoFar, u, v);
+		if (leafTriangle >= 0)
+		{
+			triangle = leafTriangle;
+			return true;
+		}
+		return false;
+	});
+
+	// Check if any triangle was hit
+	if (hitAnything == false)
+	{
+		// No hit
+		return false;
+	}
+
+	// Obtain the triangle's vertices
+	const int i0 = _indices[3 * triangle];
+	const int i1 = _indices[3 * triangle + 1];
+	const int i2 = _indices[3 * triangle + 2];
+	const point3& p0 = _vertices[i0];
+
+	// Record the ray parameter and point of collision
+	rec.t = closest;
+	rec.p = r.at(closest);
+
+	// Determine the face from the geometric normal
+	rec.setFaceNormal(r, unitVector(cross(_vertices[i1] - p0, _vertices[i2] - p0)));
+
+	// Check if the mesh has vertex normals
+	if (_normals.empty() == false)
+	{
+		// Interpolate the vertex normals, on the side of the face hit
+		vec3 shadingNormal = unitVector((1.0f - u - v) * _normals[i0] + u * _normals[i1] + v * _normals[i2]);
+		rec.normal = rec.frontFace ? shadingNormal : -shadingNormal;
+	}
+
+	// Set material - meshes are not gathered as lights
+	rec.materialPointer = _meshMaterial;
+	rec.materialIndex = _materialIndex;
+	rec.lightIndex = -1;
+	rec.objectIndex = _objectIndex;
+
+	// Return true
+	return true;
+}
+
+/*
+ * OCCLUDED FUNCTION
+ *
+ * Overridden function from abstract hittable class.
+ * Determines if any triangle blocks a ray, stopping at
+ * the first one found
+ */
+bool triangleMesh::occluded(const ray& r, float tMin, float tMax) const
+{
+	// Set the ray up for the triangle tests once
+	const shearedRay sheared = shearRay(r);
+
+	// Walk the hierarchy until a triangle blocks the ray
+	float u, v;
+	return _hierarchy.traverse(r, tMin, tMax, true, [&](int first, int count, float& closest)
+	{
+		// Check if a triangle of the leaf blocks the ray
+		return intersectLeaf(sheared, first, count, tMin, closest, u, v) >= 0;
+	});
+}
+
+/*
+ * SHEAR RAY FUNCTION
+ *
+ * Function returns a ray set up for the watertight test
+ */
+triangleMesh::shearedRay triangleMesh::shearRay(const ray& r)
+{
+	// Make z the axis the direction is largest along
+	const vec3 direction = r.getDirection();
+	shearedRay sheared;
+	sheared.origin = r.getOrigin();
+	sheared.kz = fabs(direction.getX()) > fabs(direction.getY()) ? (fabs(direction.getX()) > fabs(direction.getZ()) ? 0 : 2) : (fabs(direction.getY()) > fabs(direction.getZ()) ? 1 : 2);
+	sheared.kx = (sheared.kz + 1) % 3;
+	sheared.ky = (sheared.kx + 1) % 3;
+
+	// Swap x and y for rays along negative z, so the winding is kept
+	if (direction[sheared.kz] < 0.0f)
+	{
+		swap(sheared.kx, sheared.ky);
+	}
+
+	// Determine the shear which takes the direction onto the z axis
+	sheared.sx = direction[sheared.kx] / direction[sheared.kz];
+	sheared.sy = direction[sheared.ky] / direction[sheared.kz];
+	sheared.sz = 1.0f / direction[sheared.kz];
+	return sheared;
+}
+
+/*
+ * INTERSECT LEAF FUNCTION
+ *
+ * Function tests a ray against count triangles from first,
+ * 4 at a time, and returns the closest hit before closest,
+ * or -1. Lowers closest to the hit and records its
+ * barycentric coordinates
+ */
+int triangleMesh::intersectLeaf(const shearedRay& r, int first, int count, float tMin, float& closest, float& hitU, float& hitV) const
+{
+	// Closest triangle hit
+	int hitTriangle = -1;
+
+	// Obtain the ray as vectors
+	const float4 originX(r.origin[r.kx]), originY(r.origin[r.ky]), originZ(r.origin[r.kz]);
+	const float4 shearX(r.sx), shearY(r.sy), shearZ(r.sz);
+	const float4 zero(0.0f), miss(infinity);
+
+	// Test the triangles 4 at a time
+	for (int group = first; group < first + count; group += simdWidth)
+	{
+		// Gather each lane's vertices from the shared buffers, in the permuted axes - missing lanes are degenerate, and never hit
+		alignas(16) float corner[3][3][simdWidth];
+		for (int lane = 0; lane < simdWidth; lane++)
+		{
+			const int* triangle = group + lane < first + count ? &_indices[3 * (group + lane)] : nullptr;
+			for (int vertex = 0; vertex < 3; vertex++)
+			{
+				const point3 p = triangle != nullptr ? _vertices[triangle[vertex]] : r.origin;
+				corner[vertex][0][lane] = p[r.kx];
+				corner[vertex][1][lane] = p[r.ky];
+				corner[vertex][2][lane] = p[r.kz];
+			}
+		}
+
+		// Move the vertices relative to the origin, and shear them so the ray runs along z
+		float4 aZ = float4::load(corner[0][2]) - originZ;
+		float4 bZ = float4::load(corner[1][2]) - originZ;
+		float4 cZ = float4::load(corner[2][2]) - originZ;
+		float4 aX = float4::load(corner[0][0]) - originX - shearX * aZ;
+		float4 aY = float4::load(corner[0][1]) - originY - shearY * aZ;
+		float4 bX = float4::load(corner[1][0]) - originX - shearX * bZ;
+		float4 bY = float4::load(corner[1][1]) - originY - shearY * bZ;
+		float4 cX = float4::load(corner[2][0]) - originX - shearX * cZ;
+		float4 cY = float4::load(corner[2][1]) - originY - shearY * cZ;
+
+		// Determine the scaled barycentric coordinates from the edge functions - a shared edge gives exactly opposite values in its two triangles
+		float4 u = cX * bY - cY * bX;
+		float4 v = aX * cY - aY * cX;
+		float4 w = bX * aY - bY * aX;
+
+		// Determine the ray parameter - a zero determinant gives infinities or NaNs, which fail the tests below
+		float4 determinant = u + v + w;
+		float4 t = (u * (shearZ * aZ) + v * (shearZ * bZ) + w * (shearZ * cZ)) / determinant;
+
+		// Lane hits if the edge functions agree in sign and the hit is within the interval
+		float4 inside = ((zero <= u) & (zero <= v) & (zero <= w)) | ((u <= zero) & (v <= zero) & (w <= zero));
+		float4 valid = inside & (t > float4(tMin)) & (t < float4(closest));
+
+		// Keep the closest lane hit
+		alignas(16) float laneT[simdWidth], laneV[simdWidth], laneW[simdWidth], laneDeterminant[simdWidth];
+		select(valid, t, miss).store(laneT);
+		v.store(laneV);
+		w.store(laneW);
+		determinant.store(laneDeterminant);
+		for (int lane = 0; lane < simdWidth; lane++)
+		{
+			if (laneT[lane] < closest)
+			{
+				// Record the hit - the weights of the second and third vertices
+				closest = laneT[lane];
+				hitU = laneV[lane] / laneDeterminant[lane];
+				hitV = laneW[lane] / laneDeterminant[lane];
+				hitTriangle = group + lane;
+			}
+		}
+	}
+
+	// Return the closest triangle hit
+	return hitTriangle;
+}
+
+// End ifndef directive for TRIANGLE_MESH_H
+#endif
@@ -4,7 +4,7 @@
  * GRAEME B. WHITE - 40415739
  *
  * DATE OF CREATION: 10/10/2020
- * DATE LAST MODIFIED: 12/10/2020
+ * DATE LAST MODIFIED: 18/10/2026
  * ==================================================================
  * PATH-TRACING PROTOTYPE
  *
@@ -413,27 +413,21 @@ inline vec3 unitVector(vec3 vec)
 /*
  * RANDOM IN UNIT SPHERE FUNCTION
  *
- * Funtion picks a random point and determines if it is
- * within a unit sphere
+ * Funtion returns a random point within a unit sphere,
+ * found directly rather than by rejecting points outside it
  */
 vec3 randomInUnitSphere()
 {
-	// While loop
-	while (true) 
-	{
-		// Obtain random point between -1 and 1
-		auto p = vec3::random(-1, 1);
+	// Obtain random direction
+	auto z = randomFloat(-1, 1);
+	auto a = randomFloat(0, 2 * pi);
+	auto r = sqrt(fmax(0.0f, 1 - z * z));
 
-		// Check if point is in the unit sphere
-		if (p.lengthSquared() >= 1)
-		{
-			// Point is not in the sphere, reject the point and continue
-			continue;
-		}
+	// Obtain random distance from the centre, cube root so the volume is filled evenly
+	auto radius = cbrt(randomFloat());
 
-		// Return the value of P
-		return p;
-	}
+	// Return the point
+	return radius * vec3(r * cos(a), r * sin(a), z);
 }
 
 /*
@@ -516,26 +510,17 @@ vec3 refract(const vec3& uv, const vec3& n, float eta1DivEta2)
 /*
  * RANDOM IN UNIT DISK FUNCTION
  * 
- * Function returns a vector that is found in a 
+ * Function returns a random point within a unit disk,
+ * found directly rather than by rejecting points outside it
  */
 vec3 randomInUnitDisk()
 {
-	// While true loop
-	while (true) 
-	{
-		// Obtain a vector with random x and y values
-		auto p = vec3(randomFloat(-1, 1), randomFloat(-1, 1), 0);
-		
-		// Check if the lenght of the vector is greater than, or equal to, 1
-		if (p.lengthSquared() >= 1)
-		{
-			// Reject the vector and continue
-			continue;
-		}
+	// Obtain random distance, square root so the area is filled evenly, and angle
+	auto r = sqrt(randomFloat());
+	auto a = randomFloat(0, 2 * pi);
 
-		// Return vector
-		return p;
-	}
+	// Return the point
+	return vec3(r * cos(a), r * sin(a), 0);
 }
 
 // End ifndef directive for VEC3_H
@@ -0,0 +1,697 @@
+/* ==================================================================
+ * SET10110 - ADVANCED GAMES ENGINEERING
+ *
+ * GRAEME B. WHITE - 40415739
+ *
+ * DATE OF CREATION: 18/10/2026
+ * DATE LAST MODIFIED: 18/10/2026
+ * ==================================================================
+ * PATH-TRACING PROTOTYPE
+ *
+ * Prototype version of the path-tracer developed for SET10110 -
+ * Advanced Games Engineering.
+ *
+ * Work is based on the path tracer developed in "Ray Tracing in one
+ * Weekend" by P. Shirley - https://raytracing.github.io/
+ *
+ * ==================================================================
+ * WAVEFRONT INTEGRATOR HEADER FILE
+ *
+ * Header file containing the wavefront (streaming) integrator.
+ *
+ * Rather than following one path at a time through recursive calls,
+ * a large pool of paths is kept in structure-of-arrays form and
+ * advanced one stage at a time: generate camera rays, intersect,
+ * handle misses, shade each material type, then compact the pool.
+ * Each stage is a tight loop over contiguous arrays, so the work in
+ * a stage is of one kind and can be vectorised.
+ *
+ * Secondary rays can optionally be reordered before they are traced,
+ * binned by direction octant then by the Morton code of their
+ * origin, so neighbouring paths in the pool walk the same parts of
+ * the acceleration structure. The gain is small - about a tenth off
+ * the intersect stage of the instances scene, and a few percent of
+ * the whole render once the sort is paid for - and nothing on
+ * scenes which fit in cache, so sorting is off by default
+ */
+
+// Declare ifndef directive for WAVEFRONT_H
+#ifndef WAVEFRONT_H
+
+// Define WAVEFRONT_H
+#define WAVEFRONT_H
+
+// Header files
+#include "common.h"
+#include "aov.h"
+#include "camera.h"
+#include "hittable.h"
+#include "light.h"
+#include "material.h"
+#include "materialTable.h"
+#include "sampler.h"
+#include "sky.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// Namespace
+using namespace std;
+
+/* ==================================================================
+ * WAVEFRONT INTEGRATOR CLASS
+ *
+ * Class for the wavefront integrator. Contains the path pool, the
+ * work queues, and a function for each stage
+ * ==================================================================
+ */
+class wavefrontIntegrator
+{
+	// Public functions
+	public:
+		/*
+		 * WAVEFRONT INTEGRATOR CONSTRUCTOR
+		 *
+		 * When invoked, creates an integrator with room for
+		 * poolSize paths in flight. If sortRays is set, secondary
+		 * rays are reordered for coherence before each wave
+		 */
+		wavefrontIntegrator(int poolSize, bool sortRays) :
+			_poolSize(poolSize), _sortRays(sortRays), _activeCount(0), _nextSample(0), _totalSamples(0), _waveCount(0)
+		{
+			// Allocate the path state
+			_originX.resize(poolSize); _originY.resize(poolSize); _originZ.resize(poolSize);
+			_directionX.resize(poolSize); _directionY.resize(poolSize); _directionZ.resize(poolSize);
+			_time.resize(poolSize);
+			_throughputR.resize(poolSize); _throughputG.resize(poolSize); _throughputB.resize(poolSize);
+			_pixel.resize(poolSize);
+			_sampleIndex.resize(poolSize);
+			_depth.resize(poolSize);
+			_alive.resize(poolSize);
+			_scatterPdf.resize(poolSize);
+			_scatterNormalX.resize(poolSize); _scatterNormalY.resize(poolSize); _scatterNormalZ.resize(poolSize);
+
+			// Allocate the hit state
+			_pointX.resize(poolSize); _pointY.resize(poolSize); _pointZ.resize(poolSize);
+			_normalX.resize(poolSize); _normalY.resize(poolSize); _normalZ.resize(poolSize);
+			_frontFace.resize(poolSize);
+			_material.resize(poolSize);
+			_materialIndex.resize(poolSize);
+			_lightIndex.resize(poolSize);
+
+			// Allocate the sort keys and scratch space
+			_sortKeys.resize(poolSize); _sortKeysScratch.resize(poolSize);
+			_sortOrder.resize(poolSize); _sortOrderScratch.resize(poolSize);
+			_scratchFloat.resize(poolSize); _scratchInt.resize(poolSize);
+
+			// Reserve the queues
+			_missQueue.reserve(poolSize);
+			for (int type = 0; type < MATERIAL_TYPE_COUNT; type++)
+			{
+				// Reserve the material queue
+				_materialQueue[type].reserve(poolSize);
+			}
+		}
+
+		/*
+		 * RENDER FUNCTION
+		 *
+		 * Function renders the image, adding the colour of every
+		 * sample to the frame buffer. The frame buffer is ordered
+		 * from the top row of the image down. Materials are shaded
+		 * through the material table if one is given, or through
+		 * the virtual scatter function if not. Each path resumes its
+		 * pixel sample in the sampler whenever it is shaded. First
+		 * hits are added to the AOV buffers, if any are given
+		 */
+		void render(const camera& cam, const hittable& world, const materialTable* materials, const sceneLights& lights, sampler& samp, int imageWidth, int imageHeight, int samplesPerPixel, int maxDepth, vector<colour>& frameBuffer, aovBuffers* aovs = nullptr)
+		{
+			// Set the image properties
+			_imageWidth = imageWidth;
+			_imageHeight = imageHeight;
+			_maxDepth = maxDepth;
+			_materials = materials;
+			_lights = &lights;
+			_sampler = &samp;
+			_aovs = aovs;
+
+			// Reset the sample counters
+			_activeCount = 0;
+			_nextSample = 0;
+			_totalSamples = static_cast<long long>(imageWidth) * imageHeight * samplesPerPixel;
+			_waveCount = 0;
+
+			// Reset the stage timers
+			_intersectTime = 0.0;
+			_sortTime = 0.0;
+
+			// Run waves until every sample has been generated and every path has finished
+			while (_nextSample < _totalSamples || _activeCount > 0)
+			{
+				// Display progress to the console window
+				if (_waveCount % 16 == 0)
+				{
+					cout << "\rSamples remaining: " << (_totalSamples - _nextSample) << "      " << flush;
+				}
+
+				// Check if secondary rays are reordered
+				if (_sortRays)
+				{
+					// Sort the surviving paths, before camera rays are added
+					auto sortStart = chrono::steady_clock::now();
+					sortStage();
+					_sortTime += chrono::duration<double>(chrono::steady_clock::now() - sortStart).count();
+				}
+
+				// Run each stage in turn
+				generateStage(cam);
+				auto intersectStart = chrono::steady_clock::now();
+				intersectStage(world);
+				_intersectTime += chrono::duration<double>(chrono::steady_clock::now() - intersectStart).count();
+				missStage(frameBuffer);
+				for (int type = 0; type < MATERIAL_TYPE_COUNT; type++)
+				{
+					// Shade the paths which hit this material type
+					shadeStage(static_cast<materialType>(type), world, frameBuffer);
+				}
+				compactStage();
+
+				// Increment the wave count
+				_waveCount++;
+			}
+
+			// Output statistics
+			cout << "\rWavefront: " << _waveCount << " waves, pool of " << _poolSize << " paths" << endl
+				<< "  Intersect stage: " << _intersectTime << " s" << endl;
+
+			// Check if secondary rays were reordered
+			if (_sortRays)
+			{
+				// Output the cost of sorting
+				cout << "  Ray sort stage:  " << _sortTime << " s" << endl;
+			}
+		}
+
+	// Private
+	private:
+		// Maximum number of paths in flight
+		int _poolSize;
+
+		// Reorder secondary rays before tracing them
+		bool _sortRays;
+
+		// Number of paths in flight, packed at the front of the pool
+		int _activeCount;
+
+		// Next sample to generate, and total number of samples
+		long long _nextSample;
+		long long _totalSamples;
+
+		// Number of waves run
+		long long _waveCount;
+
+		// Time spent in the intersect and sort stages, in seconds
+		double _intersectTime;
+		double _sortTime;
+
+		// Image properties
+		int _imageWidth;
+		int _imageHeight;
+		int _maxDepth;
+
+		// Material table, or null to use virtual scatter calls
+		const materialTable* _materials;
+
+		// Lights of the scene
+		const sceneLights* _lights;
+
+		// Sampler for the camera rays and bounces
+		sampler* _sampler;
+
+		// AOV buffers filled from the camera rays' hits, or null
+		aovBuffers* _aovs;
+
+		// Path state - current ray and its time, throughput, pixel, sample index, and depth
+		vector<float> _originX, _originY, _originZ;
+		vector<float> _directionX, _directionY, _directionZ;
+		vector<float> _time;
+		vector<float> _throughputR, _throughputG, _throughputB;
+		vector<int> _pixel;
+		vector<int> _sampleIndex;
+		vector<int> _depth;
+		vector<char> _alive;
+
+		// Pdf of the scatter which produced the path's ray - 0 for camera rays and specular scatters - and the normal it left
+		vector<float> _scatterPdf;
+		vector<float> _scatterNormalX, _scatterNormalY, _scatterNormalZ;
+
+		// Hit state - filled by the intersect stage
+		vector<float> _pointX, _pointY, _pointZ;
+		vector<float> _normalX, _normalY, _normalZ;
+		vector<char> _frontFace;
+		vector<const material*> _material;
+		vector<int> _materialIndex;
+		vector<int> _lightIndex;
+
+		// Sort keys and order, with scratch space for the radix sort and reordering
+		vector<uint32_t> _sortKeys, _sortKeysScratch;
+		vector<int> _sortOrder, _sortOrderScratch;
+		vector<float> _scratchFloat;
+		vector<int> _scratchInt;
+
+		// Work queues, holding path indices
+		vector<int> _missQueue;
+		vector<int> _materialQueue[MATERIAL_TYPE_COUNT];
+
+		/*
+		 * GET RAY FUNCTION
+		 *
+		 * Function returns the current ray of a path
+		 */
+		ray getRay(int i) const
+		{
+			// Rebuild the ray from the arrays
+			return ray(point3(_originX[i], _originY[i], _originZ[i]), vec3(_directionX[i], _directionY[i], _directionZ[i]), _time[i]);
+		}
+
+		/*
+		 * SET RAY FUNCTION
+		 *
+		 * Function stores the current ray of a path
+		 */
+		void setRay(int i, const ray& r)
+		{
+			// Obtain the origin and direction
+			point3 origin = r.getOrigin();
+			vec3 direction = r.getDirection();
+
+			// Store in the arrays
+			_originX[i] = origin.getX(); _originY[i] = origin.getY(); _originZ[i] = origin.getZ();
+			_directionX[i] = direction.getX(); _directionY[i] = direction.getY(); _directionZ[i] = direction.getZ();
+			_time[i] = r.getTime();
+		}
+
+		/*
+		 * GENERATE STAGE FUNCTION
+		 *
+		 * Function fills the free end of the pool with new camera
+		 * rays, one per remaining sample
+		 */
+		void generateStage(const camera& cam)
+		{
+			// Number of pixels in the image
+			const long long pixelCount = static_cast<long long>(_imageWidth) * _imageHeight;
+
+			// Fill free slots until the pool is full or the samples run out
+			while (_activeCount < _poolSize && _nextSample < _totalSamples)
+			{
+				// Determine the pixel of the sample - every pixel gets its first sample before any gets a second
+				int pixel = static_cast<int>(_nextSample % pixelCount);
+				int sampleIndex = static_cast<int>(_nextSample / pixelCount);
+				int i = pixel % _imageWidth;
+				int j = _imageHeight - 1 - pixel / _imageWidth;
+
+				// Start the pixel sample, and obtain the pixel offset and lens position
+				_sampler->startPixelSample(i, j, sampleIndex);
+				sample2D pixelSample = _sampler->get2D();
+				sample2D lensSample = _sampler->get2D();
+
+				// Determine u and v coordinates of pixel
+				auto u = (i + pixelSample.x) / (_imageWidth - 1);
+				auto v = (j + pixelSample.y) / (_imageHeight - 1);
+
+				// Start the path with the camera ray
+				int slot = _activeCount;
+				setRay(slot, cam.getRay(u, v, lensSample, cam.sampleTime(*_sampler)));
+				_throughputR[slot] = 1.0f; _throughputG[slot] = 1.0f; _throughputB[slot] = 1.0f;
+				_pixel[slot] = pixel;
+				_sampleIndex[slot] = sampleIndex;
+				_depth[slot] = 0;
+				_alive[slot] = 1;
+				_scatterPdf[slot] = 0.0f;
+				_scatterNormalX[slot] = 0.0f; _scatterNormalY[slot] = 0.0f; _scatterNormalZ[slot] = 0.0f;
+
+				// Move to the next slot and sample
+				_activeCount++;
+				_nextSample++;
+			}
+		}
+
+		/*
+		 * INTERSECT STAGE FUNCTION
+		 *
+		 * Function finds the closest hit of every path in flight,
+		 * then places the path in the miss queue or the queue of
+		 * the material it hit. Paths at the depth limit end here
+		 */
+		void intersectStage(const hittable& world)
+		{
+			// Empty the queues
+			_missQueue.clear();
+			for (int type = 0; type < MATERIAL_TYPE_COUNT; type++)
+			{
+				// Empty the material queue
+				_materialQueue[type].clear();
+			}
+
+			// Examine each path in flight
+			for (int i = 0; i < _activeCount; i++)
+			{
+				// Check if the path has reached the bounce limit
+				if (_depth[i] >= _maxDepth)
+				{
+					// No camera ray is traced at a depth of 0, so it counts as a miss in the AOVs
+					if (_depth[i] == 0 && _aovs != nullptr)
+					{
+						_aovs->addMiss(_pixel[i]);
+					}
+
+					// No more light gathered, end the path
+					_alive[i] = 0;
+					continue;
+				}
+
+				// Hit record
+				hitRecord rec;
+
+				// Check if an object in the world has been hit (0.001 as tMin to fix shadow acne)
+				if (world.hit(getRay(i), 0.001, infinity, rec))
+				{
+					// Store the hit
+					_pointX[i] = rec.p.getX(); _pointY[i] = rec.p.getY(); _pointZ[i] = rec.p.getZ();
+					_normalX[i] = rec.normal.getX(); _normalY[i] = rec.normal.getY(); _normalZ[i] = rec.normal.getZ();
+					_frontFace[i] = rec.frontFace ? 1 : 0;
+					_material[i] = rec.materialPointer.get();
+					_materialIndex[i] = rec.materialIndex;
+					_lightIndex[i] = rec.lightIndex;
+
+					// Queue the path for its material type
+					materialType type = _materials != nullptr ? (*_materials)[rec.materialIndex].type : _material[i]->getType();
+					_materialQueue[type].push_back(i);
+
+					// Check if this is the camera ray's hit, and AOVs are being filled
+					if (_depth[i] == 0 && _aovs != nullptr)
+					{
+						// Add the first hit
+						_aovs->addHit(_pixel[i], getRay(i), rec, _materials != nullptr ? materialAlbedo((*_materials)[rec.materialIndex]) : materialAlbedo(*_material[i]));
+					}
+				}
+				else
+				{
+					// Queue the path as a miss
+					_missQueue.push_back(i);
+
+					// Check if the camera ray missed, and AOVs are being filled
+					if (_depth[i] == 0 && _aovs != nullptr)
+					{
+						// Add the miss
+						_aovs->addMiss(_pixel[i]);
+					}
+				}
+			}
+		}
+
+		/*
+		 * MISS STAGE FUNCTION
+		 *
+		 * Function adds the sky colour, weighted by the path
+		 * throughput, to the pixel of every path which escaped
+		 */
+		void missStage(vector<colour>& frameBuffer)
+		{
+			// Examine each path in the miss queue
+			for (int i : _missQueue)
+			{
+				// Determine the sky colour, weighted against sampling the sky
+				colour sky = escapedRadiance(*_lights, getRay(i), _scatterPdf[i]);
+
+				// Add the weighted sky colour to the pixel
+				frameBuffer[_pixel[i]] += colour(_throughputR[i] * sky.getX(), _throughputG[i] * sky.getY(), _throughputB[i] * sky.getZ());
+
+				// End the path
+				_alive[i] = 0;
+			}
+		}
+
+		/*
+		 * SHADE STAGE FUNCTION
+		 *
+		 * Function scatters every path which hit a material of one
+		 * type, so the loop only runs that material's code. Paths
+		 * which hit a light add its weighted emission and end, and
+		 * paths on a non-specular surface add the light sampled
+		 * directly, tracing their shadow ray here
+		 */
+		void shadeStage(materialType type, const hittable& world, vector<colour>& frameBuffer)
+		{
+			// Examine each path in the material queue
+			for (int i : _materialQueue[type])
+			{
+				// Rebuild the hit record
+				hitRecord rec;
+				rec.p = point3(_pointX[i], _pointY[i], _pointZ[i]);
+				rec.normal = vec3(_normalX[i], _normalY[i], _normalZ[i]);
+				rec.frontFace = _frontFace[i] != 0;
+				rec.lightIndex = _lightIndex[i];
+
+				// Weight of light added along the path
+				colour throughput(_throughputR[i], _throughputG[i], _throughputB[i]);
+
+				// Check if a light was hit
+				if (type == EMISSIVE_MATERIAL)
+				{
+					// Add the light's front face emission, weighted against light sampling
+					if (rec.frontFace)
+					{
+						colour emission = _materials != nullptr ? (*_materials)[_materialIndex[i]].emission : _material[i]->getData().emission;
+						frameBuffer[_pixel[i]] += (emissionWeight(*_lights, getRay(i), rec, _scatterPdf[i], vec3(_scatterNormalX[i], _scatterNormalY[i], _scatterNormalZ[i])) * throughput) * emission;
+					}
+
+					// Lights absorb the ray, end the path
+					_alive[i] = 0;
+					continue;
+				}
+
+				// Resume the path's pixel sample
+				int pixel = _pixel[i];
+				_sampler->startPixelSample(pixel % _imageWidth, _imageHeight - 1 - pixel / _imageWidth, _sampleIndex[i], bounceDimension(_depth[i]));
+
+				// Add the light arriving directly from the lights
+				ray rayIn = getRay(i);
+				frameBuffer[_pixel[i]] += throughput * (_materials != nullptr ? sampleDirectLight(world, *_lights, rayIn, rec, (*_materials)[_materialIndex[i]], *_sampler, _depth[i])
+					: sampleDirectLight(world, *_lights, rayIn, rec, *_material[i], *_sampler, _depth[i]));
+
+				// Return to this bounce's material dimensions
+				_sampler->setDimension(bounceDimension(_depth[i]));
+
+				// Empty scattered ray and attenuation colour
+				ray scattered;
+				colour attenuation;
+
+				// Check if a scattered ray is created upon collision - every path in the queue takes the same switch case
+				bool isScattered = _materials != nullptr ? scatterMaterial((*_materials)[_materialIndex[i]], rayIn, rec, attenuation, scattered, *_sampler)
+					: _material[i]->scatter(rayIn, rec, attenuation, scattered, *_sampler);
+
+				// Check if the scattered ray was created
+				if (isScattered)
+				{
+					// Record the pdf and normal of the scatter, and continue the path along the scattered ray
+					_scatterPdf[i] = _materials != nullptr ? materialPdf((*_materials)[_materialIndex[i]], rayIn, rec, scattered.getDirection())
+						: _material[i]->pdf(rayIn, rec, scattered.getDirection());
+					_scatterNormalX[i] = rec.normal.getX(); _scatterNormalY[i] = rec.normal.getY(); _scatterNormalZ[i] = rec.normal.getZ();
+					setRay(i, scattered);
+					_throughputR[i] *= attenuation.getX();
+					_throughputG[i] *= attenuation.getY();
+					_throughputB[i] *= attenuation.getZ();
+					_depth[i]++;
+				}
+				else
+				{
+					// Ray absorbed, end the path
+					_alive[i] = 0;
+				}
+			}
+		}
+
+		/*
+		 * EXPAND BITS FUNCTION
+		 *
+		 * Function spreads the lower 9 bits of v out so there are
+		 * two zero bits between each, for interleaving into a
+		 * Morton code
+		 */
+		static uint32_t expandBits(uint32_t v)
+		{
+			// Spread the bits in steps
+			v = (v | (v << 16)) & 0x030000FFu;
+			v = (v | (v << 8)) & 0x0300F00Fu;
+			v = (v | (v << 4)) & 0x030C30C3u;
+			v = (v | (v << 2)) & 0x09249249u;
+
+			// Return the spread bits
+			return v;
+		}
+
+		/*
+		 * PERMUTE FUNCTION
+		 *
+		 * Function reorders the first count entries of an array so
+		 * entry k becomes the old entry _sortOrder[k]
+		 */
+		template <typename T>
+		void permute(vector<T>& values, vector<T>& scratch, int count)
+		{
+			// Gather into the scratch space
+			for (int k = 0; k < count; k++)
+			{
+				// Take the entry from its old position
+				scratch[k] = values[_sortOrder[k]];
+			}
+
+			// Copy back
+			copy(scratch.begin(), scratch.begin() + count, values.begin());
+		}
+
+		/*
+		 * SORT STAGE FUNCTION
+		 *
+		 * Function reorders the paths in flight by a key made of
+		 * the octant of their direction (top 3 bits) and the Morton
+		 * code of their origin within the bounds of all the origins
+		 * (lower 27 bits), using a least significant digit radix sort
+		 */
+		void sortStage()
+		{
+			// Number of paths to sort
+			const int count = _activeCount;
+
+			// Check if there is anything to sort
+			if (count < 2)
+			{
+				// Nothing to do
+				return;
+			}
+
+			// Determine the bounds of the origins
+			aabb originBounds;
+			for (int i = 0; i < count; i++)
+			{
+				// Grow by the origin
+				originBounds.grow(point3(_originX[i], _originY[i], _originZ[i]));
+			}
+
+			// Determine the scale from position to a 9-bit grid cell on each axis
+			point3 boundsMin = originBounds.getMin();
+			vec3 extent = originBounds.getMax() - boundsMin;
+			float scaleX = extent.getX() > 0.0f ? 511.0f / extent.getX() : 0.0f;
+			float scaleY = extent.getY() > 0.0f ? 511.0f / extent.getY() : 0.0f;
+			float scaleZ = extent.getZ() > 0.0f ? 511.0f / extent.getZ() : 0.0f;
+
+			// Determine the key of each path
+			for (int i = 0; i < count; i++)
+			{
+				// Determine the direction octant
+				uint32_t octant = (_directionX[i] < 0.0f ? 1u : 0u) | (_directionY[i] < 0.0f ? 2u : 0u) | (_directionZ[i] < 0.0f ? 4u : 0u);
+
+				// Determine the grid cell of the origin
+				uint32_t cellX = static_cast<uint32_t>((_originX[i] - boundsMin.getX()) * scaleX);
+				uint32_t cellY = static_cast<uint32_t>((_originY[i] - boundsMin.getY()) * scaleY);
+				uint32_t cellZ = static_cast<uint32_t>((_originZ[i] - boundsMin.getZ()) * scaleZ);
+
+				// Combine into the key
+				_sortKeys[i] = (octant << 27) | (expandBits(cellX) << 2) | (expandBits(cellY) << 1) | expandBits(cellZ);
+				_sortOrder[i] = i;
+			}
+
+			// Radix sort the 30-bit keys, 10 bits per pass
+			for (int shift = 0; shift < 30; shift += 10)
+			{
+				// Count the keys in each bucket
+				int bucketStart[1024 + 1] = { 0 };
+				for (int i = 0; i < count; i++)
+				{
+					bucketStart[((_sortKeys[i] >> shift) & 1023u) + 1]++;
+				}
+
+				// Turn the counts into start positions
+				for (int b = 0; b < 1024; b++)
+				{
+					bucketStart[b + 1] += bucketStart[b];
+				}
+
+				// Scatter the keys and order into their buckets, keeping the previous order within a bucket
+				for (int i = 0; i < count; i++)
+				{
+					int position = bucketStart[(_sortKeys[i] >> shift) & 1023u]++;
+					_sortKeysScratch[position] = _sortKeys[i];
+					_sortOrderScratch[position] = _sortOrder[i];
+				}
+
+				// Swap the scratch space in
+				_sortKeys.swap(_sortKeysScratch);
+				_sortOrder.swap(_sortOrderScratch);
+			}
+
+			// Reorder the path state
+			permute(_originX, _scratchFloat, count); permute(_originY, _scratchFloat, count); permute(_originZ, _scratchFloat, count);
+			permute(_directionX, _scratchFloat, count); permute(_directionY, _scratchFloat, count); permute(_directionZ, _scratchFloat, count);
+			permute(_time, _scratchFloat, count);
+			permute(_throughputR, _scratchFloat, count); permute(_throughputG, _scratchFloat, count); permute(_throughputB, _scratchFloat, count);
+			permute(_pixel, _scratchInt, count);
+			permute(_sampleIndex, _scratchInt, count);
+			permute(_depth, _scratchInt, count);
+			permute(_scatterPdf, _scratchFloat, count);
+			permute(_scatterNormalX, _scratchFloat, count); permute(_scatterNormalY, _scratchFloat, count); permute(_scatterNormalZ, _scratchFloat, count);
+		}
+
+		/*
+		 * COMPACT STAGE FUNCTION
+		 *
+		 * Function moves the paths still alive to the front of the
+		 * pool, keeping their order, so the next wave loops over a
+		 * dense range and the generate stage refills the end
+		 */
+		void compactStage()
+		{
+			// Next slot to fill
+			int k = 0;
+
+			// Examine each path in flight
+			for (int i = 0; i < _activeCount; i++)
+			{
+				// Check if the path has ended
+				if (_alive[i] == 0)
+				{
+					// Drop the path
+					continue;
+				}
+
+				// Check if the path needs to move
+				if (k != i)
+				{
+					// Move the path state
+					_originX[k] = _originX[i]; _originY[k] = _originY[i]; _originZ[k] = _originZ[i];
+					_directionX[k] = _directionX[i]; _directionY[k] = _directionY[i]; _directionZ[k] = _directionZ[i];
+					_time[k] = _time[i];
+					_throughputR[k] = _throughputR[i]; _throughputG[k] = _throughputG[i]; _throughputB[k] = _throughputB[i];
+					_pixel[k] = _pixel[i];
+					_sampleIndex[k] = _sampleIndex[i];
+					_depth[k] = _depth[i];
+					_alive[k] = 1;
+					_scatterPdf[k] = _scatterPdf[i];
+					_scatterNormalX[k] = _scatterNormalX[i]; _scatterNormalY[k] = _scatterNormalY[i]; _scatterNormalZ[k] = _scatterNormalZ[i];
+				}
+
+				// Move to the next slot
+				k++;
+			}
+
+			// Set the new number of paths in flight
+			_activeCount = k;
+		}
+};
+
+// End ifndef directive for WAVEFRONT_H
+#endif